@@ -47,7 +47,7 @@ extern "C"
 #endif
 
 /* API version for compatibility checking */
-#define UNICONV_API_VERSION 3
+#define UNICONV_API_VERSION 4
 
     /**
      * Data types for plugin input/output
@@ -114,6 +114,10 @@ extern "C"
         UniconvOptionGetter get_core_option;   /* Get core option (quality, width, etc.) */
         UniconvOptionGetter get_plugin_option; /* Get plugin-specific option */
         void *options_ctx;                     /* Context for option getters */
+
+        /* Per-call state from uniconv_plugin_create_context (API v4,
+         * UNICONV_THREADING_CONTEXT only; NULL otherwise) */
+        void *context;
     } UniconvRequest;
 
     /**
@@ -129,6 +133,53 @@ extern "C"
         char *extra_json;     /* Optional JSON string with extra data (allocated by plugin) */
     } UniconvResult;
 
+    /**
+     * Concurrency contract (API v4)
+     * Returned by the optional uniconv_plugin_threading() export.
+     * Plugins that do not export it are treated as SERIAL.
+     */
+    typedef enum
+    {
+        UNICONV_THREADING_SERIAL = 0,      /* One call at a time, across all threads */
+        UNICONV_THREADING_THREAD_SAFE = 1, /* Execute may run on several threads at once */
+        UNICONV_THREADING_CONTEXT = 2      /* Concurrent calls, each with its own context */
+    } UniconvThreading;
+
+    /**
+     * Read-only input buffer (API v4)
+     * Points at a memory-mapped source file or at an intermediate produced by
+     * the previous stage. Valid only for the duration of the execute call.
+     */
+    typedef struct
+    {
+        const void *data; /* File contents (may be NULL when size is 0) */
+        size_t size;      /* Size in bytes */
+    } UniconvInputBuffer;
+
+    /**
+     * Output sink (API v4)
+     * The plugin writes its whole output through write(), in order. The core
+     * either keeps the bytes in memory for the next stage or writes them to
+     * the output path. write() returns 0 on success, non-zero on failure.
+     */
+    typedef struct UniconvOutputSink
+    {
+        int (*write)(struct UniconvOutputSink *sink, const void *data, size_t size);
+        void *ctx; /* Owned by the core */
+    } UniconvOutputSink;
+
+    /**
+     * Request for the buffer entry point (API v4)
+     * base.source and base.output only name the data (their extensions carry
+     * the formats); they may not exist on disk and must not be opened.
+     */
+    typedef struct
+    {
+        UniconvRequest base;
+        UniconvInputBuffer input;
+        UniconvOutputSink *output;
+    } UniconvBufferRequest;
+
     /**
      * Required plugin functions
      * All native plugins must implement these
@@ -156,6 +207,30 @@ extern "C"
      */
     typedef UniconvResult *(*UniconvPluginExecuteFunc)(const UniconvRequest *request);
 
+    /**
+     * Execute on in-memory buffers (optional, API v4)
+     * Used instead of uniconv_plugin_execute for single-file inputs when
+     * exported. The result's output field is ignored: output goes to the sink.
+     * Plugins without it keep working through the path-based entry point.
+     */
+    typedef UniconvResult *(*UniconvPluginExecuteBufferFunc)(const UniconvBufferRequest *request);
+
+    /**
+     * Declare the concurrency contract (optional, API v4)
+     */
+    typedef UniconvThreading (*UniconvPluginThreadingFunc)(void);
+
+    /**
+     * Create / destroy per-call state (required for UNICONV_THREADING_CONTEXT)
+     * The core creates a context for each concurrently running call and passes
+     * it in UniconvRequest.context. A context is only ever used by one call at
+     * a time, but may be reused by later calls on other threads. Contexts are
+     * destroyed before the library is unloaded. create_context returns NULL on
+     * failure.
+     */
+    typedef void *(*UniconvPluginCreateContextFunc)(void);
+    typedef void (*UniconvPluginDestroyContextFunc)(void *context);
+
     /**
      * Free a result structure
      * Called by core after processing the result
@@ -167,6 +242,10 @@ extern "C"
 #define UNICONV_PLUGIN_INFO_FUNC "uniconv_plugin_info"
 #define UNICONV_PLUGIN_EXECUTE_FUNC "uniconv_plugin_execute"
 #define UNICONV_PLUGIN_FREE_RESULT_FUNC "uniconv_plugin_free_result"
+#define UNICONV_PLUGIN_EXECUTE_BUFFER_FUNC "uniconv_plugin_execute_buffer"
+#define UNICONV_PLUGIN_THREADING_FUNC "uniconv_plugin_threading"
+#define UNICONV_PLUGIN_CREATE_CONTEXT_FUNC "uniconv_plugin_create_context"
+#define UNICONV_PLUGIN_DESTROY_CONTEXT_FUNC "uniconv_plugin_destroy_context"
 
 /**
  * Helper macros for plugin implementation
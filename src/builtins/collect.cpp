@@ -1,4 +1,5 @@
 #include "collect.h"
+#include "utils/file_utils.h"
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
@@ -53,7 +54,7 @@ Collect::Result Collect::execute(
         return result;
     }
 
-    // Copy/link each input file into the collect directory with ordered names
+    // Link each input file into the collect directory with ordered names
     // Format: 000_originalname.ext, 001_originalname.ext, ...
     for (size_t i = 0; i < inputs.size(); ++i) {
         const auto& input = inputs[i];
@@ -70,12 +71,11 @@ Collect::Result Collect::execute(
         std::string ordered_name = prefix.str() + "_" + input.filename().string();
         std::filesystem::path dest = collect_dir / ordered_name;
 
-        try {
-            std::filesystem::copy_file(input, dest,
-                std::filesystem::copy_options::overwrite_existing);
-        } catch (const std::filesystem::filesystem_error& e) {
+        // Link rather than copy where possible: collecting thousands of
+        // frames should not double their I/O and disk footprint
+        if (!utils::transfer_file(input, dest)) {
             result.success = false;
-            result.error = "Failed to collect file: " + std::string(e.what());
+            result.error = "Failed to collect file: " + input.string();
             return result;
         }
     }
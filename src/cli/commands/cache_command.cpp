@@ -0,0 +1,82 @@
+#include "cache_command.h"
+#include "core/conversion_cache.h"
+#include "utils/string_utils.h"
+#include <sstream>
+
+namespace uniconv::cli::commands {
+
+CacheCommand::CacheCommand(std::shared_ptr<core::ConfigManager> config_manager,
+                           std::shared_ptr<core::output::IOutput> output)
+    : config_manager_(std::move(config_manager)), output_(std::move(output)) {
+}
+
+int CacheCommand::execute(const ParsedArgs& args) {
+    if (args.subcommand_args.empty()) {
+        return stats(args);
+    }
+
+    const auto& action = args.subcommand_args[0];
+
+    if (action == "stats") {
+        return stats(args);
+    } else if (action == "prune") {
+        return prune(args);
+    } else if (action == "clear") {
+        return clear(args);
+    }
+
+    output_->error("Unknown cache action: " + action);
+    output_->info("Available actions: stats, prune, clear");
+    return 1;
+}
+
+int CacheCommand::stats(const ParsedArgs& /*args*/) {
+    auto cache = core::ConversionCache::from_config(*config_manager_);
+    auto s = cache->stats();
+
+    nlohmann::json j = s.to_json();
+    j["path"] = cache->cache_dir().string();
+
+    std::ostringstream text;
+    text << "Cache: " << cache->cache_dir().string() << "\n"
+         << "Entries: " << s.entries << "\n"
+         << "Size: " << utils::format_size(static_cast<size_t>(s.total_bytes))
+         << " / " << utils::format_size(static_cast<size_t>(s.max_bytes));
+
+    output_->data(j, text.str());
+    return 0;
+}
+
+int CacheCommand::prune(const ParsedArgs& args) {
+    auto cache = core::ConversionCache::from_config(*config_manager_);
+
+    uintmax_t limit = cache->max_bytes();
+    if (args.cache_max_size.has_value()) {
+        auto parsed = utils::parse_size(*args.cache_max_size);
+        if (!parsed) {
+            output_->error("Invalid size: " + *args.cache_max_size);
+            output_->info("Examples: 500MB, 2GB");
+            return 1;
+        }
+        limit = *parsed;
+    }
+
+    auto result = cache->prune(limit);
+
+    output_->data(result.to_json(),
+                  "Removed " + std::to_string(result.removed) + " entries (" +
+                      utils::format_size(static_cast<size_t>(result.freed_bytes)) + ")");
+    return 0;
+}
+
+int CacheCommand::clear(const ParsedArgs& /*args*/) {
+    auto cache = core::ConversionCache::from_config(*config_manager_);
+    auto result = cache->clear();
+
+    output_->data(result.to_json(),
+                  "Removed " + std::to_string(result.removed) + " entries (" +
+                      utils::format_size(static_cast<size_t>(result.freed_bytes)) + ")");
+    return 0;
+}
+
+} // namespace uniconv::cli::commands
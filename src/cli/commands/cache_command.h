@@ -0,0 +1,33 @@
+#pragma once
+
+#include "cli/parser.h"
+#include "core/config_manager.h"
+#include "core/output/output.h"
+#include <memory>
+
+namespace uniconv::cli::commands {
+
+// Conversion cache command handler
+class CacheCommand {
+public:
+    CacheCommand(std::shared_ptr<core::ConfigManager> config_manager,
+                 std::shared_ptr<core::output::IOutput> output);
+
+    // Execute cache subcommand
+    int execute(const ParsedArgs& args);
+
+    // Show entry count and size
+    int stats(const ParsedArgs& args);
+
+    // Evict least recently used entries down to a size limit
+    int prune(const ParsedArgs& args);
+
+    // Remove all entries
+    int clear(const ParsedArgs& args);
+
+private:
+    std::shared_ptr<core::ConfigManager> config_manager_;
+    std::shared_ptr<core::output::IOutput> output_;
+};
+
+} // namespace uniconv::cli::commands
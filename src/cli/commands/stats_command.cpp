@@ -0,0 +1,103 @@
+#include "stats_command.h"
+#include "core/perf_stats.h"
+#include "utils/string_utils.h"
+#include <iomanip>
+#include <sstream>
+
+namespace uniconv::cli::commands {
+
+StatsCommand::StatsCommand(std::shared_ptr<core::ConfigManager> config_manager,
+                           std::shared_ptr<core::output::IOutput> output)
+    : config_manager_(std::move(config_manager)), output_(std::move(output)) {
+}
+
+int StatsCommand::execute(const ParsedArgs& args) {
+    if (args.subcommand_args.empty()) {
+        return show(args);
+    }
+
+    const auto& action = args.subcommand_args[0];
+
+    if (action == "clear") {
+        return clear(args);
+    }
+
+    output_->error("Unknown stats action: " + action);
+    output_->info("Available actions: clear");
+    return 1;
+}
+
+int StatsCommand::show(const ParsedArgs& /*args*/) {
+    auto stats = core::PerfStats::from_config(*config_manager_);
+    if (!stats) {
+        output_->info("Performance stats are disabled (stats.enabled = false)");
+        return 0;
+    }
+    if (!stats->load()) {
+        output_->error("Cannot read " + stats->path().string());
+        return 1;
+    }
+
+    auto summaries = stats->summaries();
+    nlohmann::json j;
+    j["path"] = stats->path().string();
+    j["series"] = nlohmann::json::array();
+    for (const auto& s : summaries) {
+        j["series"].push_back(s.to_json());
+    }
+
+    if (summaries.empty()) {
+        output_->data(j, "No performance history yet: " + stats->path().string());
+        return 0;
+    }
+
+    auto seconds = [](int64_t ms) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(2) << static_cast<double>(ms) / 1000.0 << "s";
+        return s.str();
+    };
+
+    std::ostringstream text;
+    text << std::left << std::setw(24) << "PLUGIN" << std::setw(10) << "TARGET"
+         << std::setw(10) << "FROM" << std::setw(10) << "INPUT~" << std::setw(6) << "N"
+         << std::setw(9) << "P50" << std::setw(9) << "P90" << std::setw(9) << "P99"
+         << std::setw(8) << "RATIO" << "PEAK RSS\n";
+    for (const auto& s : summaries) {
+        // A bucket holds inputs from 2^b up to 2^(b+1) bytes
+        auto bucket_size = static_cast<size_t>(uintmax_t{1} << std::min(s.key.size_bucket, 62));
+        std::ostringstream ratio;
+        ratio << std::fixed << std::setprecision(2) << s.size_ratio;
+
+        text << std::setw(24) << (s.key.plugin + "@" + s.key.version)
+             << std::setw(10) << s.key.target
+             << std::setw(10) << (s.key.input_format.empty() ? "-" : s.key.input_format)
+             << std::setw(10) << utils::format_size(bucket_size)
+             << std::setw(6) << s.samples
+             << std::setw(9) << seconds(s.p50_ms)
+             << std::setw(9) << seconds(s.p90_ms)
+             << std::setw(9) << seconds(s.p99_ms)
+             << std::setw(8) << ratio.str()
+             << (s.max_rss_kb > 0 ? utils::format_size(static_cast<size_t>(s.max_rss_kb) * 1024) : "-")
+             << "\n";
+    }
+    text << "History: " << stats->path().string();
+
+    output_->data(j, text.str());
+    return 0;
+}
+
+int StatsCommand::clear(const ParsedArgs& /*args*/) {
+    auto stats = core::PerfStats::from_config(*config_manager_);
+    if (!stats) {
+        output_->info("Performance stats are disabled (stats.enabled = false)");
+        return 0;
+    }
+    if (!stats->clear()) {
+        output_->error("Cannot remove " + stats->path().string());
+        return 1;
+    }
+    output_->success("Performance history cleared");
+    return 0;
+}
+
+} // namespace uniconv::cli::commands
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "cli/parser.h"
+#include "core/config_manager.h"
+#include "core/output/output.h"
+#include <memory>
+
+namespace uniconv::cli::commands {
+
+// Plugin performance history command handler
+class StatsCommand {
+public:
+    StatsCommand(std::shared_ptr<core::ConfigManager> config_manager,
+                 std::shared_ptr<core::output::IOutput> output);
+
+    // Execute stats subcommand
+    int execute(const ParsedArgs& args);
+
+    // Show duration percentiles per plugin, target, format and size bucket
+    int show(const ParsedArgs& args);
+
+    // Remove all recorded timings
+    int clear(const ParsedArgs& args);
+
+private:
+    std::shared_ptr<core::ConfigManager> config_manager_;
+    std::shared_ptr<core::output::IOutput> output_;
+};
+
+} // namespace uniconv::cli::commands
@@ -1,5 +1,6 @@
 #include "parser.h"
 #include "pipeline_parser.h"
+#include "utils/string_utils.h"
 #include <uniconv/version.h>
 #include <sstream>
 
@@ -36,6 +37,11 @@ namespace uniconv::cli
         {
             app.parse(argc, argv);
 
+            if (args.core_options.json_stream)
+            {
+                args.core_options.json_output = true;
+            }
+
             // Determine command
             args.command = determine_command(app, args);
         }
@@ -92,11 +98,46 @@ namespace uniconv::cli
         // Flags
         app.add_flag("-f,--force", args.core_options.force, "Overwrite existing files");
         app.add_flag("--json", args.core_options.json_output, "Output as JSON");
+        app.add_flag("--json-stream", args.core_options.json_stream,
+            "Output NDJSON events as stages run (one line per event)");
         app.add_flag("--verbose", args.core_options.verbose, "Verbose output");
         app.add_flag("--quiet", args.core_options.quiet, "Suppress output");
         app.add_flag("--dry-run", args.core_options.dry_run, "Show what would be done");
         app.add_flag("-r,--recursive", args.core_options.recursive, "Process directories recursively");
         app.add_option("--timeout", args.core_options.timeout_seconds, "Plugin timeout in seconds (0 = no timeout)");
+        app.add_option("-j,--jobs", args.core_options.jobs,
+            "Run independent pipeline branches in parallel (1 = serial, 0 = one per CPU)")
+            ->type_name("N");
+        app.add_option("--scatter-jobs", args.core_options.scatter_jobs,
+            "Convert scattered items in parallel (default: same as --jobs)")
+            ->type_name("N");
+        app.add_flag("--pipelined", args.core_options.pipelined,
+            "Stream each scattered item through later stages without waiting for the others");
+        app.add_flag("--cache", args.core_options.cache,
+            "Reuse outputs of identical earlier conversions (~/.uniconv/cache)");
+        app.add_option_function<std::string>("--temp-budget",
+            [&args](const std::string& value) {
+                auto bytes = utils::parse_size(value);
+                if (!bytes || *bytes == 0) {
+                    throw CLI::ValidationError("--temp-budget", "expected a size like 500MB or 2GB");
+                }
+                args.core_options.temp_budget = *bytes;
+            },
+            "Limit intermediate files on disk; scattered items wait for room (e.g. 2GB)")
+            ->type_name("SIZE");
+        app.add_option("--trace", args.trace_file,
+            "Write a Chrome trace of the run (open in Perfetto or chrome://tracing)")
+            ->type_name("FILE");
+        app.add_flag("--explain", args.explain,
+            "Show each stage's expected time and output size from past runs, then exit");
+        app.add_flag("--why", args.why,
+            "Explain which plugin each stage uses and why");
+        app.add_flag("--batch", args.batch,
+            "Run the pipeline on each file of a directory source (files in parallel with --jobs)");
+        app.add_option("--resolve-policy", args.resolve_policy,
+            "Choose among compatible plugins: ordered, or auto-fastest (from past runs)")
+            ->check(CLI::IsMember({"ordered", "auto-fastest"}))
+            ->type_name("POLICY");
 
         // Interactive mode
         app.add_flag("--interactive", args.interactive, "Force interactive mode");
@@ -296,14 +337,70 @@ namespace uniconv::cli
         watch_cmd->fallthrough();
         watch_cmd->add_option("directory", args.watch_dir, "Directory to watch")->required()->type_name("DIR");
         watch_cmd->add_option("pipeline", args.pipeline, "Pipeline transformation stages")->required()->type_name("PIPELINE");
+        watch_cmd->add_option("--workers", args.watch_workers,
+            "Files converted concurrently (0 = one per CPU)");
+        watch_cmd->add_option("--queue-size", args.watch_queue_size,
+            "Pending files before detection waits for a free slot");
+        watch_cmd->add_flag("--no-journal", args.watch_no_journal,
+            "Do not record converted files or catch up on changes made while not watching");
         watch_cmd->footer("\nExamples:\n"
                           "  uniconv watch ./incoming \"jpg\"              # Watch and convert to JPG\n"
                           "  uniconv watch ./incoming \"jpg | png\"        # Multi-stage pipeline\n"
                           "  uniconv watch -o ./output ./incoming \"jpg\"  # With output directory\n"
-                          "  uniconv watch -r ./incoming \"jpg\"           # Watch recursively");
+                          "  uniconv watch -r ./incoming \"jpg\"           # Watch recursively\n"
+                          "  uniconv watch --workers 4 ./incoming \"jpg\"  # Convert 4 files at a time");
         watch_cmd->callback([&args]()
                             { args.command = Command::Watch; });
 
+        // Cache command
+        auto *cache_cmd = app.add_subcommand("cache", "Manage the conversion cache");
+        cache_cmd->fallthrough();
+        cache_cmd->require_subcommand(1);
+        cache_cmd->footer("\nExamples:\n"
+                          "  uniconv cache stats                  # Show cache size\n"
+                          "  uniconv cache prune --max-size 500MB # Evict least recently used entries\n"
+                          "  uniconv cache clear                  # Remove all entries");
+
+        auto *cache_stats = cache_cmd->add_subcommand("stats", "Show cache usage");
+        cache_stats->fallthrough();
+        cache_stats->callback([&args]()
+                              {
+        args.command = Command::Cache;
+        args.subcommand_args.insert(args.subcommand_args.begin(), "stats"); });
+
+        auto *cache_prune = cache_cmd->add_subcommand("prune", "Evict least recently used entries");
+        cache_prune->fallthrough();
+        cache_prune->add_option("--max-size", args.cache_max_size,
+                                "Size to shrink the cache to (default: cache.max_size setting)")
+            ->type_name("SIZE");
+        cache_prune->callback([&args]()
+                              {
+        args.command = Command::Cache;
+        args.subcommand_args.insert(args.subcommand_args.begin(), "prune"); });
+
+        auto *cache_clear = cache_cmd->add_subcommand("clear", "Remove all cache entries");
+        cache_clear->fallthrough();
+        cache_clear->callback([&args]()
+                              {
+        args.command = Command::Cache;
+        args.subcommand_args.insert(args.subcommand_args.begin(), "clear"); });
+
+        // Stats command
+        auto *stats_cmd = app.add_subcommand("stats", "Show plugin performance history");
+        stats_cmd->fallthrough();
+        stats_cmd->footer("\nExamples:\n"
+                          "  uniconv stats          # Percentiles per plugin, target and input size\n"
+                          "  uniconv stats clear    # Forget all recorded timings");
+        stats_cmd->callback([&args]()
+                            { args.command = Command::Stats; });
+
+        auto *stats_clear = stats_cmd->add_subcommand("clear", "Remove all recorded timings");
+        stats_clear->fallthrough();
+        stats_clear->callback([&args]()
+                              {
+        args.command = Command::Stats;
+        args.subcommand_args.insert(args.subcommand_args.begin(), "clear"); });
+
         // Config command (hidden — not yet implemented)
         auto *config_cmd = app.add_subcommand("config", "Manage configuration");
         config_cmd->fallthrough();
@@ -18,6 +18,8 @@ enum class Command {
     Config,        // uniconv config <subcommand>
     Watch,         // uniconv watch <dir> <pipeline>
     Detect,        // uniconv detect <file>
+    Cache,         // uniconv cache <subcommand>
+    Stats,         // uniconv stats [clear]
     Interactive,   // No command, enter interactive mode
     Help,          // Show help
     Version,       // Show version
@@ -53,8 +55,29 @@ struct ParsedArgs {
     bool plugin_update_check = false;
     std::optional<std::string> preset;
 
+    // Chrome trace-event file to write (--trace)
+    std::optional<std::string> trace_file;
+
+    // Print each stage's expected cost instead of running (--explain)
+    bool explain = false;
+
+    // Explain each stage's plugin choice (--why)
+    bool why = false;
+
+    // Run the pipeline on each file of a directory source (--batch)
+    bool batch = false;
+
+    // How to choose among compatible plugins: "ordered" or "auto-fastest"
+    std::optional<std::string> resolve_policy;
+
     // Watch mode
     std::string watch_dir;
+    size_t watch_workers = 1;       // Files converted concurrently (0 = one per CPU)
+    size_t watch_queue_size = 256;  // Pending files before the watcher waits
+    bool watch_no_journal = false;  // Do not record or catch up on converted files
+
+    // Cache prune size limit (e.g., "500MB")
+    std::optional<std::string> cache_max_size;
 };
 
 class CliParser {
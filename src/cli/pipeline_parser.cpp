@@ -62,6 +62,9 @@ std::optional<PipelineParser::ParseResult> PipelineParser::parse_from_args(
                 core_options.force = true;
             } else if (arg == "--json") {
                 core_options.json_output = true;
+            } else if (arg == "--json-stream") {
+                core_options.json_output = true;
+                core_options.json_stream = true;
             } else if (arg == "--quiet") {
                 core_options.quiet = true;
             } else if (arg == "--verbose") {
@@ -0,0 +1,194 @@
+#include "batch_runner.h"
+#include "pipeline_executor.h"
+#include "thread_pool.h"
+#include "utils/file_utils.h"
+#include "utils/string_utils.h"
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace uniconv::core
+{
+
+    BatchRunner::BatchRunner(std::shared_ptr<Engine> engine, const ScratchPolicy &scratch)
+        : engine_(std::move(engine)), scratch_(scratch)
+    {
+    }
+
+    std::optional<std::string> BatchRunner::check(const Pipeline &prototype)
+    {
+        if (!prototype.stages.empty() && prototype.stages.front().has_collect())
+        {
+            return "'collect' as the first stage needs the whole directory; run it without --batch";
+        }
+        return std::nullopt;
+    }
+
+    PipelineBatchResult BatchRunner::run(const std::filesystem::path &dir,
+                                         const Pipeline &prototype,
+                                         size_t workers,
+                                         const FileCallback &on_file)
+    {
+        auto start = std::chrono::steady_clock::now();
+        PipelineBatchResult batch;
+
+        const size_t worker_count = ThreadPool::resolve_worker_count(workers);
+        auto scheduler = scheduler_ ? scheduler_
+                                    : std::make_shared<ResourceScheduler>(
+                                          ResourceBudget::defaults(), static_cast<unsigned>(worker_count));
+
+        // Resolve and check the pipeline once; files only bind their source.
+        // Files are the unit of parallelism, so each graph runs serially.
+        Pipeline per_file = prototype;
+        per_file.core_options.jobs = 1;
+        if (per_file.core_options.scatter_jobs < 0)
+        {
+            per_file.core_options.scatter_jobs = 1;
+        }
+        auto prepared = PipelineExecutor(engine_, scratch_).prepare(per_file);
+        if (!prepared.success)
+        {
+            batch.error = prepared.error;
+            return batch;
+        }
+
+        std::error_code ec;
+        const auto output_root = prototype.core_options.output.value_or(std::filesystem::current_path());
+        const auto output_root_canonical = std::filesystem::weakly_canonical(output_root, ec);
+        const auto wanted_format = prototype.input_format ? utils::to_lower(*prototype.input_format) : "";
+
+        // The shared walk; outputs written inside dir must not be picked up.
+        // Workers register each output before it is moved into place, so
+        // another worker's walk can never see it unregistered.
+        std::mutex walk_mutex;
+        std::filesystem::recursive_directory_iterator walk(
+            dir, std::filesystem::directory_options::skip_permission_denied, ec);
+        const std::filesystem::recursive_directory_iterator walk_end;
+        std::set<std::filesystem::path> produced; // Absolute, normalized
+        auto produced_key = [](const std::filesystem::path &path)
+        {
+            std::error_code abs_ec;
+            auto absolute = std::filesystem::absolute(path, abs_ec);
+            return (abs_ec ? path : absolute).lexically_normal();
+        };
+        auto reserve_output = [&](const std::filesystem::path &path)
+        {
+            auto key = produced_key(path);
+            std::lock_guard<std::mutex> lock(walk_mutex);
+            produced.insert(std::move(key));
+        };
+
+        auto next_file = [&]() -> std::optional<std::filesystem::path>
+        {
+            std::lock_guard<std::mutex> lock(walk_mutex);
+            std::error_code walk_ec;
+            while (walk != walk_end)
+            {
+                const auto entry = *walk;
+                auto name = entry.path().filename().string();
+                bool hidden = !name.empty() && name[0] == '.';
+
+                bool take = false;
+                if (entry.is_directory(walk_ec))
+                {
+                    if (!prototype.core_options.recursive || hidden ||
+                        std::filesystem::weakly_canonical(entry.path(), walk_ec) == output_root_canonical)
+                    {
+                        walk.disable_recursion_pending();
+                    }
+                }
+                else if (!hidden && entry.is_regular_file(walk_ec) && !produced.count(produced_key(entry.path())))
+                {
+                    take = wanted_format.empty() ||
+                           utils::to_lower(utils::detect_format(entry.path())) == wanted_format;
+                }
+
+                walk.increment(walk_ec);
+                if (walk_ec)
+                {
+                    walk = walk_end;
+                }
+                if (take)
+                {
+                    return entry.path();
+                }
+            }
+            return std::nullopt;
+        };
+
+        std::mutex result_mutex;
+        auto run_file = [&](PipelineExecutor &executor, const std::filesystem::path &file)
+        {
+            auto file_start = std::chrono::steady_clock::now();
+
+            std::error_code dir_ec;
+            auto output_dir = output_root / file.lexically_relative(dir).parent_path();
+            std::filesystem::create_directories(output_dir, dir_ec);
+
+            BatchFileResult file_result;
+            file_result.source = file;
+            try
+            {
+                auto result = executor.execute(*prepared.prepared, file, nullptr, output_dir / "");
+                file_result.success = result.success;
+                file_result.outputs = std::move(result.final_outputs);
+                file_result.error = std::move(result.error);
+            }
+            catch (const std::exception &e)
+            {
+                file_result.error = e.what();
+            }
+            file_result.duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                          std::chrono::steady_clock::now() - file_start)
+                                          .count();
+
+            // Sinks place their own outputs; register whatever they reported
+            for (const auto &out : file_result.outputs)
+            {
+                reserve_output(out);
+            }
+
+            std::lock_guard<std::mutex> lock(result_mutex);
+            if (file_result.success)
+            {
+                ++batch.succeeded;
+            }
+            else
+            {
+                ++batch.failed;
+            }
+            batch.output_count += file_result.outputs.size();
+            batch.files.push_back(std::move(file_result));
+            if (on_file)
+            {
+                on_file(batch.files.back(), batch.files.size());
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i)
+        {
+            threads.emplace_back([&]()
+                                 {
+                PipelineExecutor executor(engine_, scratch_);
+                executor.set_scheduler(scheduler);
+                executor.set_output_reserver(reserve_output);
+                while (auto file = next_file())
+                {
+                    run_file(executor, *file);
+                } });
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+
+        batch.total_duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      std::chrono::steady_clock::now() - start)
+                                      .count();
+        return batch;
+    }
+
+} // namespace uniconv::core
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "pipeline.h"
+#include "engine.h"
+#include "resource_scheduler.h"
+#include "scratch_policy.h"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uniconv::core
+{
+
+    // Outcome of running the pipeline on one file of a batch
+    struct BatchFileResult
+    {
+        std::filesystem::path source;
+        bool success = false;
+        std::vector<std::filesystem::path> outputs;
+        int64_t duration_ms = 0;
+        std::optional<std::string> error;
+
+        nlohmann::json to_json() const
+        {
+            nlohmann::json j;
+            j["source"] = source.string();
+            j["success"] = success;
+            j["duration_ms"] = duration_ms;
+            j["outputs"] = nlohmann::json::array();
+            for (const auto &out : outputs)
+            {
+                j["outputs"].push_back(out.string());
+            }
+            if (error)
+            {
+                j["error"] = *error;
+            }
+            return j;
+        }
+    };
+
+    // Aggregate of a batch run (--batch)
+    struct PipelineBatchResult
+    {
+        std::vector<BatchFileResult> files; // In completion order
+        size_t succeeded = 0;
+        size_t failed = 0;
+        size_t output_count = 0;
+        int64_t total_duration_ms = 0;
+        std::optional<std::string> error; // The pipeline could not be prepared; nothing ran
+
+        bool success() const { return !error && failed == 0; }
+
+        nlohmann::json to_json() const
+        {
+            nlohmann::json j;
+            j["success"] = success();
+            if (error)
+            {
+                j["error"] = *error;
+            }
+            j["total"] = files.size();
+            j["succeeded"] = succeeded;
+            j["failed"] = failed;
+            j["output_count"] = output_count;
+            j["total_duration_ms"] = total_duration_ms;
+            j["files"] = nlohmann::json::array();
+            for (const auto &file : files)
+            {
+                j["files"].push_back(file.to_json());
+            }
+            return j;
+        }
+    };
+
+    // Runs one parsed pipeline on every file of a directory. The directory
+    // is walked lazily while workers convert: each worker takes the next
+    // file from the shared walk when it becomes free, so neither a listing
+    // of all files nor a per-file queue is built up front, and slow files
+    // never hold up the others. The pipeline is prepared once (see
+    // PreparedPipeline) and each worker reuses one executor, so a file only
+    // costs a copy of the resolved graph and its own scratch directory.
+    class BatchRunner
+    {
+    public:
+        // Called after each file, from the worker that converted it
+        using FileCallback = std::function<void(const BatchFileResult &result, size_t done)>;
+
+        explicit BatchRunner(std::shared_ptr<Engine> engine,
+                             const ScratchPolicy &scratch = ScratchPolicy::defaults());
+
+        // Admit conversions through a shared scheduler (see PipelineExecutor)
+        void set_scheduler(std::shared_ptr<ResourceScheduler> scheduler) { scheduler_ = std::move(scheduler); }
+
+        // Run prototype on each regular file under dir (recursing with
+        // core_options.recursive; hidden files are skipped). With
+        // input_format set, only files of that format are taken. Outputs
+        // mirror the directory layout under core_options.output, or the
+        // current directory. workers == 0 uses one per CPU; each file's
+        // own graph then runs serially. A pipeline that fails to prepare
+        // sets error before any file is converted.
+        PipelineBatchResult run(const std::filesystem::path &dir,
+                                const Pipeline &prototype,
+                                size_t workers,
+                                const FileCallback &on_file = nullptr);
+
+        // Why prototype cannot run per file, if it cannot
+        static std::optional<std::string> check(const Pipeline &prototype);
+
+    private:
+        std::shared_ptr<Engine> engine_;
+        ScratchPolicy scratch_;
+        std::shared_ptr<ResourceScheduler> scheduler_;
+    };
+
+} // namespace uniconv::core
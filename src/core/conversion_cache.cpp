@@ -0,0 +1,282 @@
+#include "conversion_cache.h"
+#include "config_manager.h"
+#include "utils/file_utils.h"
+#include "utils/hash_utils.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace uniconv::core {
+
+namespace {
+
+// Bump when the key layout changes so old entries are never matched
+constexpr int kKeyVersion = 1;
+
+struct CacheEntry {
+    std::filesystem::path object;
+    uintmax_t size = 0;
+    std::filesystem::file_time_type last_access;
+};
+
+bool is_object_file(const std::filesystem::path& path) {
+    auto name = path.filename().string();
+    return path.extension() != ".json" && name.find(".tmp.") == std::string::npos;
+}
+
+std::vector<CacheEntry> list_entries(const std::filesystem::path& objects_dir) {
+    std::vector<CacheEntry> entries;
+    std::error_code ec;
+    if (!std::filesystem::is_directory(objects_dir, ec)) {
+        return entries;
+    }
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(objects_dir, ec)) {
+        if (!entry.is_regular_file(ec) || !is_object_file(entry.path())) {
+            continue;
+        }
+
+        CacheEntry e;
+        e.object = entry.path();
+        e.size = entry.file_size(ec);
+
+        auto meta = entry.path();
+        meta += ".json";
+        e.last_access = std::filesystem::last_write_time(meta, ec);
+        if (ec) {
+            e.last_access = entry.last_write_time(ec);
+        }
+        entries.push_back(std::move(e));
+    }
+    return entries;
+}
+
+// Unique sibling path for writing before an atomic rename
+std::filesystem::path temp_sibling(const std::filesystem::path& path) {
+    auto tid = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    auto tmp = path;
+    tmp += ".tmp." + std::to_string(tid);
+    return tmp;
+}
+
+} // anonymous namespace
+
+std::filesystem::path ConversionCache::get_default_cache_dir() {
+    auto config_dir = ConfigManager::get_default_config_dir();
+    if (config_dir.empty()) {
+        return std::filesystem::path();
+    }
+    return config_dir / "cache";
+}
+
+ConversionCache::ConversionCache(const std::filesystem::path& cache_dir, uintmax_t max_bytes)
+    : cache_dir_(cache_dir)
+    , max_bytes_(max_bytes) {
+}
+
+std::shared_ptr<ConversionCache> ConversionCache::from_config(const ConfigManager& config) {
+    std::filesystem::path dir = get_default_cache_dir();
+    if (auto configured = config.get("cache.dir")) {
+        dir = *configured;
+    }
+
+    uintmax_t max_bytes = kDefaultMaxBytes;
+    if (auto configured = config.get("cache.max_size")) {
+        if (auto parsed = utils::parse_size(*configured)) {
+            max_bytes = *parsed;
+        }
+    }
+
+    return std::make_shared<ConversionCache>(dir, max_bytes);
+}
+
+std::filesystem::path ConversionCache::object_path(const std::string& key) const {
+    return cache_dir_ / "objects" / key.substr(0, 2) / key;
+}
+
+std::filesystem::path ConversionCache::meta_path(const std::string& key) const {
+    auto path = object_path(key);
+    path += ".json";
+    return path;
+}
+
+std::optional<std::string> ConversionCache::make_key(const Request& request,
+                                                     const PluginInfo& plugin,
+                                                     const std::string& input_format,
+                                                     const std::filesystem::path& output_path) const {
+    auto content_hash = utils::sha256_hex_file(request.source);
+    if (!content_hash) {
+        return std::nullopt;
+    }
+
+    nlohmann::json key;
+    key["v"] = kKeyVersion;
+    key["input"] = *content_hash;
+    key["input_format"] = input_format;
+    key["target"] = request.target;
+    key["plugin"] = plugin.id;
+    key["scope"] = plugin.scope;
+    key["version"] = plugin.version;
+    key["options"] = request.plugin_options;
+    key["output_ext"] = output_path.extension().string();
+
+    return utils::sha256_hex(key.dump());
+}
+
+bool ConversionCache::fetch(const std::string& key, const std::filesystem::path& dest) {
+    auto object = object_path(key);
+    auto meta = meta_path(key);
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(object, ec)) {
+        return false;
+    }
+
+    // Outputs may be hardlinked to the cached object; if one was edited in
+    // place, the object no longer matches what was stored
+    nlohmann::json j;
+    try {
+        std::ifstream file(meta);
+        if (!file) {
+            return false;
+        }
+        file >> j;
+    } catch (const nlohmann::json::exception&) {
+        j = nlohmann::json();
+    }
+
+    auto size = std::filesystem::file_size(object, ec);
+    auto mtime = std::filesystem::last_write_time(object, ec).time_since_epoch().count();
+    if (ec || !j.is_object() || j.value("size", uintmax_t{0}) != size ||
+        j.value("mtime", decltype(mtime){0}) != mtime) {
+        remove_entry(object);
+        return false;
+    }
+
+    if (!utils::link_or_copy_file(object, dest)) {
+        return false;
+    }
+
+    // Record the access for LRU eviction
+    std::filesystem::last_write_time(meta, std::filesystem::file_time_type::clock::now(), ec);
+    return true;
+}
+
+bool ConversionCache::store(const std::string& key, const std::filesystem::path& output) {
+    auto object = object_path(key);
+    auto meta = meta_path(key);
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(output, ec);
+    if (ec || size > max_bytes_) {
+        return false;
+    }
+
+    std::filesystem::create_directories(object.parent_path(), ec);
+    if (ec) {
+        return false;
+    }
+
+    // Write under a temporary name and rename, so concurrent readers never
+    // see a partial object
+    auto tmp_object = temp_sibling(object);
+    if (!utils::link_or_copy_file(output, tmp_object)) {
+        return false;
+    }
+    std::filesystem::rename(tmp_object, object, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_object, ec);
+        return false;
+    }
+
+    nlohmann::json j;
+    j["size"] = size;
+    j["mtime"] = std::filesystem::last_write_time(object, ec).time_since_epoch().count();
+
+    auto tmp_meta = temp_sibling(meta);
+    {
+        std::ofstream file(tmp_meta);
+        if (!file) {
+            remove_entry(object);
+            return false;
+        }
+        file << j.dump();
+    }
+    std::filesystem::rename(tmp_meta, meta, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_meta, ec);
+        remove_entry(object);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!total_bytes_) {
+        total_bytes_ = stats().total_bytes;
+    } else {
+        *total_bytes_ += size;
+    }
+    if (*total_bytes_ > max_bytes_) {
+        prune_locked(max_bytes_);
+    }
+    return true;
+}
+
+CacheStats ConversionCache::stats() const {
+    CacheStats s;
+    s.max_bytes = max_bytes_;
+    for (const auto& entry : list_entries(cache_dir_ / "objects")) {
+        ++s.entries;
+        s.total_bytes += entry.size;
+    }
+    return s;
+}
+
+CachePruneResult ConversionCache::prune(uintmax_t max_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return prune_locked(max_bytes);
+}
+
+CachePruneResult ConversionCache::clear() {
+    return prune(0);
+}
+
+CachePruneResult ConversionCache::prune_locked(uintmax_t max_bytes) {
+    auto entries = list_entries(cache_dir_ / "objects");
+
+    uintmax_t total = 0;
+    for (const auto& entry : entries) {
+        total += entry.size;
+    }
+
+    // Oldest access first
+    std::sort(entries.begin(), entries.end(), [](const CacheEntry& a, const CacheEntry& b) {
+        return a.last_access < b.last_access;
+    });
+
+    CachePruneResult result;
+    for (const auto& entry : entries) {
+        if (total <= max_bytes) {
+            break;
+        }
+        remove_entry(entry.object);
+        total -= entry.size;
+        result.freed_bytes += entry.size;
+        ++result.removed;
+    }
+
+    total_bytes_ = total;
+    return result;
+}
+
+void ConversionCache::remove_entry(const std::filesystem::path& object) {
+    std::error_code ec;
+    auto meta = object;
+    meta += ".json";
+    std::filesystem::remove(object, ec);
+    std::filesystem::remove(meta, ec);
+}
+
+} // namespace uniconv::core
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "types.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <nlohmann/json.hpp>
+
+namespace uniconv::core {
+
+class ConfigManager;
+
+// Cache usage summary
+struct CacheStats {
+    size_t entries = 0;
+    uintmax_t total_bytes = 0;
+    uintmax_t max_bytes = 0;
+
+    nlohmann::json to_json() const {
+        return nlohmann::json{
+            {"entries", entries},
+            {"total_bytes", total_bytes},
+            {"max_bytes", max_bytes}};
+    }
+};
+
+// Result of an eviction pass
+struct CachePruneResult {
+    size_t removed = 0;
+    uintmax_t freed_bytes = 0;
+
+    nlohmann::json to_json() const {
+        return nlohmann::json{{"removed", removed}, {"freed_bytes", freed_bytes}};
+    }
+};
+
+// Content-addressed conversion cache
+// Stored in ~/.uniconv/cache/objects/<xx>/<key> with a <key>.json sidecar.
+// The key hashes the input content together with the target, the resolved
+// plugin and its version, plugin options and the output extension.
+// The sidecar's mtime is the entry's last access time, used for LRU eviction.
+class ConversionCache {
+public:
+    static constexpr uintmax_t kDefaultMaxBytes = 1024ull * 1024 * 1024; // 1 GB
+
+    // Default cache directory (~/.uniconv/cache)
+    static std::filesystem::path get_default_cache_dir();
+
+    explicit ConversionCache(const std::filesystem::path& cache_dir,
+                             uintmax_t max_bytes = kDefaultMaxBytes);
+
+    // Build from settings: cache.dir (default ~/.uniconv/cache) and
+    // cache.max_size (e.g. "2GB", default 1 GB)
+    static std::shared_ptr<ConversionCache> from_config(const ConfigManager& config);
+
+    // Compute the cache key for a request; nullopt if the input cannot be hashed
+    std::optional<std::string> make_key(const Request& request,
+                                        const PluginInfo& plugin,
+                                        const std::string& input_format,
+                                        const std::filesystem::path& output_path) const;
+
+    // On a hit, materialize the cached output at dest and return true
+    bool fetch(const std::string& key, const std::filesystem::path& dest);
+
+    // Add a produced output file under key; evicts old entries if over budget
+    bool store(const std::string& key, const std::filesystem::path& output);
+
+    // Current usage
+    CacheStats stats() const;
+
+    // Evict least recently used entries until the cache fits in max_bytes
+    CachePruneResult prune(uintmax_t max_bytes);
+
+    // Remove every entry
+    CachePruneResult clear();
+
+    const std::filesystem::path& cache_dir() const { return cache_dir_; }
+    uintmax_t max_bytes() const { return max_bytes_; }
+
+private:
+    std::filesystem::path cache_dir_;
+    uintmax_t max_bytes_;
+
+    // Serializes eviction and the running size estimate
+    mutable std::mutex mutex_;
+    std::optional<uintmax_t> total_bytes_;
+
+    std::filesystem::path object_path(const std::string& key) const;
+    std::filesystem::path meta_path(const std::string& key) const;
+
+    // Remove an entry's object and sidecar
+    static void remove_entry(const std::filesystem::path& object);
+
+    CachePruneResult prune_locked(uintmax_t max_bytes);
+};
+
+} // namespace uniconv::core
@@ -1,7 +1,9 @@
 #include "engine.h"
+#include "trace.h"
 #include "utils/file_utils.h"
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <future>
 #include <thread>
 
@@ -24,10 +26,17 @@ namespace uniconv::core
 
     Result Engine::execute(const Request &request)
     {
+        TraceSpan stage_span([&]
+                             { return "stage " + request.target; },
+                             "engine");
+        if (stage_span.active())
+            stage_span.arg("input", request.source.string());
+
         bool is_generator = request.source.empty();
+        bool is_memory_input = request.input_data != nullptr;
 
-        // Check if source exists (skip for generators)
-        if (!is_generator && !std::filesystem::exists(request.source))
+        // Check if source exists (skip for generators and in-memory input)
+        if (!is_generator && !is_memory_input && !std::filesystem::exists(request.source))
         {
             return Result::failure(
                 request.target,
@@ -38,7 +47,8 @@ namespace uniconv::core
         // Get input file info
         std::string input_format;
         size_t input_size = 0;
-        bool is_directory_input = !is_generator && std::filesystem::is_directory(request.source);
+        bool is_directory_input = !is_generator && !is_memory_input &&
+                                  std::filesystem::is_directory(request.source);
         if (is_generator)
         {
             input_format = request.input_format.value_or("");
@@ -50,8 +60,12 @@ namespace uniconv::core
         }
         else
         {
+            TraceSpan span("detect_format", "engine");
             input_format = utils::detect_format(request.source);
-            input_size = std::filesystem::file_size(request.source);
+            input_size = is_memory_input ? request.input_data->size()
+                                         : utils::regular_file_size(request.source);
+            if (span.active())
+                span.arg("format", input_format);
         }
 
         // Build resolution context with full information
@@ -60,9 +74,14 @@ namespace uniconv::core
         ctx.target = request.target;
         ctx.explicit_plugin = request.plugin;
         ctx.input_types = (is_generator || is_directory_input) ? std::vector<DataType>{} : utils::detect_input_types(input_format);
+        ctx.input_size = input_size;
 
         // Find appropriate plugin using the enhanced resolver
-        auto *plugin = plugin_manager_->find_plugin(ctx);
+        plugins::IPlugin *plugin;
+        {
+            TraceSpan span("resolve_plugin", "engine");
+            plugin = plugin_manager_->find_plugin(ctx);
+        }
 
         if (!plugin)
         {
@@ -124,11 +143,55 @@ namespace uniconv::core
             utils::ensure_directory(output_path.parent_path());
         }
 
-        // Build the request with resolved output
+        // The executor only hands in-memory data to buffer-capable plugins;
+        // if resolution picked another plugin, give it a real file
         Request resolved_request = request;
+        if (is_memory_input && !plugin->supports_buffers())
+        {
+            std::ofstream file(request.source, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(request.input_data->data()),
+                       static_cast<std::streamsize>(request.input_data->size()));
+            if (!file)
+            {
+                return Result::failure(request.target, request.source,
+                                       "Cannot write input: " + request.source.string());
+            }
+            resolved_request.input_data.reset();
+            is_memory_input = false;
+        }
+        if (!plugin->supports_buffers())
+        {
+            resolved_request.output_in_memory = false;
+        }
+
+        // Conversion cache: only single-file conversions by deterministic,
+        // non-sink plugins are eligible. Streamed stages (named pipes) are
+        // skipped: hashing would consume the input. So are in-memory stages.
+        std::optional<std::string> cache_key;
+        if (cache_ && request.core_options.cache && !is_generator && !is_directory_input &&
+            !is_memory_input && !resolved_request.output_in_memory &&
+            plugin->info().deterministic && !plugin->info().sink &&
+            std::filesystem::is_regular_file(request.source) &&
+            (!std::filesystem::exists(output_path) || std::filesystem::is_regular_file(output_path)))
+        {
+            cache_key = cache_->make_key(request, plugin->info(), input_format, output_path);
+            if (cache_key && cache_->fetch(*cache_key, output_path))
+            {
+                Result result = Result::success(request.target, plugin->info().scope,
+                                                request.source, output_path, input_size,
+                                                utils::regular_file_size(output_path));
+                result.extra["cached"] = true;
+                return result;
+            }
+        }
+
+        // Build the request with resolved output
         resolved_request.core_options.output = output_path;
 
         // Execute plugin (with optional timeout)
+        if (stage_span.active())
+            stage_span.arg("plugin", plugin->info().scope);
+        int64_t run_start_us = Trace::now_us();
         Result result;
         if (resolved_request.core_options.timeout_seconds > 0)
         {
@@ -156,23 +219,100 @@ namespace uniconv::core
         {
             result = plugin->execute(resolved_request);
         }
+        int64_t run_us = Trace::now_us() - run_start_us;
+        Trace::complete("plugin_execute", "engine", run_start_us, run_us);
 
         result.plugin_used = plugin->info().scope;
         result.input_size = input_size;
 
         // Get output size if successful
-        if (result.status == ResultStatus::Success && result.output)
+        if (result.status == ResultStatus::Success && result.output_data)
+        {
+            result.output_size = result.output_data->size();
+        }
+        else if (result.status == ResultStatus::Success && result.output)
         {
-            if (std::filesystem::exists(*result.output) &&
-                !std::filesystem::is_directory(*result.output))
+            if (std::filesystem::is_regular_file(*result.output))
             {
-                result.output_size = std::filesystem::file_size(*result.output);
+                result.output_size = utils::regular_file_size(*result.output);
             }
         }
 
+        if (cache_key && result.status == ResultStatus::Success && !result.is_scatter() &&
+            result.output && std::filesystem::is_regular_file(*result.output))
+        {
+            cache_->store(*cache_key, *result.output);
+        }
+
+        if (stats_ && result.status == ResultStatus::Success)
+        {
+            record_stats(plugin->info(), result, input_format, run_us / 1000);
+        }
+
         return result;
     }
 
+    void Engine::record_stats(const PluginInfo &info, const Result &result,
+                              const std::string &input_format, int64_t duration_ms)
+    {
+        PerfSample sample;
+        sample.duration_ms = duration_ms;
+        sample.bytes_in = result.input_size;
+        sample.peak_rss_kb = result.peak_rss_kb;
+        if (result.is_scatter())
+        {
+            for (const auto &output : result.outputs)
+            {
+                sample.bytes_out += utils::regular_file_size(output);
+            }
+        }
+        else
+        {
+            sample.bytes_out = result.output_size.value_or(0);
+        }
+
+        PerfKey key{info.scope, info.version, result.target, input_format,
+                    PerfStats::size_bucket(result.input_size)};
+        stats_->record(key, sample);
+    }
+
+    void Engine::set_stats(std::shared_ptr<PerfStats> stats)
+    {
+        stats_ = std::move(stats);
+        plugin_manager_->set_stats(stats_);
+    }
+
+    std::optional<PerfEstimate> Engine::estimate(const std::string &target,
+                                                 const std::string &input_format,
+                                                 const std::optional<std::string> &plugin,
+                                                 uintmax_t input_size,
+                                                 ResolutionResult *resolution)
+    {
+        ResolutionContext ctx;
+        ctx.input_format = input_format;
+        ctx.target = target;
+        ctx.explicit_plugin = plugin;
+        ctx.input_types = input_format == "directory" ? std::vector<DataType>{}
+                                                      : utils::detect_input_types(input_format);
+        ctx.input_size = input_size;
+
+        auto resolved = plugin_manager_->resolve(ctx);
+        if (resolution)
+        {
+            *resolution = resolved;
+        }
+        if (!resolved.plugin)
+        {
+            return std::nullopt;
+        }
+        auto info = resolved.plugin->info();
+        if (!stats_)
+        {
+            return std::nullopt;
+        }
+        return stats_->estimate(info.scope, info.version, target, input_format, input_size);
+    }
+
     BatchResult Engine::execute_batch(
         const std::vector<Request> &requests,
         const ProgressCallback &progress)
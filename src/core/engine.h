@@ -2,6 +2,8 @@
 
 #include "core/types.h"
 #include "core/plugin_manager.h"
+#include "core/conversion_cache.h"
+#include "core/perf_stats.h"
 #include <functional>
 #include <memory>
 #include <vector>
@@ -66,8 +68,31 @@ namespace uniconv::core
         PluginManager &plugin_manager() { return *plugin_manager_; }
         const PluginManager &plugin_manager() const { return *plugin_manager_; }
 
+        // Conversion cache consulted for requests with core_options.cache set
+        void set_cache(std::shared_ptr<ConversionCache> cache) { cache_ = std::move(cache); }
+
+        // Performance history: every executed plugin run is recorded into it,
+        // and the auto-fastest resolution policy ranks plugins by it
+        void set_stats(std::shared_ptr<PerfStats> stats);
+        PerfStats *stats() const { return stats_.get(); }
+
+        // Expected cost of converting input_size bytes of input_format to
+        // target, from the plugin resolution would pick. nullopt without
+        // stats or history. resolution receives how the plugin was chosen.
+        std::optional<PerfEstimate> estimate(const std::string &target,
+                                             const std::string &input_format,
+                                             const std::optional<std::string> &plugin,
+                                             uintmax_t input_size,
+                                             ResolutionResult *resolution = nullptr);
+
     private:
         std::shared_ptr<PluginManager> plugin_manager_;
+        std::shared_ptr<ConversionCache> cache_;
+        std::shared_ptr<PerfStats> stats_;
+
+        // Add a finished plugin run to the performance history
+        void record_stats(const PluginInfo &info, const Result &result,
+                          const std::string &input_format, int64_t duration_ms);
 
         // Resolve output path for a request
         std::filesystem::path resolve_output_path(
@@ -1,4 +1,5 @@
 #include "execution_graph.h"
+#include <algorithm>
 #include <queue>
 
 namespace uniconv::core {
@@ -116,6 +117,35 @@ void ExecutionGraph::build_from_pipeline(const Pipeline& pipeline) {
     }
 }
 
+size_t ExecutionGraph::insert_before(size_t node_id) {
+    size_t id = add_node();
+    auto& hop = nodes_[id];
+    auto& node = nodes_[node_id];
+
+    hop.stage_idx = node.stage_idx;
+    hop.element_idx = node.element_idx;
+    hop.input = node.input;
+    hop.input_nodes = node.input_nodes;
+    for (size_t prev_id : hop.input_nodes) {
+        auto& outputs = nodes_[prev_id].output_nodes;
+        std::replace(outputs.begin(), outputs.end(), node_id, id);
+    }
+    hop.output_nodes = {node_id};
+
+    node.input.clear();
+    node.input_nodes = {id};
+    return id;
+}
+
+void ExecutionGraph::bind_source(const std::filesystem::path& source) {
+    source_ = source;
+    for (auto& node : nodes_) {
+        if (node.input_nodes.empty()) {
+            node.input = source_;
+        }
+    }
+}
+
 size_t ExecutionGraph::add_node() {
     size_t id = nodes_.size();
     nodes_.emplace_back();
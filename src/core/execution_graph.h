@@ -2,6 +2,7 @@
 
 #include "pipeline.h"
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@ struct ExecutionNode {
     std::filesystem::path input;                     // Input path
     std::filesystem::path temp_output;               // Temp output (always temp during execution)
     std::filesystem::path final_output;              // Final output (resolved in finalize phase)
+    std::shared_ptr<const Buffer> output_data;       // In-memory output for the next native stage
 
     std::string plugin_used;                         // Plugin that was used
     ResultStatus status = ResultStatus::Success;
@@ -40,6 +42,8 @@ struct ExecutionNode {
     bool is_clipboard = false;
     bool is_passthrough = false;
     bool is_sink = false;           // Plugin owns output, skip finalization
+    bool routed = false;            // Conversion of a route planned by RoutePlanner (it chose the plugin)
+    bool prepared = false;          // Extension, sink flag and options already resolved
 
     // Scatter/collect state
     std::vector<std::filesystem::path> scatter_outputs;  // Populated at runtime when plugin returns "outputs"
@@ -101,6 +105,14 @@ public:
     // Get execution order (topological sort)
     std::vector<size_t> execution_order() const;
 
+    // Insert a new node between node_id and its inputs; it takes over the
+    // node's input and becomes its only predecessor. Returns the new id.
+    size_t insert_before(size_t node_id);
+
+    // Point the graph at another source: nodes reading the source take it
+    // as their input. Lets a prepared graph be reused for the next file.
+    void bind_source(const std::filesystem::path& source);
+
 private:
     std::vector<ExecutionNode> nodes_;
     std::filesystem::path source_;
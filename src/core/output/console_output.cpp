@@ -73,29 +73,50 @@ void ConsoleOutput::help(std::string_view text) {
     out_ << text;
 }
 
+namespace {
+
+std::string format_seconds(int64_t secs) {
+    if (secs >= 60) {
+        return std::to_string(secs / 60) + "m " + std::to_string(secs % 60) + "s";
+    }
+    return std::to_string(secs) + "s";
+}
+
+} // namespace
+
 void ConsoleOutput::stage_started(size_t current, size_t total, const std::string& target) {
+    stage_started_with_estimate(current, total, target, -1);
+}
+
+void ConsoleOutput::stage_started_with_estimate(size_t current, size_t total, const std::string& target,
+                                                int64_t estimate_ms) {
     if (quiet_) return;
 
     std::string prefix = "[" + std::to_string(current) + "/" + std::to_string(total) + "] Converting to " + target + "...";
 
     if (is_tty_ && spinner_) {
         auto start_time = std::chrono::steady_clock::now();
-        spinner_->start([prefix, start_time]() {
+        spinner_->start([prefix, start_time, estimate_ms]() {
             auto elapsed = std::chrono::steady_clock::now() - start_time;
             auto secs = std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+            if (estimate_ms >= 1000) {
+                // Count down the expected remainder; past it, just show elapsed
+                int64_t left = (estimate_ms + 999) / 1000 - secs;
+                if (left > 0) {
+                    return prefix + " (" + format_seconds(secs) + ", ~" + format_seconds(left) + " left)";
+                }
+            }
             if (secs < 3) {
                 return prefix;
             }
-            std::string suffix;
-            if (secs >= 60) {
-                suffix = " (" + std::to_string(secs / 60) + "m " + std::to_string(secs % 60) + "s)";
-            } else {
-                suffix = " (" + std::to_string(secs) + "s)";
-            }
-            return prefix + suffix;
+            return prefix + " (" + format_seconds(secs) + ")";
         });
     } else {
-        err_ << prefix << "\n" << std::flush;
+        if (estimate_ms >= 1000) {
+            err_ << prefix << " (est. " << format_seconds((estimate_ms + 999) / 1000) << ")\n" << std::flush;
+        } else {
+            err_ << prefix << "\n" << std::flush;
+        }
     }
 }
 
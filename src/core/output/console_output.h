@@ -26,6 +26,8 @@ public:
     void help(std::string_view text) override;
 
     void stage_started(size_t current, size_t total, const std::string& target) override;
+    void stage_started_with_estimate(size_t current, size_t total, const std::string& target,
+                                     int64_t estimate_ms) override;
     void stage_completed(size_t current, size_t total, const std::string& target,
                          int64_t duration_ms, bool success, const std::string& error = "") override;
 
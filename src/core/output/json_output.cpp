@@ -3,15 +3,19 @@
 namespace uniconv::core::output {
 
 JsonOutput::JsonOutput(std::ostream& out, std::ostream& err,
-                       bool verbose, bool quiet)
-    : out_(out), err_(err), verbose_(verbose), quiet_(quiet) {}
+                       bool verbose, bool quiet, bool stream)
+    : out_(out), err_(err), verbose_(verbose), quiet_(quiet), stream_(stream) {}
+
+std::string JsonOutput::format(const nlohmann::json& j) const {
+    return stream_ ? j.dump() : j.dump(2);
+}
 
 void JsonOutput::output_message(std::ostream& os, const std::string& type,
                                 std::string_view msg) {
     nlohmann::json j;
     j["type"] = type;
     j["message"] = msg;
-    os << j.dump(2) << "\n";
+    os << format(j) << "\n";
 }
 
 void JsonOutput::error(std::string_view msg) {
@@ -45,7 +49,7 @@ void JsonOutput::debug(std::string_view msg) {
 void JsonOutput::data(const nlohmann::json& data,
                       const std::string& /*text_format*/) {
     // In JSON mode, ignore text_format and output raw JSON
-    out_ << data.dump(2) << "\n";
+    out_ << format(data) << "\n";
 }
 
 void JsonOutput::help(std::string_view text) {
@@ -57,12 +61,18 @@ void JsonOutput::stage_started(size_t current, size_t total, const std::string&
     if (quiet_) return;
 
     nlohmann::json j;
-    j["type"] = "progress";
+    if (stream_) {
+        j["event"] = "stage_started";
+    } else {
+        j["type"] = "progress";
+    }
     j["current"] = current;
     j["total"] = total;
     j["target"] = target;
-    j["phase"] = "started";
-    err_ << j.dump() << "\n" << std::flush;
+    if (!stream_) {
+        j["phase"] = "started";
+    }
+    (stream_ ? out_ : err_) << j.dump() << "\n" << std::flush;
 }
 
 void JsonOutput::stage_completed(size_t current, size_t total, const std::string& target,
@@ -70,17 +80,40 @@ void JsonOutput::stage_completed(size_t current, size_t total, const std::string
     if (quiet_) return;
 
     nlohmann::json j;
-    j["type"] = "progress";
+    if (stream_) {
+        j["event"] = "stage_completed";
+    } else {
+        j["type"] = "progress";
+    }
     j["current"] = current;
     j["total"] = total;
     j["target"] = target;
-    j["phase"] = "completed";
+    if (!stream_) {
+        j["phase"] = "completed";
+    }
     j["duration_ms"] = duration_ms;
     j["success"] = success;
     if (!success && !error.empty()) {
         j["error"] = error;
     }
-    err_ << j.dump() << "\n" << std::flush;
+    (stream_ ? out_ : err_) << j.dump() << "\n" << std::flush;
+}
+
+bool JsonOutput::streams_results() const {
+    return stream_;
+}
+
+void JsonOutput::stage_result(const nlohmann::json& result) {
+    nlohmann::json j = result;
+    j["event"] = "stage_result";
+    out_ << j.dump() << "\n" << std::flush;
+}
+
+void JsonOutput::output_ready(const std::string& path) {
+    nlohmann::json j;
+    j["event"] = "output";
+    j["path"] = path;
+    out_ << j.dump() << "\n" << std::flush;
 }
 
 bool JsonOutput::is_verbose() const {
@@ -9,8 +9,10 @@ namespace uniconv::core::output {
 
 class JsonOutput : public IOutput {
 public:
+    // stream: NDJSON mode (--json-stream); every record is one line and
+    // progress, stage results and outputs are events on out
     JsonOutput(std::ostream& out, std::ostream& err,
-               bool verbose = false, bool quiet = false);
+               bool verbose = false, bool quiet = false, bool stream = false);
 
     void error(std::string_view msg) override;
     void warning(std::string_view msg) override;
@@ -27,6 +29,10 @@ public:
     void stage_completed(size_t current, size_t total, const std::string& target,
                          int64_t duration_ms, bool success, const std::string& error = "") override;
 
+    bool streams_results() const override;
+    void stage_result(const nlohmann::json& result) override;
+    void output_ready(const std::string& path) override;
+
     bool is_verbose() const override;
     bool is_quiet() const override;
     void flush() override;
@@ -35,10 +41,14 @@ private:
     void output_message(std::ostream& os, const std::string& type,
                         std::string_view msg);
 
+    // One JSON document: indented, or a single NDJSON line when streaming
+    std::string format(const nlohmann::json& j) const;
+
     std::ostream& out_;
     std::ostream& err_;
     bool verbose_;
     bool quiet_;
+    bool stream_;
 };
 
 } // namespace uniconv::core::output
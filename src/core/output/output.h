@@ -32,6 +32,19 @@ public:
     virtual void stage_completed(size_t current, size_t total, const std::string& target,
                                  int64_t duration_ms, bool success, const std::string& error = "") = 0;
 
+    // Stage start with an expected duration from the performance history
+    virtual void stage_started_with_estimate(size_t current, size_t total, const std::string& target,
+                                             int64_t /*estimate_ms*/) {
+        stage_started(current, total, target);
+    }
+
+    // Result streaming (--json-stream). An output that streams results gets
+    // every stage result and final output as it happens; the executor then
+    // keeps only counters in PipelineResult instead of the full lists.
+    virtual bool streams_results() const { return false; }
+    virtual void stage_result(const nlohmann::json& /*result*/) {}
+    virtual void output_ready(const std::string& /*path*/) {}
+
     // State
     virtual bool is_verbose() const = 0;
     virtual bool is_quiet() const = 0;
@@ -0,0 +1,351 @@
+#include "perf_stats.h"
+#include "config_manager.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#define GETPID _getpid
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#define GETPID getpid
+#endif
+
+namespace uniconv::core {
+
+namespace {
+
+constexpr int kFileVersion = 1;
+
+// Exclusive lock on a sibling file, held across read-merge-rename so that
+// concurrent processes merge one after another. Best effort: if the lock
+// file cannot be opened the save goes ahead unlocked.
+class FileLock {
+public:
+    explicit FileLock(const std::filesystem::path& path) {
+#ifdef _WIN32
+        handle_ = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                              OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            OVERLAPPED overlapped{};
+            if (!LockFileEx(handle_, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+                CloseHandle(handle_);
+                handle_ = INVALID_HANDLE_VALUE;
+            }
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ >= 0) {
+            while (::flock(fd_, LOCK_EX) != 0 && errno == EINTR) {
+            }
+        }
+#endif
+    }
+
+    ~FileLock() {
+#ifdef _WIN32
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            OVERLAPPED overlapped{};
+            UnlockFileEx(handle_, 0, MAXDWORD, MAXDWORD, &overlapped);
+            CloseHandle(handle_);
+        }
+#else
+        if (fd_ >= 0) {
+            ::flock(fd_, LOCK_UN);
+            ::close(fd_);
+        }
+#endif
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+#ifdef _WIN32
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+#else
+    int fd_ = -1;
+#endif
+};
+
+template <typename T>
+T percentile(std::vector<T> values, double p) {
+    if (values.empty()) {
+        return T{};
+    }
+    std::sort(values.begin(), values.end());
+    auto index = static_cast<size_t>(std::ceil(p * static_cast<double>(values.size()))) ;
+    return values[std::min(index == 0 ? 0 : index - 1, values.size() - 1)];
+}
+
+} // anonymous namespace
+
+std::string PerfKey::str() const {
+    return plugin + "@" + version + "|" + target + "|" + input_format + "|" + std::to_string(size_bucket);
+}
+
+std::filesystem::path PerfStats::get_default_path() {
+    auto config_dir = ConfigManager::get_default_config_dir();
+    if (config_dir.empty()) {
+        return std::filesystem::path();
+    }
+    return config_dir / "stats.json";
+}
+
+PerfStats::PerfStats(std::filesystem::path path)
+    : path_(std::move(path)) {
+}
+
+std::shared_ptr<PerfStats> PerfStats::from_config(const ConfigManager& config) {
+    if (auto enabled = config.get("stats.enabled"); enabled && *enabled == "false") {
+        return nullptr;
+    }
+    std::filesystem::path path = get_default_path();
+    if (auto configured = config.get("stats.path")) {
+        path = *configured;
+    }
+    if (path.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<PerfStats>(path);
+}
+
+int PerfStats::size_bucket(uintmax_t bytes) {
+    int bucket = 0;
+    while (bytes > 1) {
+        bytes >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+bool PerfStats::read_file(const std::filesystem::path& path, std::map<std::string, Series>& out) {
+    std::ifstream file(path);
+    if (!file) {
+        return !std::filesystem::exists(path);
+    }
+
+    try {
+        auto j = nlohmann::json::parse(file);
+        if (j.value("version", 0) != kFileVersion || !j.contains("series")) {
+            return true; // Unknown layout: start over
+        }
+        for (const auto& entry : j.at("series")) {
+            Series series;
+            series.key.plugin = entry.value("plugin", "");
+            series.key.version = entry.value("version", "");
+            series.key.target = entry.value("target", "");
+            series.key.input_format = entry.value("input_format", "");
+            series.key.size_bucket = entry.value("bucket", 0);
+            // Samples are [duration_ms, bytes_in, bytes_out, peak_rss_kb]
+            for (const auto& s : entry.value("samples", nlohmann::json::array())) {
+                if (!s.is_array() || s.size() < 4) {
+                    continue;
+                }
+                series.samples.push_back({s[0].get<int64_t>(), s[1].get<uintmax_t>(),
+                                          s[2].get<uintmax_t>(), s[3].get<uintmax_t>()});
+            }
+            out[series.key.str()] = std::move(series);
+        }
+        return true;
+    } catch (const nlohmann::json::exception&) {
+        return false;
+    }
+}
+
+bool PerfStats::load() {
+    std::map<std::string, Series> loaded;
+    bool ok = read_file(path_, loaded);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    series_ = std::move(loaded);
+    pending_.clear();
+    return ok;
+}
+
+bool PerfStats::save() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pending_.empty()) {
+        return true;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path_.parent_path(), ec);
+    auto lock_path = path_;
+    lock_path += ".lock";
+    FileLock file_lock(lock_path);
+
+    // Merge into what is on disk now, which may include other runs' samples
+    std::map<std::string, Series> merged;
+    read_file(path_, merged);
+    for (const auto& [key, series] : pending_) {
+        auto [it, inserted] = merged.emplace(key, Series{series.key, {}});
+        for (const auto& sample : series.samples) {
+            append(it->second, sample);
+        }
+    }
+
+    nlohmann::json j;
+    j["version"] = kFileVersion;
+    j["series"] = nlohmann::json::array();
+    for (const auto& [key, series] : merged) {
+        nlohmann::json samples = nlohmann::json::array();
+        for (const auto& s : series.samples) {
+            samples.push_back({s.duration_ms, s.bytes_in, s.bytes_out, s.peak_rss_kb});
+        }
+        j["series"].push_back({{"plugin", series.key.plugin},
+                               {"version", series.key.version},
+                               {"target", series.key.target},
+                               {"input_format", series.key.input_format},
+                               {"bucket", series.key.size_bucket},
+                               {"samples", std::move(samples)}});
+    }
+
+    auto tmp = path_;
+    tmp += ".tmp." + std::to_string(GETPID());
+    {
+        std::ofstream file(tmp, std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file << j.dump() << "\n";
+        if (!file) {
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path_, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+
+    series_ = std::move(merged);
+    pending_.clear();
+    return true;
+}
+
+void PerfStats::append(Series& series, const PerfSample& sample) {
+    series.samples.push_back(sample);
+    if (series.samples.size() > kMaxSamples) {
+        series.samples.erase(series.samples.begin(),
+                             series.samples.begin() +
+                                 static_cast<std::ptrdiff_t>(series.samples.size() - kMaxSamples));
+    }
+}
+
+void PerfStats::record(const PerfKey& key, const PerfSample& sample) {
+    auto name = key.str();
+    std::lock_guard<std::mutex> lock(mutex_);
+    append(series_.emplace(name, Series{key, {}}).first->second, sample);
+    append(pending_.emplace(name, Series{key, {}}).first->second, sample);
+}
+
+PerfSummary PerfStats::summarize(const Series& series) {
+    PerfSummary summary;
+    summary.key = series.key;
+    summary.samples = series.samples.size();
+
+    std::vector<int64_t> durations;
+    std::vector<double> ratios;
+    std::vector<uintmax_t> rss;
+    for (const auto& s : series.samples) {
+        durations.push_back(s.duration_ms);
+        if (s.bytes_in > 0) {
+            ratios.push_back(static_cast<double>(s.bytes_out) / static_cast<double>(s.bytes_in));
+        }
+        if (s.peak_rss_kb > 0) {
+            rss.push_back(s.peak_rss_kb);
+            summary.max_rss_kb = std::max(summary.max_rss_kb, s.peak_rss_kb);
+        }
+    }
+    summary.p50_ms = percentile(durations, 0.50);
+    summary.p90_ms = percentile(durations, 0.90);
+    summary.p99_ms = percentile(durations, 0.99);
+    if (!ratios.empty()) {
+        summary.size_ratio = percentile(ratios, 0.50);
+    }
+    summary.p50_rss_kb = percentile(rss, 0.50);
+    return summary;
+}
+
+std::optional<PerfEstimate> PerfStats::estimate(const std::string& plugin,
+                                                const std::string& version,
+                                                const std::string& target,
+                                                const std::string& input_format,
+                                                uintmax_t bytes_in) const {
+    int bucket = size_bucket(bytes_in);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Series* best = nullptr;
+    int best_distance = 0;
+    for (const auto& [name, series] : series_) {
+        const auto& key = series.key;
+        if (series.samples.empty() || key.plugin != plugin || key.version != version ||
+            key.target != target || key.input_format != input_format) {
+            continue;
+        }
+        int distance = std::abs(key.size_bucket - bucket);
+        if (!best || distance < best_distance) {
+            best = &series;
+            best_distance = distance;
+        }
+    }
+    if (!best) {
+        return std::nullopt;
+    }
+
+    auto summary = summarize(*best);
+    PerfEstimate estimate;
+    estimate.samples = summary.samples;
+    estimate.exact = best_distance == 0;
+    estimate.duration_ms = summary.p50_ms;
+    estimate.peak_rss_kb = summary.p50_rss_kb;
+    estimate.bytes_out = static_cast<uintmax_t>(summary.size_ratio * static_cast<double>(bytes_in));
+
+    if (!estimate.exact) {
+        // Scale the duration linearly with input size
+        std::vector<uintmax_t> sizes;
+        for (const auto& s : best->samples) {
+            sizes.push_back(s.bytes_in);
+        }
+        auto typical = percentile(sizes, 0.50);
+        if (typical > 0) {
+            estimate.duration_ms = static_cast<int64_t>(
+                static_cast<double>(summary.p50_ms) * static_cast<double>(bytes_in) /
+                static_cast<double>(typical));
+        }
+    }
+    return estimate;
+}
+
+std::vector<PerfSummary> PerfStats::summaries() const {
+    std::vector<PerfSummary> result;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [name, series] : series_) {
+            result.push_back(summarize(series));
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const PerfSummary& a, const PerfSummary& b) {
+        return a.samples > b.samples;
+    });
+    return result;
+}
+
+bool PerfStats::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    series_.clear();
+    pending_.clear();
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    return !ec;
+}
+
+} // namespace uniconv::core
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace uniconv::core {
+
+class ConfigManager;
+
+// What a series of measurements is about. Inputs are bucketed by size
+// (powers of two) so a 2 KB thumbnail and a 2 GB video never share timings.
+struct PerfKey {
+    std::string plugin;
+    std::string version;
+    std::string target;
+    std::string input_format;
+    int size_bucket = 0;
+
+    std::string str() const;
+};
+
+// One plugin execution
+struct PerfSample {
+    int64_t duration_ms = 0;
+    uintmax_t bytes_in = 0;
+    uintmax_t bytes_out = 0;
+    uintmax_t peak_rss_kb = 0; // 0 when unknown (in-process and worker plugins)
+};
+
+// Percentiles over the kept samples of one key
+struct PerfSummary {
+    PerfKey key;
+    size_t samples = 0;
+    int64_t p50_ms = 0;
+    int64_t p90_ms = 0;
+    int64_t p99_ms = 0;
+    double size_ratio = 1.0; // Median bytes_out / bytes_in
+    uintmax_t p50_rss_kb = 0;
+    uintmax_t max_rss_kb = 0;
+
+    nlohmann::json to_json() const {
+        return nlohmann::json{
+            {"plugin", key.plugin},
+            {"version", key.version},
+            {"target", key.target},
+            {"input_format", key.input_format},
+            {"size_bucket", key.size_bucket},
+            {"samples", samples},
+            {"p50_ms", p50_ms},
+            {"p90_ms", p90_ms},
+            {"p99_ms", p99_ms},
+            {"size_ratio", size_ratio},
+            {"p50_rss_kb", p50_rss_kb},
+            {"max_rss_kb", max_rss_kb}};
+    }
+};
+
+// Expected cost of running a plugin on an input
+struct PerfEstimate {
+    int64_t duration_ms = 0;
+    uintmax_t bytes_out = 0;
+    uintmax_t peak_rss_kb = 0;
+    size_t samples = 0;
+    bool exact = true; // False when scaled from a neighbouring size bucket
+};
+
+// Local history of plugin performance, kept in ~/.uniconv/stats.json.
+// Each key keeps its newest kMaxSamples samples. Recording is in memory;
+// save() merges the new samples into the file under a lock on
+// stats.json.lock, so concurrent runs don't lose each other's measurements.
+class PerfStats {
+public:
+    static constexpr size_t kMaxSamples = 64;
+
+    // Default stats file (~/.uniconv/stats.json)
+    static std::filesystem::path get_default_path();
+
+    explicit PerfStats(std::filesystem::path path);
+
+    // Build from settings: stats.path (default ~/.uniconv/stats.json);
+    // nullptr when stats.enabled is "false"
+    static std::shared_ptr<PerfStats> from_config(const ConfigManager& config);
+
+    // floor(log2(bytes)), 0 for empty inputs
+    static int size_bucket(uintmax_t bytes);
+
+    // Read the file; a missing file is an empty history
+    bool load();
+
+    // Write samples recorded since load(); false on I/O error
+    bool save();
+
+    // Thread-safe
+    void record(const PerfKey& key, const PerfSample& sample);
+
+    // Expected cost from the key's own bucket, else the nearest bucket of
+    // the same plugin, target and format scaled by input size
+    std::optional<PerfEstimate> estimate(const std::string& plugin,
+                                         const std::string& version,
+                                         const std::string& target,
+                                         const std::string& input_format,
+                                         uintmax_t bytes_in) const;
+
+    // Every key, most samples first
+    std::vector<PerfSummary> summaries() const;
+
+    // Drop all history (memory and file)
+    bool clear();
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    struct Series {
+        PerfKey key;
+        std::vector<PerfSample> samples; // Oldest first
+    };
+
+    std::filesystem::path path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Series> series_;
+    std::map<std::string, Series> pending_; // Recorded since load()
+
+    static void append(Series& series, const PerfSample& sample);
+    static PerfSummary summarize(const Series& series);
+    static bool read_file(const std::filesystem::path& path, std::map<std::string, Series>& out);
+};
+
+} // namespace uniconv::core
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "types.h"
+#include "plugin_resolver.h"
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -217,10 +218,14 @@ struct StageResult {
     ResultStatus status;
     std::optional<std::string> error;
     int64_t duration_ms = 0;
+    std::optional<size_t> item_index; // Position among a scattered stage's items
 
     nlohmann::json to_json() const {
         nlohmann::json j;
         j["stage_index"] = stage_index;
+        if (item_index) {
+            j["item_index"] = *item_index;
+        }
         j["target"] = target;
         j["plugin_used"] = plugin_used;
         j["input"] = input.string();
@@ -235,6 +240,66 @@ struct StageResult {
     }
 };
 
+// Expected cost of one conversion stage (--explain)
+struct StageEstimate {
+    size_t stage_index = 0;
+    std::string target;
+    std::string plugin;                    // Plugin resolution would pick
+    std::string matched_by;                // How it was picked (see ResolutionResult)
+    std::vector<ResolutionCandidate> candidates; // Ranked alternatives (auto-fastest)
+    std::string input_format;
+    uintmax_t input_size = 0;              // Expected input bytes
+    std::optional<int64_t> duration_ms;    // nullopt: no history for this stage
+    std::optional<uintmax_t> output_size;
+    uintmax_t peak_rss_kb = 0;
+    size_t samples = 0;
+    bool exact = true;                     // False when scaled from another size bucket
+
+    nlohmann::json to_json() const {
+        nlohmann::json j;
+        j["stage_index"] = stage_index;
+        j["target"] = target;
+        j["plugin"] = plugin;
+        j["matched_by"] = matched_by;
+        if (!candidates.empty()) {
+            j["candidates"] = nlohmann::json::array();
+            for (const auto& c : candidates) {
+                nlohmann::json cj;
+                cj["plugin"] = c.plugin;
+                cj["estimated_ms"] = c.estimated_ms ? nlohmann::json(*c.estimated_ms) : nlohmann::json(nullptr);
+                cj["samples"] = c.samples;
+                j["candidates"].push_back(cj);
+            }
+        }
+        j["input_format"] = input_format;
+        j["input_size"] = input_size;
+        j["duration_ms"] = duration_ms ? nlohmann::json(*duration_ms) : nlohmann::json(nullptr);
+        j["output_size"] = output_size ? nlohmann::json(*output_size) : nlohmann::json(nullptr);
+        j["peak_rss_kb"] = peak_rss_kb;
+        j["samples"] = samples;
+        j["exact"] = exact;
+        return j;
+    }
+};
+
+// Expected cost of a whole pipeline, before running it
+struct PipelineEstimate {
+    std::vector<StageEstimate> stages;
+    int64_t total_duration_ms = 0; // Sum over stages with history
+    size_t unknown_stages = 0;     // Stages without history
+
+    nlohmann::json to_json() const {
+        nlohmann::json j;
+        j["total_duration_ms"] = total_duration_ms;
+        j["unknown_stages"] = unknown_stages;
+        j["stages"] = nlohmann::json::array();
+        for (const auto& stage : stages) {
+            j["stages"].push_back(stage.to_json());
+        }
+        return j;
+    }
+};
+
 // Result of complete pipeline execution
 struct PipelineResult {
     bool success = false;
@@ -244,11 +309,33 @@ struct PipelineResult {
     int64_t total_duration_ms = 0;
     std::optional<std::string> error;
 
+    // Counts of everything recorded. When streamed, stage results and
+    // final outputs went to the output as they happened and the lists
+    // above stay empty.
+    bool streamed = false;
+    size_t stage_count = 0;
+    size_t failed_stage_count = 0;
+    size_t output_count = 0;
+
     nlohmann::json to_json() const {
         nlohmann::json j;
         j["success"] = success;
         j["total_duration_ms"] = total_duration_ms;
 
+        if (streamed) {
+            j["event"] = "done";
+            j["stage_count"] = stage_count;
+            j["failed_stage_count"] = failed_stage_count;
+            j["output_count"] = output_count;
+            if (error) {
+                j["error"] = *error;
+            }
+            if (!warnings.empty()) {
+                j["warnings"] = warnings;
+            }
+            return j;
+        }
+
         // Match SKETCH.md format: "pipeline" array with stage/target/plugin/input/output/duration_ms
         j["pipeline"] = nlohmann::json::array();
         for (const auto& sr : stage_results) {
@@ -1,17 +1,27 @@
 #include "pipeline_executor.h"
+#include "plugin_loader_cli.h"
+#include "route_planner.h"
+#include "thread_pool.h"
+#include "trace.h"
 #include "builtins/clipboard.h"
 #include "builtins/collect.h"
+#include "utils/file_utils.h"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <iomanip>
 #include <numeric>
 #include <sstream>
+#include <thread>
 
 #ifdef _WIN32
 #include <process.h>
 #define GETPID _getpid
 #else
+#include <fcntl.h>
 #include <unistd.h>
 #define GETPID getpid
 #endif
@@ -19,15 +29,40 @@
 namespace uniconv::core
 {
 
-    PipelineExecutor::PipelineExecutor(std::shared_ptr<Engine> engine)
+    PipelineExecutor::PipelineExecutor(std::shared_ptr<Engine> engine, const ScratchPolicy &scratch)
         : engine_(std::move(engine))
     {
-        // Per-run temp directory: /tmp/uniconv/run_<pid>_<timestamp>/
+        // Per-run temp directory: <scratch>/run_<pid>_<timestamp>/
         auto ts = std::chrono::steady_clock::now().time_since_epoch().count();
         std::ostringstream dir_name;
         dir_name << "run_" << GETPID() << "_" << ts;
-        temp_dir_ = std::filesystem::temp_directory_path() / "uniconv" / dir_name.str();
+        auto disk_root = scratch.dir.empty() ? std::filesystem::temp_directory_path() / "uniconv"
+                                             : scratch.dir;
+        temp_dir_ = disk_root / dir_name.str();
+
+        // Small intermediates go to RAM when its directory is usable
+        if (!scratch.ram_dir.empty() && scratch.ram_threshold > 0)
+        {
+            ram_temp_dir_ = scratch.ram_dir / dir_name.str();
+            ram_threshold_ = scratch.ram_threshold;
+        }
+    }
+
+    void PipelineExecutor::create_run_dirs()
+    {
+        // Created per run and removed by cleanup_temp_files, so an executor
+        // can run again and one that only explains leaves nothing behind
         std::filesystem::create_directories(temp_dir_);
+        if (!ram_temp_dir_.empty())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(ram_temp_dir_, ec);
+            if (ec || !std::filesystem::is_directory(ram_temp_dir_, ec))
+            {
+                ram_temp_dir_.clear();
+                ram_threshold_ = 0;
+            }
+        }
     }
 
     PipelineResult PipelineExecutor::execute(
@@ -36,12 +71,139 @@ namespace uniconv::core
     {
         auto start_time = std::chrono::steady_clock::now();
 
+        // Phase 1: Build execution graph
+        ExecutionGraph graph;
+        {
+            TraceSpan span("build_graph", "pipeline");
+            build_graph(graph, pipeline);
+            span.arg("nodes", graph.nodes().size());
+        }
+
+        return run(graph, pipeline, output, start_time);
+    }
+
+    PrepareResult PipelineExecutor::prepare(const Pipeline &pipeline)
+    {
+        TraceSpan span("prepare", "pipeline");
+        PrepareResult prepared;
+
+        ExecutionGraph graph;
+        graph.build_from_pipeline(pipeline);
+
+        auto &plugins = engine_->plugin_manager();
+        for (size_t id : graph.execution_order())
+        {
+            auto &node = graph.node(id);
+            if (node.is_builtin())
+            {
+                continue;
+            }
+
+            std::string stage = "Stage " + std::to_string(node.stage_idx + 1) + " ('" + node.target + "'): ";
+            auto *plugin = plugins.find_plugin(node.target, node.plugin);
+            if (!plugin)
+            {
+                prepared.error = stage + (node.plugin ? "plugin '" + *node.plugin + "' not found"
+                                                      : "no plugin provides this target");
+                return prepared;
+            }
+            if (auto err = prepare_node(node))
+            {
+                prepared.error = stage + *err;
+                return prepared;
+            }
+
+            // A direct conversion predecessor must produce something this
+            // plugin reads (plugins without declared types always connect)
+            if (node.input_nodes.size() == 1 && !graph.node(node.input_nodes[0]).is_builtin())
+            {
+                const auto &from = graph.node(node.input_nodes[0]);
+                auto *from_plugin = plugins.find_plugin(from.target, from.plugin);
+                if (from_plugin && !plugins.can_connect(from_plugin->info(), plugin->info()))
+                {
+                    prepared.error = stage + "cannot read the output of '" + from.target + "'";
+                    return prepared;
+                }
+            }
+        }
+
+        span.arg("nodes", graph.nodes().size());
+        prepared.prepared = std::make_shared<PreparedPipeline>(pipeline, std::move(graph));
+        prepared.success = true;
+        return prepared;
+    }
+
+    PipelineResult PipelineExecutor::execute(
+        const PreparedPipeline &prepared,
+        const std::filesystem::path &source,
+        const std::shared_ptr<output::IOutput> &output,
+        const std::optional<std::filesystem::path> &output_path)
+    {
+        auto start_time = std::chrono::steady_clock::now();
+
+        Pipeline pipeline = prepared.pipeline();
+        pipeline.source = source;
+        if (output_path)
+        {
+            pipeline.core_options.output = output_path;
+        }
+
+        ExecutionGraph graph;
+        {
+            TraceSpan span("build_graph", "pipeline");
+            bool routable = !source.empty() && !std::filesystem::is_directory(source);
+            std::string format = routable ? pipeline.input_format.value_or(utils::detect_format(source)) : "";
+            graph = prepared.graph_for(format, [&](ExecutionGraph &planned)
+                                       {
+                planned.bind_source(source);
+                if (!routable)
+                {
+                    return;
+                }
+                plan_routes(planned, format, utils::regular_file_size(source));
+                // Routing chose new plugins; a node that fails to resolve
+                // is left for execution to report
+                for (auto &node : planned.nodes())
+                {
+                    if (node.routed)
+                    {
+                        node.prepared = false;
+                        node.prepared = !prepare_node(node);
+                    }
+                } });
+            graph.bind_source(source);
+            span.arg("nodes", graph.nodes().size());
+        }
+
+        return run(graph, pipeline, output, start_time);
+    }
+
+    PipelineResult PipelineExecutor::run(
+        ExecutionGraph &graph,
+        const Pipeline &pipeline,
+        const std::shared_ptr<output::IOutput> &output,
+        std::chrono::steady_clock::time_point start_time)
+    {
         PipelineResult final_result;
         final_result.success = false;
 
-        // Phase 1: Build execution graph
-        ExecutionGraph graph;
-        build_graph(graph, pipeline);
+        // --json-stream: report results as they happen, keep only counters
+        result_stream_ = output && output->streams_results() ? output : nullptr;
+        final_result.streamed = result_stream_ != nullptr;
+
+        // Unless configured otherwise, --jobs above the core count is taken
+        // as a request for that many single-threaded slots
+        if (!scheduler_)
+        {
+            size_t jobs = ThreadPool::resolve_worker_count(
+                static_cast<size_t>(std::max(pipeline.core_options.jobs, 0)));
+            auto min_cpus = std::max(jobs, scatter_width(pipeline.core_options));
+            scheduler_ = std::make_shared<ResourceScheduler>(ResourceBudget::defaults(),
+                                                             static_cast<unsigned>(min_cpus));
+        }
+
+        create_run_dirs();
+        plan_temp_release(graph, pipeline);
 
         // Count non-builtin nodes for progress reporting
         size_t total_conversion_nodes = std::accumulate(
@@ -58,7 +220,12 @@ namespace uniconv::core
         }
 
         // Phase 3: Finalize outputs (with full visibility of graph)
-        if (!finalize_outputs(graph, pipeline, final_result))
+        bool finalized;
+        {
+            TraceSpan span("finalize", "pipeline");
+            finalized = finalize_outputs(graph, pipeline, final_result);
+        }
+        if (!finalized)
         {
             cleanup_temp_files();
             return final_result;
@@ -78,6 +245,147 @@ namespace uniconv::core
     void PipelineExecutor::build_graph(ExecutionGraph &graph, const Pipeline &pipeline)
     {
         graph.build_from_pipeline(pipeline);
+        plan_routes(graph, pipeline);
+    }
+
+    void PipelineExecutor::plan_routes(ExecutionGraph &graph, const Pipeline &pipeline)
+    {
+        // Generators and directory sources have no format to route from
+        if (pipeline.source.empty() || std::filesystem::is_directory(pipeline.source))
+            return;
+
+        plan_routes(graph,
+                    pipeline.input_format.value_or(utils::detect_format(pipeline.source)),
+                    utils::regular_file_size(pipeline.source));
+    }
+
+    void PipelineExecutor::plan_routes(ExecutionGraph &graph,
+                                       const std::string &source_format,
+                                       uintmax_t source_size)
+    {
+        std::optional<RoutePlanner> planner;
+        std::vector<std::string> formats(graph.nodes().size());
+        for (size_t id : graph.execution_order())
+        {
+            std::string format = graph.node(id).input_nodes.empty()
+                                     ? source_format
+                                     : formats[graph.node(id).input_nodes[0]];
+            auto &node = graph.node(id);
+
+            if (node.is_builtin())
+            {
+                // Nothing to route after a collect (directory input)
+                formats[id] = node.is_collect ? "" : format;
+                continue;
+            }
+
+            std::optional<Route> route;
+            if (!node.plugin && !format.empty())
+            {
+                if (!planner)
+                    planner.emplace(engine_->plugin_manager().list_plugins(), engine_->stats());
+                if (!planner->has_direct(format, node.target))
+                    route = planner->plan(format, node.target, source_size);
+            }
+
+            if (route)
+            {
+                // Every hop but the last becomes a node in front of this one
+                for (size_t h = 0; h + 1 < route->hops.size(); ++h)
+                {
+                    const auto &hop = route->hops[h];
+                    size_t hop_id = graph.insert_before(id);
+                    auto &hop_node = graph.node(hop_id);
+                    hop_node.target = hop.target;
+                    hop_node.plugin = hop.plugin;
+                    hop_node.routed = true;
+                    formats.push_back(hop.output_format);
+                }
+                graph.node(id).plugin = route->hops.back().plugin;
+                graph.node(id).routed = true;
+            }
+
+            auto &current = graph.node(id);
+            formats[id] = current.extension.value_or(current.target);
+        }
+    }
+
+    PipelineEstimate PipelineExecutor::explain(const Pipeline &pipeline)
+    {
+        ExecutionGraph graph;
+        build_graph(graph, pipeline);
+
+        // Expected output format and size of each node
+        std::vector<std::string> formats(graph.nodes().size());
+        std::vector<uintmax_t> sizes(graph.nodes().size(), 0);
+
+        std::string source_format = pipeline.input_format.value_or("");
+        uintmax_t source_size = 0;
+        if (!pipeline.source.empty())
+        {
+            if (std::filesystem::is_directory(pipeline.source))
+            {
+                source_format = "directory";
+            }
+            else
+            {
+                source_format = utils::detect_format(pipeline.source);
+                source_size = utils::regular_file_size(pipeline.source);
+            }
+        }
+
+        PipelineEstimate estimate;
+        for (size_t id : graph.execution_order())
+        {
+            auto &node = graph.node(id);
+
+            std::string format = source_format;
+            uintmax_t size = source_size;
+            if (!node.input_nodes.empty())
+            {
+                format = formats[node.input_nodes[0]];
+                size = 0;
+                for (size_t in : node.input_nodes)
+                    size += sizes[in];
+            }
+
+            if (node.is_builtin())
+            {
+                formats[id] = node.is_collect ? "directory" : format;
+                sizes[id] = size;
+                continue;
+            }
+
+            StageEstimate stage;
+            stage.stage_index = node.stage_idx;
+            stage.target = node.target;
+            stage.input_format = format;
+            stage.input_size = size;
+            ResolutionResult resolution;
+            auto cost = engine_->estimate(node.target, format, node.plugin, size, &resolution);
+            if (resolution.plugin)
+                stage.plugin = resolution.plugin->info().scope;
+            stage.matched_by = node.routed ? "route" : resolution.matched_by;
+            stage.candidates = std::move(resolution.candidates);
+            if (cost)
+            {
+                stage.duration_ms = cost->duration_ms;
+                stage.output_size = cost->bytes_out;
+                stage.peak_rss_kb = cost->peak_rss_kb;
+                stage.samples = cost->samples;
+                stage.exact = cost->exact;
+                estimate.total_duration_ms += cost->duration_ms;
+            }
+            else
+            {
+                ++estimate.unknown_stages;
+            }
+
+            formats[id] = node.extension.value_or(node.target);
+            sizes[id] = stage.output_size.value_or(size);
+            estimate.stages.push_back(std::move(stage));
+        }
+        return estimate;
     }
 
     bool PipelineExecutor::execute_graph(
@@ -87,6 +395,13 @@ namespace uniconv::core
         size_t total_conversion_nodes,
         PipelineResult &result)
     {
+        if (pipeline.core_options.jobs != 1)
+        {
+            size_t jobs = static_cast<size_t>(std::max(pipeline.core_options.jobs, 0));
+            return execute_graph_parallel(graph, pipeline, output,
+                                          total_conversion_nodes, jobs, result);
+        }
+
         // Get execution order (topological sort)
         auto order = graph.execution_order();
         size_t current_conversion_node = 0;
@@ -99,11 +414,141 @@ namespace uniconv::core
             {
                 return false;
             }
+            release_temp_inputs(node_id, graph);
         }
 
         return true;
     }
 
+    bool PipelineExecutor::execute_graph_parallel(
+        ExecutionGraph &graph,
+        const Pipeline &pipeline,
+        const std::shared_ptr<output::IOutput> &output,
+        size_t total_conversion_nodes,
+        size_t jobs,
+        PipelineResult &result)
+    {
+        auto order = graph.execution_order();
+        const size_t node_count = graph.nodes().size();
+
+        // Progress numbering follows the serial execution order
+        std::vector<size_t> conversion_index(node_count, 0);
+        size_t conversions = 0;
+        for (size_t node_id : order)
+        {
+            if (!graph.node(node_id).is_builtin())
+            {
+                conversion_index[node_id] = conversions++;
+            }
+        }
+
+        std::vector<size_t> pending_inputs(node_count, 0);
+        for (const auto &node : graph.nodes())
+        {
+            pending_inputs[node.id] = node.input_nodes.size();
+        }
+
+        // Each node records into its own result; merged after the run
+        std::vector<PipelineResult> node_results(node_count);
+        std::vector<char> attempted(node_count, 0);
+        std::vector<char> succeeded(node_count, 0);
+
+        std::mutex state_mutex;
+        std::condition_variable state_cv;
+        size_t in_flight = 0;
+        bool failed = false;
+
+        ThreadPool pool(jobs);
+
+        // Called with state_mutex held
+        std::function<void(size_t)> dispatch = [&](size_t node_id)
+        {
+            attempted[node_id] = 1;
+            ++in_flight;
+            pool.submit([&, node_id]()
+                        {
+                size_t current = conversion_index[node_id];
+                bool ok = false;
+                try
+                {
+                    ok = execute_node(graph.node(node_id), graph, pipeline, output,
+                                      current, total_conversion_nodes, node_results[node_id]);
+                }
+                catch (const std::exception &e)
+                {
+                    node_results[node_id].error = e.what();
+                }
+                if (ok)
+                {
+                    release_temp_inputs(node_id, graph);
+                }
+
+                std::lock_guard<std::mutex> lock(state_mutex);
+                succeeded[node_id] = ok ? 1 : 0;
+                if (!ok)
+                {
+                    // Stop scheduling new work; in-flight nodes finish normally
+                    failed = true;
+                }
+                else if (!failed)
+                {
+                    for (size_t consumer_id : graph.node(node_id).output_nodes)
+                    {
+                        if (--pending_inputs[consumer_id] == 0)
+                        {
+                            dispatch(consumer_id);
+                        }
+                    }
+                }
+                --in_flight;
+                state_cv.notify_all(); });
+        };
+
+        {
+            std::unique_lock<std::mutex> lock(state_mutex);
+            for (const auto &node : graph.nodes())
+            {
+                if (node.input_nodes.empty())
+                {
+                    dispatch(node.id);
+                }
+            }
+            state_cv.wait(lock, [&]()
+                          { return in_flight == 0; });
+        }
+        pool.wait_idle();
+
+        // Merge in topological order so output matches a serial run
+        bool success = true;
+        for (size_t node_id : order)
+        {
+            auto &node_result = node_results[node_id];
+            result.stage_results.insert(result.stage_results.end(),
+                                        node_result.stage_results.begin(),
+                                        node_result.stage_results.end());
+            result.final_outputs.insert(result.final_outputs.end(),
+                                        node_result.final_outputs.begin(),
+                                        node_result.final_outputs.end());
+            result.warnings.insert(result.warnings.end(),
+                                   node_result.warnings.begin(),
+                                   node_result.warnings.end());
+            result.stage_count += node_result.stage_count;
+            result.failed_stage_count += node_result.failed_stage_count;
+            result.output_count += node_result.output_count;
+
+            if (success && attempted[node_id] && !succeeded[node_id])
+            {
+                success = false;
+                result.success = false;
+                result.error = node_result.error.has_value()
+                                   ? node_result.error
+                                   : graph.node(node_id).error;
+            }
+        }
+
+        return success;
+    }
+
     bool PipelineExecutor::execute_node(
         ExecutionNode &node,
         ExecutionGraph &graph,
@@ -133,14 +578,41 @@ namespace uniconv::core
         {
             ++current_conversion_node;
 
+            // Already run item-by-item as part of a pipelined chain
+            if (node.executed)
+            {
+                return true;
+            }
+
             // If pipeline width > 1 (we're in a scattered context),
             // execute this node once per scattered input
-            if (pipeline_width_ > 1 && !scattered_paths_.empty())
+            if (scatter_inputs(node, graph).size() > 1)
             {
+                if (pipeline.core_options.pipelined)
+                {
+                    auto chain = pipelined_chain(node, graph);
+                    if (chain.size() > 1)
+                    {
+                        return execute_pipelined_chain(chain, graph, pipeline, output,
+                                                       total_conversion_nodes, result);
+                    }
+                }
+
                 return execute_scattered_conversion(node, graph, pipeline, output,
                                                    current_conversion_node, total_conversion_nodes, result);
             }
 
+            // Stream-capable neighbours run concurrently, connected by pipes
+            if (!pipeline.core_options.dry_run)
+            {
+                auto chain = streamed_chain(node, graph);
+                if (chain.size() > 1)
+                {
+                    return execute_streamed_chain(chain, graph, pipeline, output,
+                                                  total_conversion_nodes, result);
+                }
+            }
+
             return execute_conversion_node(node, graph, pipeline, output,
                                           current_conversion_node, total_conversion_nodes, result);
         }
@@ -166,7 +638,7 @@ namespace uniconv::core
         stage_result.output = node.temp_output;
         stage_result.status = ResultStatus::Success;
         stage_result.duration_ms = 0;
-        result.stage_results.push_back(stage_result);
+        add_stage_result(result, stage_result);
 
         return true;
     }
@@ -214,33 +686,34 @@ namespace uniconv::core
             stage_result.output = collect_result.output_dir;
             stage_result.status = ResultStatus::Success;
             stage_result.duration_ms = 0;
-            result.stage_results.push_back(stage_result);
+            add_stage_result(result, stage_result);
 
             return true;
         }
 
-        // Collect gathers all scattered paths into a temp directory
-        // The scattered_paths_ vector holds the current N parallel file paths
-
-        if (scattered_paths_.empty())
+        // Collect gathers all scattered paths into a temp directory:
+        // each predecessor contributes its N scattered paths, or its single output
+        std::vector<std::filesystem::path> gathered;
+        for (size_t pred_id : node.input_nodes)
         {
-            // Fall back to collecting from input nodes
-            for (size_t pred_id : node.input_nodes)
+            const auto &pred = graph.node(pred_id);
+            std::vector<std::filesystem::path> pred_paths = pred.scatter_outputs;
+            if (pred_paths.empty() && (pred.is_tee || pred.is_passthrough || pred.is_clipboard))
             {
-                const auto &pred = graph.node(pred_id);
-                if (!pred.scatter_outputs.empty())
-                {
-                    scattered_paths_ = pred.scatter_outputs;
-                    break;
-                }
-                else if (!pred.temp_output.empty())
-                {
-                    scattered_paths_.push_back(pred.temp_output);
-                }
+                pred_paths = scatter_inputs(pred, graph);
+            }
+
+            if (!pred_paths.empty())
+            {
+                gathered.insert(gathered.end(), pred_paths.begin(), pred_paths.end());
+            }
+            else if (!pred.temp_output.empty())
+            {
+                gathered.push_back(pred.temp_output);
             }
         }
 
-        if (scattered_paths_.empty())
+        if (gathered.empty())
         {
             node.status = ResultStatus::Error;
             node.error = "Collect has no inputs to gather";
@@ -248,10 +721,10 @@ namespace uniconv::core
             return false;
         }
 
-        node.collect_inputs = scattered_paths_;
+        node.collect_inputs = gathered;
 
         // Execute the collect builtin
-        auto collect_result = builtins::Collect::execute(scattered_paths_, temp_dir_);
+        auto collect_result = builtins::Collect::execute(gathered, temp_dir_);
 
         if (!collect_result.success)
         {
@@ -261,16 +734,12 @@ namespace uniconv::core
             return false;
         }
 
-        node.input = scattered_paths_[0]; // Representative input for logging
+        node.input = gathered[0]; // Representative input for logging
         node.temp_output = collect_result.output_dir;
         node.executed = true;
         node.status = ResultStatus::Success;
         node.plugin_used = "builtin:collect";
 
-        // Reset pipeline width back to 1
-        pipeline_width_ = 1;
-        scattered_paths_.clear();
-
         // Record stage result
         StageResult stage_result;
         stage_result.stage_index = node.stage_idx;
@@ -280,7 +749,7 @@ namespace uniconv::core
         stage_result.output = collect_result.output_dir;
         stage_result.status = ResultStatus::Success;
         stage_result.duration_ms = 0;
-        result.stage_results.push_back(stage_result);
+        add_stage_result(result, stage_result);
 
         return true;
     }
@@ -306,7 +775,7 @@ namespace uniconv::core
         stage_result.output = node.temp_output;
         stage_result.status = ResultStatus::Success;
         stage_result.duration_ms = 0;
-        result.stage_results.push_back(stage_result);
+        add_stage_result(result, stage_result);
 
         return true;
     }
@@ -349,7 +818,7 @@ namespace uniconv::core
         {
             stage_result.error = clipboard_result.error;
         }
-        result.stage_results.push_back(stage_result);
+        add_stage_result(result, stage_result);
 
         if (!clipboard_result.success)
         {
@@ -375,28 +844,25 @@ namespace uniconv::core
         node.input = get_node_input(node, graph);
 
         // Resolve extension and sink flag from plugin
-        node.resolved_extension = resolve_extension(node);
-        auto *resolved_plugin = engine_->plugin_manager().find_plugin(node.target, node.plugin);
-        if (resolved_plugin)
+        if (auto err = prepare_node(node))
         {
-            node.is_sink = resolved_plugin->info().sink;
-            auto err = validate_required_options(
-                resolved_plugin->info().options, node.options, node.target);
-            if (!err.empty())
-            {
-                node.status = ResultStatus::Error;
-                node.error = err;
-                result.error = err;
-                result.success = false;
-                return false;
-            }
+            node.status = ResultStatus::Error;
+            node.error = err;
+            result.error = err;
+            result.success = false;
+            return false;
         }
 
+        const Buffer *input_data = node.input_nodes.size() == 1
+                                       ? graph.node(node.input_nodes[0]).output_data.get()
+                                       : nullptr;
+
+        // Wait for room in the memory / CPU budget
+        auto lease = scheduler_->acquire(resource_claim(node, pipeline, node.input, input_data));
+
         // Report progress: stage started
-        if (output)
-        {
-            output->stage_started(current_node, total_nodes, node.target);
-        }
+        report_stage_started(output, current_node, total_nodes, node.target,
+                             expected_duration_ms(node, pipeline, node.input, input_data));
 
         auto node_start = std::chrono::steady_clock::now();
 
@@ -407,7 +873,8 @@ namespace uniconv::core
             node.temp_output = generate_temp_path(
                 node.resolved_extension,
                 node.stage_idx,
-                node.element_idx);
+                node.element_idx,
+                expected_output_size(node, pipeline, node.input, input_data));
         }
 
         // Build request
@@ -422,6 +889,18 @@ namespace uniconv::core
         }
         request.plugin_options = node.plugin_options;
 
+        // Native-to-native edges pass the intermediate in memory; node.input
+        // then only names it
+        ExecutionNode *producer = node.input_nodes.size() == 1
+                                      ? &graph.node(node.input_nodes[0])
+                                      : nullptr;
+        if (producer && producer->output_data)
+        {
+            request.input_data = producer->output_data;
+        }
+        request.output_in_memory = !node.is_sink && !pipeline.core_options.dry_run &&
+                                   keeps_output_in_memory(node, graph);
+
         // For temp files from previous stages, use extension as format hint
         if (is_temp_path(node.input))
         {
@@ -441,6 +920,7 @@ namespace uniconv::core
 
         // Execute through engine
         auto etl_result = engine_->execute(request);
+        lease.release();
 
         auto node_end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(node_end - node_start).count();
@@ -457,19 +937,23 @@ namespace uniconv::core
             actual_output = etl_result.output.value_or(node.temp_output);
         }
         node.temp_output = actual_output;
+        node.output_data = etl_result.output_data;
         node.plugin_used = etl_result.plugin_used;
         node.executed = true;
         node.duration_ms = duration;
 
+        // This node was the intermediate's only reader
+        if (request.input_data)
+        {
+            producer->output_data.reset();
+        }
+
         bool success = (etl_result.status == ResultStatus::Success);
         std::string error_msg = etl_result.error.value_or("");
 
         // Report progress: stage completed
-        if (output)
-        {
-            output->stage_completed(current_node, total_nodes, node.target,
-                                   duration, success, error_msg);
-        }
+        report_stage_completed(output, current_node, total_nodes, node.target,
+                               duration, success, error_msg);
 
         // Record stage result
         StageResult stage_result;
@@ -481,7 +965,7 @@ namespace uniconv::core
         stage_result.status = etl_result.status;
         stage_result.error = etl_result.error;
         stage_result.duration_ms = duration;
-        result.stage_results.push_back(stage_result);
+        add_stage_result(result, stage_result);
 
         if (!success)
         {
@@ -497,7 +981,7 @@ namespace uniconv::core
             node.final_output = actual_output;
             if (!actual_output.empty())
             {
-                result.final_outputs.push_back(actual_output);
+                add_final_output(result, actual_output);
             }
             node.status = ResultStatus::Success;
             return true;
@@ -507,8 +991,6 @@ namespace uniconv::core
         if (etl_result.is_scatter())
         {
             node.scatter_outputs = etl_result.outputs;
-            scattered_paths_ = etl_result.outputs;
-            pipeline_width_ = etl_result.outputs.size();
         }
 
         node.status = ResultStatus::Success;
@@ -517,7 +999,7 @@ namespace uniconv::core
 
     bool PipelineExecutor::execute_scattered_conversion(
         ExecutionNode &node,
-        [[maybe_unused]] ExecutionGraph &graph,
+        ExecutionGraph &graph,
         const Pipeline &pipeline,
         const std::shared_ptr<output::IOutput> &output,
         size_t current_node,
@@ -525,150 +1007,688 @@ namespace uniconv::core
         PipelineResult &result)
     {
         // Resolve extension and sink flag from plugin
-        node.resolved_extension = resolve_extension(node);
-        auto *resolved_plugin = engine_->plugin_manager().find_plugin(node.target, node.plugin);
-        if (resolved_plugin)
+        if (auto err = prepare_node(node))
         {
-            node.is_sink = resolved_plugin->info().sink;
-            auto err = validate_required_options(
-                resolved_plugin->info().options, node.options, node.target);
-            if (!err.empty())
-            {
-                node.status = ResultStatus::Error;
-                node.error = err;
-                result.error = err;
-                result.success = false;
-                return false;
-            }
+            node.status = ResultStatus::Error;
+            node.error = err;
+            result.error = err;
+            result.success = false;
+            return false;
         }
 
         // Execute the conversion once for each scattered input
-        std::vector<std::filesystem::path> new_scattered_paths;
-        new_scattered_paths.reserve(scattered_paths_.size());
-
-        for (size_t i = 0; i < scattered_paths_.size(); ++i)
+        auto scattered_paths = scatter_inputs(node, graph);
+        const size_t count = scattered_paths.size();
+
+        // One output slot per scatter index so outputs keep input order
+        // (collect and the _0000 naming in finalize_outputs depend on it).
+        // Results are buffered for in-order reporting, except when they
+        // stream (--json-stream): each is then emitted as it completes,
+        // with its item index, and only the first failure is kept.
+        const bool streaming = result_stream_ != nullptr;
+        std::vector<StageResult> items(streaming ? 0 : count);
+        std::vector<std::filesystem::path> outputs(count);
+        std::vector<char> succeeded(count, 0);
+        std::mutex item_mutex;
+        std::optional<size_t> first_failure;
+        std::string failure_error;
+        size_t attempted = 0;
+
+        // Delete each scattered input once converted when nothing else
+        // reads it. Under --temp-budget, items wait for room based on the
+        // average output so far (the input size before any has finished).
+        bool consume_inputs = consumes_scatter_inputs(node);
+        std::atomic<uintmax_t> produced_bytes{0};
+        std::atomic<size_t> produced_items{0};
+        auto run_item = [&](size_t i)
         {
-            const auto &scattered_input = scattered_paths_[i];
-
-            // Report progress
-            if (output)
+            uintmax_t estimate = 0;
+            if (temp_budget_ > 0)
             {
-                output->stage_started(current_node, total_nodes,
-                                     node.target + " [" + std::to_string(i + 1) + "/" +
-                                     std::to_string(scattered_paths_.size()) + "]");
+                size_t done = produced_items.load();
+                estimate = done > 0 ? produced_bytes.load() / done
+                                    : utils::regular_file_size(scattered_paths[i]);
             }
+            uintmax_t reservation = reserve_temp(estimate);
+            auto item = execute_scatter_item(node, pipeline, output, current_node,
+                                             total_nodes, scattered_paths[i], i, count);
+            settle_temp(reservation, item.output);
 
-            auto scatter_start = std::chrono::steady_clock::now();
-
-            // Generate a unique temp path for this scatter index (skip for sink)
-            std::filesystem::path temp_output;
-            if (!node.is_sink)
+            bool ok = item.status == ResultStatus::Success;
+            if (ok)
             {
-                temp_output = generate_scatter_temp_path(
-                    node.resolved_extension, node.stage_idx, node.element_idx, i);
+                if (temp_budget_ > 0)
+                {
+                    produced_bytes += utils::regular_file_size(item.output);
+                    ++produced_items;
+                }
+                if (consume_inputs && is_temp_path(scattered_paths[i]))
+                {
+                    remove_temp_output(scattered_paths[i]);
+                }
             }
 
-            // Build request
-            Request request;
-            request.source = scattered_input;
-            request.target = node.target;
-            request.plugin = node.plugin;
-            request.core_options = pipeline.core_options;
-            if (!node.is_sink)
+            std::lock_guard<std::mutex> lock(item_mutex);
+            if (ok)
             {
-                request.core_options.output = temp_output;
+                outputs[i] = item.output;
+                succeeded[i] = 1;
             }
-            request.plugin_options = node.plugin_options;
-
-            // Format hint for temp files
-            if (is_temp_path(scattered_input))
+            else if (!first_failure || i < *first_failure)
             {
-                std::string ext = scattered_input.extension().string();
-                if (!ext.empty() && ext[0] == '.')
-                    ext = ext.substr(1);
-                if (!ext.empty())
-                    request.input_format = ext;
+                first_failure = i;
+                failure_error = item.error.value_or("");
+            }
+            if (streaming)
+                add_stage_result(result, item);
+            else
+                items[i] = std::move(item);
+            return ok;
+        };
+
+        size_t width = scatter_width(pipeline.core_options);
+        if (width <= 1 || count <= 1)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                ++attempted;
+                if (!run_item(i))
+                    break;
+            }
+        }
+        else
+        {
+            // Bounded fan-out: at most `width` plugin invocations at a time.
+            // After a failure no new items start; running ones finish.
+            std::atomic<bool> failed{false};
+            std::vector<char> ran(count, 0);
+            {
+                ThreadPool pool(std::min(width, count));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    pool.submit([&, i]()
+                                {
+                        if (failed.load())
+                            return;
+                        ran[i] = 1;
+                        if (!run_item(i))
+                            failed.store(true); });
+                }
+                pool.wait_idle();
+            }
+
+            // Report every item that ran, in index order, up to and including
+            // the first failure
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!ran[i])
+                    continue;
+                attempted = i + 1;
+                if (!succeeded[i])
+                    break;
             }
+        }
 
-            // Execute through engine
-            auto etl_result = engine_->execute(request);
+        if (!streaming)
+        {
+            for (size_t i = 0; i < attempted; ++i)
+                add_stage_result(result, items[i]);
+            items.clear();
+        }
+
+        if (first_failure)
+        {
+            node.status = ResultStatus::Error;
+            node.error = failure_error.empty() ? "Unknown error" : failure_error;
+            result.error = node.error;
+            return false;
+        }
 
-            auto scatter_end = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                                scatter_end - scatter_start).count();
+        std::vector<std::filesystem::path> new_scattered_paths = std::move(outputs);
 
-            std::filesystem::path actual_output;
+        // Sink node: record all plugin outputs as final (skip finalization)
+        if (node.is_sink)
+        {
+            for (const auto &p : new_scattered_paths)
+            {
+                if (!p.empty())
+                    add_final_output(result, p);
+            }
+            node.plugin_used = "";
+            node.executed = true;
+            node.status = ResultStatus::Success;
+            return true;
+        }
+
+        // Scattered paths for the next stage
+        node.scatter_outputs = new_scattered_paths;
+
+        // Use the first output as the node's temp_output for graph connectivity
+        if (!new_scattered_paths.empty())
+        {
+            node.temp_output = new_scattered_paths[0];
+        }
+
+        node.plugin_used = ""; // Multiple executions, no single plugin
+        node.executed = true;
+        node.status = ResultStatus::Success;
+        return true;
+    }
+
+    bool PipelineExecutor::execute_pipelined_chain(
+        const std::vector<size_t> &chain,
+        ExecutionGraph &graph,
+        const Pipeline &pipeline,
+        const std::shared_ptr<output::IOutput> &output,
+        size_t total_nodes,
+        PipelineResult &result)
+    {
+        // Resolve every stage up front; a sink can only end the chain
+        std::vector<size_t> stages;
+        std::vector<size_t> numbers;
+        for (size_t node_id : chain)
+        {
+            auto &node = graph.node(node_id);
+            if (auto err = prepare_node(node))
+            {
+                node.status = ResultStatus::Error;
+                node.error = err;
+                result.error = err;
+                result.success = false;
+                return false;
+            }
+
+            stages.push_back(node_id);
+            numbers.push_back(conversion_number(graph, node_id));
             if (node.is_sink)
             {
-                actual_output = etl_result.output.value_or("");
+                break;
             }
-            else
+        }
+
+        auto scattered_paths = scatter_inputs(graph.node(stages.front()), graph);
+        const size_t count = scattered_paths.size();
+
+        // items[k][i]: stage result of item i at chain stage k
+        std::vector<std::vector<StageResult>> items(
+            stages.size(), std::vector<StageResult>(count));
+        std::vector<size_t> reached(count, 0);
+        std::atomic<bool> failed{false};
+
+        // Each item runs through every stage on its own; there is no barrier
+        // between stages. A stage's output is deleted as soon as the next
+        // stage has consumed it.
+        auto run_item = [&](size_t i)
+        {
+            std::filesystem::path current = scattered_paths[i];
+            for (size_t k = 0; k < stages.size(); ++k)
+            {
+                if (failed.load())
+                    return;
+
+                const auto &node = graph.node(stages[k]);
+                items[k][i] = execute_scatter_item(node, pipeline, output, numbers[k],
+                                                   total_nodes, current, i, count);
+                reached[i] = k + 1;
+                if (items[k][i].status != ResultStatus::Success)
+                {
+                    failed.store(true);
+                    return;
+                }
+
+                if (k > 0 && is_temp_path(current))
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(current, ec);
+                }
+                current = items[k][i].output;
+            }
+        };
+
+        size_t width = scatter_width(pipeline.core_options);
+        if (width <= 1 || count <= 1)
+        {
+            for (size_t i = 0; i < count && !failed.load(); ++i)
             {
-                actual_output = etl_result.output.value_or(temp_output);
+                run_item(i);
             }
+        }
+        else
+        {
+            ThreadPool pool(std::min(width, count));
+            for (size_t i = 0; i < count; ++i)
+            {
+                pool.submit([&, i]()
+                            { run_item(i); });
+            }
+            pool.wait_idle();
+        }
 
-            bool success = (etl_result.status == ResultStatus::Success);
-            std::string error_msg = etl_result.error.value_or("");
+        // Record results stage by stage, in item order, like the barrier mode
+        for (size_t k = 0; k < stages.size(); ++k)
+        {
+            auto &node = graph.node(stages[k]);
+            std::vector<std::filesystem::path> outputs;
+            outputs.reserve(count);
+            bool complete = true;
 
-            if (output)
+            for (size_t i = 0; i < count; ++i)
             {
-                output->stage_completed(current_node, total_nodes,
-                                       node.target + " [" + std::to_string(i + 1) + "/" +
-                                       std::to_string(scattered_paths_.size()) + "]",
-                                       duration, success, error_msg);
+                if (reached[i] <= k)
+                {
+                    complete = false;
+                    continue;
+                }
+
+                const auto &item = items[k][i];
+                add_stage_result(result, item);
+                if (item.status != ResultStatus::Success)
+                {
+                    // Report the lowest failing index of the earliest stage
+                    if (node.status != ResultStatus::Error)
+                    {
+                        std::string error_msg = item.error.value_or("");
+                        node.status = ResultStatus::Error;
+                        node.error = error_msg.empty() ? "Unknown error" : error_msg;
+                    }
+                    complete = false;
+                    continue;
+                }
+                outputs.push_back(item.output);
             }
 
-            // Record stage result for each scatter execution
+            if (node.status == ResultStatus::Error)
+            {
+                result.error = node.error;
+                return false;
+            }
+            if (!complete)
+            {
+                // Items were stopped because another item failed further on
+                continue;
+            }
+
+            node.plugin_used = ""; // Multiple executions, no single plugin
+            node.executed = true;
+            node.status = ResultStatus::Success;
+
+            if (node.is_sink)
+            {
+                for (const auto &p : outputs)
+                {
+                    if (!p.empty())
+                        add_final_output(result, p);
+                }
+                continue;
+            }
+
+            // Intermediate stages' files are already gone; only the last
+            // stage's outputs are read by collect or finalize_outputs
+            node.scatter_outputs = outputs;
+            if (!outputs.empty())
+            {
+                node.temp_output = outputs[0];
+            }
+        }
+
+        return !failed.load();
+    }
+
+    bool PipelineExecutor::execute_streamed_chain(
+        const std::vector<size_t> &chain,
+        ExecutionGraph &graph,
+        const Pipeline &pipeline,
+        const std::shared_ptr<output::IOutput> &output,
+        size_t total_nodes,
+        PipelineResult &result)
+    {
+        const size_t count = chain.size();
+        std::vector<size_t> numbers;
+        for (size_t node_id : chain)
+        {
+            auto &node = graph.node(node_id);
+            if (auto err = prepare_node(node))
+            {
+                node.status = ResultStatus::Error;
+                node.error = err;
+                result.error = err;
+                result.success = false;
+                return false;
+            }
+            numbers.push_back(conversion_number(graph, node_id));
+        }
+
+        // pipes[k] connects stage k to stage k + 1, at the path its temp file
+        // would have had so the extension still carries the format
+        std::vector<std::filesystem::path> pipes;
+        for (size_t k = 0; k + 1 < count; ++k)
+        {
+            const auto &node = graph.node(chain[k]);
+            auto path = generate_temp_path(node.resolved_extension, node.stage_idx, node.element_idx);
+            if (!utils::create_fifo(path))
+            {
+                // No named pipes here; fall back to temp files stage by stage
+                std::error_code ec;
+                for (const auto &p : pipes)
+                    std::filesystem::remove(p, ec);
+                auto &head = graph.node(chain.front());
+                return execute_conversion_node(head, graph, pipeline, output,
+                                              numbers.front(), total_nodes, result);
+            }
+            pipes.push_back(path);
+        }
+
+        std::vector<Request> requests(count);
+        std::vector<ResourceClaim> claims;
+        for (size_t k = 0; k < count; ++k)
+        {
+            auto &node = graph.node(chain[k]);
+            node.input = k == 0 ? get_node_input(node, graph) : pipes[k - 1];
+            claims.push_back(resource_claim(node, pipeline, node.input));
+
+            auto &request = requests[k];
+            request.source = node.input;
+            request.target = node.target;
+            request.plugin = node.plugin;
+            request.core_options = pipeline.core_options;
+            request.plugin_options = node.plugin_options;
+            if (k + 1 < count)
+            {
+                // The pipe already exists at the output path
+                request.core_options.output = pipes[k];
+                request.core_options.force = true;
+            }
+            else if (!node.is_sink)
+            {
+                node.temp_output = generate_temp_path(
+                    node.resolved_extension, node.stage_idx, node.element_idx);
+                request.core_options.output = node.temp_output;
+            }
+
+            if (is_temp_path(node.input))
+            {
+                std::string ext = node.input.extension().string();
+                if (!ext.empty() && ext[0] == '.')
+                    ext = ext.substr(1);
+                if (!ext.empty())
+                    request.input_format = ext;
+            }
+            if (!request.input_format.has_value() && node.stage_idx == 0 &&
+                pipeline.input_format.has_value())
+            {
+                request.input_format = pipeline.input_format;
+            }
+
+        }
+
+        // Every stage of the chain runs at once, so all are admitted together
+        auto lease = scheduler_->acquire(std::move(claims));
+        for (size_t k = 0; k < count; ++k)
+        {
+            report_stage_started(output, numbers[k], total_nodes, graph.node(chain[k]).target);
+        }
+
+        std::vector<Result> stage_results(count);
+        std::vector<int64_t> durations(count, 0);
+        std::vector<size_t> finish_order(count, 0);
+        std::vector<std::atomic<bool>> done(count);
+        std::atomic<size_t> finished{0};
+        auto chain_start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (size_t k = 0; k < count; ++k)
+        {
+            threads.emplace_back([&, k]()
+                                 {
+                try
+                {
+                    stage_results[k] = engine_->execute(requests[k]);
+                }
+                catch (const std::exception &e)
+                {
+                    stage_results[k] = Result::failure(requests[k].target, requests[k].source, e.what());
+                }
+                durations[k] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - chain_start).count();
+                finish_order[k] = finished.fetch_add(1);
+                done[k].store(true); });
+        }
+
+        // A stage that exits without opening its end of a pipe would leave
+        // its neighbour blocked in open() forever. Until both ends are done,
+        // briefly open the missing end: a waiting reader then sees EOF and a
+        // waiting writer gets EPIPE once nobody reads.
+        auto all_done = [&]()
+        {
+            return std::all_of(done.begin(), done.end(),
+                               [](const std::atomic<bool> &d) { return d.load(); });
+        };
+        while (!all_done())
+        {
+#ifndef _WIN32
+            for (size_t k = 0; k + 1 < count; ++k)
+            {
+                bool writer_done = done[k].load();
+                bool reader_done = done[k + 1].load();
+                if (writer_done == reader_done)
+                    continue;
+
+                int flags = (writer_done ? O_WRONLY : O_RDONLY) | O_NONBLOCK | O_CLOEXEC;
+                int fd = ::open(pipes[k].c_str(), flags);
+                if (fd >= 0)
+                    ::close(fd);
+            }
+#endif
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        for (auto &t : threads)
+        {
+            t.join();
+        }
+        lease.release();
+
+        std::error_code ec;
+        for (const auto &p : pipes)
+        {
+            std::filesystem::remove(p, ec);
+        }
+
+        // A failure usually makes its neighbours fail too (EOF, EPIPE);
+        // the stage that failed first is the one to report
+        std::optional<size_t> root_failure;
+        for (size_t k = 0; k < count; ++k)
+        {
+            auto &stage = stage_results[k];
+            if (stage.status == ResultStatus::Success && k + 1 < count)
+            {
+                if (stage.is_scatter())
+                {
+                    stage = Result::failure(stage.target, requests[k].source,
+                                            "Streaming stage returned multiple outputs");
+                }
+                else if (stage.output && *stage.output != pipes[k])
+                {
+                    stage = Result::failure(stage.target, requests[k].source,
+                                            "Streaming stage wrote " + stage.output->string() +
+                                                " instead of its output pipe");
+                }
+            }
+            if (stage.status != ResultStatus::Success &&
+                (!root_failure || finish_order[k] < finish_order[*root_failure]))
+            {
+                root_failure = k;
+            }
+        }
+
+        for (size_t k = 0; k < count; ++k)
+        {
+            auto &node = graph.node(chain[k]);
+            const auto &stage = stage_results[k];
+            bool success = stage.status == ResultStatus::Success;
+            std::string error_msg = stage.error.value_or("");
+
+            report_stage_completed(output, numbers[k], total_nodes, node.target,
+                                   durations[k], success, error_msg);
+
+            std::filesystem::path actual_output;
+            if (k + 1 < count)
+                actual_output = pipes[k];
+            else if (node.is_sink)
+                actual_output = stage.output.value_or("");
+            else
+                actual_output = stage.output.value_or(node.temp_output);
+
+            node.temp_output = actual_output;
+            node.plugin_used = stage.plugin_used;
+            node.executed = true;
+            node.duration_ms = durations[k];
+
             StageResult stage_result;
             stage_result.stage_index = node.stage_idx;
             stage_result.target = node.target;
-            stage_result.plugin_used = etl_result.plugin_used;
-            stage_result.input = scattered_input;
+            stage_result.plugin_used = stage.plugin_used;
+            stage_result.input = node.input;
             stage_result.output = actual_output;
-            stage_result.status = etl_result.status;
-            stage_result.error = etl_result.error;
-            stage_result.duration_ms = duration;
-            result.stage_results.push_back(stage_result);
+            stage_result.status = stage.status;
+            stage_result.error = stage.error;
+            stage_result.duration_ms = durations[k];
+            add_stage_result(result, stage_result);
 
             if (!success)
             {
                 node.status = ResultStatus::Error;
                 node.error = error_msg.empty() ? "Unknown error" : error_msg;
-                result.error = node.error;
-                return false;
+                continue;
             }
+            node.status = ResultStatus::Success;
 
-            new_scattered_paths.push_back(actual_output);
+            if (k + 1 == count)
+            {
+                if (node.is_sink)
+                {
+                    node.final_output = actual_output;
+                    if (!actual_output.empty())
+                        add_final_output(result, actual_output);
+                }
+                else if (stage.is_scatter())
+                {
+                    node.scatter_outputs = stage.outputs;
+                }
+            }
         }
 
-        // Sink node: record all plugin outputs as final (skip finalization)
-        if (node.is_sink)
+        if (root_failure)
         {
-            for (const auto &p : new_scattered_paths)
-            {
-                if (!p.empty())
-                    result.final_outputs.push_back(p);
-            }
-            node.plugin_used = "";
-            node.executed = true;
-            node.status = ResultStatus::Success;
-            return true;
+            result.error = graph.node(chain[*root_failure]).error;
+            return false;
         }
+        return true;
+    }
 
-        // Update scattered paths for next stage
-        scattered_paths_ = new_scattered_paths;
-        node.scatter_outputs = new_scattered_paths;
+    StageResult PipelineExecutor::execute_scatter_item(
+        const ExecutionNode &node,
+        const Pipeline &pipeline,
+        const std::shared_ptr<output::IOutput> &output,
+        size_t current_node,
+        size_t total_nodes,
+        const std::filesystem::path &scattered_input,
+        size_t index,
+        size_t count)
+    {
+        std::string label = node.target + " [" + std::to_string(index + 1) + "/" +
+                            std::to_string(count) + "]";
 
-        // Use the first output as the node's temp_output for graph connectivity
-        if (!new_scattered_paths.empty())
+        auto lease = scheduler_->acquire(resource_claim(node, pipeline, scattered_input));
+
+        // Report progress
+        report_stage_started(output, current_node, total_nodes, label,
+                             expected_duration_ms(node, pipeline, scattered_input));
+
+        auto scatter_start = std::chrono::steady_clock::now();
+
+        // Generate a unique temp path for this scatter index (skip for sink)
+        std::filesystem::path temp_output;
+        if (!node.is_sink)
+        {
+            temp_output = generate_scatter_temp_path(
+                node.resolved_extension, node.stage_idx, node.element_idx, index,
+                expected_output_size(node, pipeline, scattered_input));
+        }
+
+        // Build request
+        Request request;
+        request.source = scattered_input;
+        request.target = node.target;
+        request.plugin = node.plugin;
+        request.core_options = pipeline.core_options;
+        if (!node.is_sink)
+        {
+            request.core_options.output = temp_output;
+        }
+        request.plugin_options = node.plugin_options;
+
+        // Format hint for temp files
+        if (is_temp_path(scattered_input))
+        {
+            std::string ext = scattered_input.extension().string();
+            if (!ext.empty() && ext[0] == '.')
+                ext = ext.substr(1);
+            if (!ext.empty())
+                request.input_format = ext;
+        }
+
+        // Execute through engine
+        Result etl_result;
+        try
+        {
+            etl_result = engine_->execute(request);
+        }
+        catch (const std::exception &e)
+        {
+            etl_result = Result::failure(node.target, scattered_input, e.what());
+        }
+        lease.release();
+
+        auto scatter_end = std::chrono::steady_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            scatter_end - scatter_start).count();
+
+        std::filesystem::path actual_output;
+        if (node.is_sink)
+        {
+            actual_output = etl_result.output.value_or("");
+        }
+        else
         {
-            node.temp_output = new_scattered_paths[0];
+            actual_output = etl_result.output.value_or(temp_output);
         }
 
-        node.plugin_used = ""; // Multiple executions, no single plugin
-        node.executed = true;
-        node.status = ResultStatus::Success;
-        return true;
+        bool success = (etl_result.status == ResultStatus::Success);
+        std::string error_msg = etl_result.error.value_or("");
+
+        report_stage_completed(output, current_node, total_nodes, label,
+                               duration, success, error_msg);
+
+        // Record stage result for this scatter execution
+        StageResult stage_result;
+        stage_result.stage_index = node.stage_idx;
+        stage_result.target = node.target;
+        stage_result.plugin_used = etl_result.plugin_used;
+        stage_result.input = scattered_input;
+        stage_result.output = actual_output;
+        stage_result.status = etl_result.status;
+        stage_result.error = etl_result.error;
+        stage_result.duration_ms = duration;
+        stage_result.item_index = index;
+        return stage_result;
+    }
+
+    size_t PipelineExecutor::scatter_width(const CoreOptions &options)
+    {
+        // --scatter-jobs falls back to --jobs when not given
+        int requested = options.scatter_jobs >= 0 ? options.scatter_jobs : options.jobs;
+        return ThreadPool::resolve_worker_count(static_cast<size_t>(std::max(requested, 0)));
     }
 
     bool PipelineExecutor::finalize_outputs(
@@ -799,6 +1819,8 @@ namespace uniconv::core
                     }
 
                     std::filesystem::path final_path = output_dir / filename;
+                    if (output_reserver_)
+                        output_reserver_(final_path);
 
                     try
                     {
@@ -807,21 +1829,27 @@ namespace uniconv::core
                             if (pipeline.core_options.force)
                                 std::filesystem::remove(final_path);
                         }
+                        TraceSpan span("rename", "finalize");
+                        if (span.active())
+                            span.arg("output", final_path.string());
                         std::filesystem::rename(scatter_out, final_path);
-                        result.final_outputs.push_back(final_path);
+                        add_final_output(result, final_path);
                     }
                     catch (const std::filesystem::filesystem_error &)
                     {
-                        try
+                        // Across filesystems: link, clone or copy, then drop the temp file
+                        TraceSpan span("transfer", "finalize");
+                        if (span.active())
+                            span.arg("output", final_path.string());
+                        if (utils::transfer_file(scatter_out, final_path))
                         {
-                            std::filesystem::copy_file(scatter_out, final_path,
-                                std::filesystem::copy_options::overwrite_existing);
-                            std::filesystem::remove(scatter_out);
-                            result.final_outputs.push_back(final_path);
+                            std::error_code ec;
+                            std::filesystem::remove(scatter_out, ec);
+                            add_final_output(result, final_path);
                         }
-                        catch (const std::filesystem::filesystem_error &)
+                        else
                         {
-                            result.final_outputs.push_back(scatter_out);
+                            add_final_output(result, scatter_out);
                         }
                     }
                 }
@@ -874,6 +1902,9 @@ namespace uniconv::core
                 continue;
             }
 
+            if (output_reserver_)
+                output_reserver_(final_path);
+
             // Move temp file to final location
             try
             {
@@ -893,7 +1924,12 @@ namespace uniconv::core
                     // If not force, rename will fail - let it happen naturally
                 }
 
-                std::filesystem::rename(node.temp_output, final_path);
+                {
+                    TraceSpan span("rename", "finalize");
+                    if (span.active())
+                        span.arg("output", final_path.string());
+                    std::filesystem::rename(node.temp_output, final_path);
+                }
                 node.final_output = final_path;
 
                 // Update the stage result with final path
@@ -908,7 +1944,7 @@ namespace uniconv::core
                     }
                 }
 
-                result.final_outputs.push_back(final_path);
+                add_final_output(result, final_path);
 
                 // For non-content-copyable formats consumed by clipboard,
                 // copy the final path to clipboard (not the temp path)
@@ -919,11 +1955,17 @@ namespace uniconv::core
             }
             catch (const std::filesystem::filesystem_error &e)
             {
-                // If rename fails, try copy + delete
+                // If rename fails (e.g. across filesystems), link, clone or
+                // copy, then delete
                 try
                 {
-                    std::filesystem::copy_file(node.temp_output, final_path,
-                                               std::filesystem::copy_options::overwrite_existing);
+                    TraceSpan span("transfer", "finalize");
+                    if (span.active())
+                        span.arg("output", final_path.string());
+                    if (!utils::transfer_file(node.temp_output, final_path))
+                    {
+                        throw e;
+                    }
                     std::filesystem::remove(node.temp_output);
                     node.final_output = final_path;
 
@@ -938,7 +1980,7 @@ namespace uniconv::core
                         }
                     }
 
-                    result.final_outputs.push_back(final_path);
+                    add_final_output(result, final_path);
 
                     // For non-content-copyable formats consumed by clipboard,
                     // copy the final path to clipboard (not the temp path)
@@ -951,7 +1993,7 @@ namespace uniconv::core
                 {
                     // Keep temp file, add to outputs
                     node.final_output = node.temp_output;
-                    result.final_outputs.push_back(node.temp_output);
+                    add_final_output(result, node.temp_output);
                 }
             }
         }
@@ -981,6 +2023,253 @@ namespace uniconv::core
         return graph.source();
     }
 
+    std::vector<std::filesystem::path> PipelineExecutor::scatter_inputs(
+        const ExecutionNode &node,
+        const ExecutionGraph &graph) const
+    {
+        if (node.input_nodes.empty())
+        {
+            return {};
+        }
+
+        const auto *pred = &graph.node(node.input_nodes[0]);
+        while (true)
+        {
+            // Collect reduces the width back to 1
+            if (pred->is_collect)
+            {
+                return {};
+            }
+
+            if (!pred->scatter_outputs.empty())
+            {
+                return pred->scatter_outputs;
+            }
+
+            // tee, passthrough and clipboard forward their input unchanged
+            bool forwards_input = pred->is_tee || pred->is_passthrough || pred->is_clipboard;
+            if (!forwards_input || pred->input_nodes.empty())
+            {
+                return {};
+            }
+            pred = &graph.node(pred->input_nodes[0]);
+        }
+    }
+
+    std::vector<size_t> PipelineExecutor::pipelined_chain(
+        const ExecutionNode &node,
+        const ExecutionGraph &graph) const
+    {
+        // Follow single-consumer conversion edges; anything else (tee,
+        // collect, clipboard, fan-out, per-node output) ends the chain
+        std::vector<size_t> chain{node.id};
+        const auto *current = &node;
+        while (current->output_nodes.size() == 1 &&
+               current->options.find("output") == current->options.end())
+        {
+            const auto &next = graph.node(current->output_nodes[0]);
+            if (next.is_builtin() || next.input_nodes.size() != 1)
+            {
+                break;
+            }
+            chain.push_back(next.id);
+            current = &next;
+        }
+        return chain;
+    }
+
+    std::vector<size_t> PipelineExecutor::streamed_chain(
+        const ExecutionNode &node,
+        const ExecutionGraph &graph)
+    {
+        std::vector<size_t> chain{node.id};
+#ifndef _WIN32
+        // Candidates share the single-consumer shape of a pipelined chain
+        auto candidates = pipelined_chain(node, graph);
+        std::string input_format = utils::detect_format(get_node_input(node, graph));
+
+        for (size_t k = 0; k + 1 < candidates.size(); ++k)
+        {
+            const auto &producer = graph.node(candidates[k]);
+            const auto &consumer = graph.node(candidates[k + 1]);
+
+            // Only subprocesses: a plugin inside uniconv writing to a pipe
+            // whose reader has gone would raise SIGPIPE in our own process
+            auto *from = resolve_node_plugin(producer, input_format);
+            if (!dynamic_cast<CLIPlugin *>(from) || !from->info().streams_output() ||
+                from->info().sink)
+            {
+                break;
+            }
+
+            input_format = utils::detect_format(generate_temp_path(
+                producer.prepared ? producer.resolved_extension : resolve_extension(producer),
+                producer.stage_idx, producer.element_idx));
+            auto *to = resolve_node_plugin(consumer, input_format);
+            if (!dynamic_cast<CLIPlugin *>(to) || !to->info().streams_input())
+            {
+                break;
+            }
+            chain.push_back(consumer.id);
+        }
+#else
+        (void)graph;
+#endif
+        return chain;
+    }
+
+    bool PipelineExecutor::keeps_output_in_memory(
+        const ExecutionNode &node,
+        const ExecutionGraph &graph)
+    {
+        // Same single-consumer shape as a pipelined chain
+        auto chain = pipelined_chain(node, graph);
+        if (chain.size() < 2)
+        {
+            return false;
+        }
+
+        auto *from = resolve_node_plugin(node, utils::detect_format(node.input));
+        if (!from || !from->supports_buffers() || from->info().sink)
+        {
+            return false;
+        }
+
+        const auto &consumer = graph.node(chain[1]);
+        auto *to = resolve_node_plugin(consumer, utils::detect_format(node.temp_output));
+        return to && to->supports_buffers();
+    }
+
+    plugins::IPlugin *PipelineExecutor::resolve_node_plugin(
+        const ExecutionNode &node,
+        const std::string &input_format)
+    {
+        // Mirrors the context Engine::execute resolves with
+        ResolutionContext ctx;
+        ctx.input_format = input_format;
+        ctx.target = node.target;
+        ctx.explicit_plugin = node.plugin;
+        ctx.input_types = utils::detect_input_types(input_format);
+        return engine_->plugin_manager().find_plugin(ctx);
+    }
+
+    size_t PipelineExecutor::conversion_number(
+        const ExecutionGraph &graph,
+        size_t node_id) const
+    {
+        // 1-based position among conversion nodes in serial execution order
+        size_t number = 0;
+        for (size_t id : graph.execution_order())
+        {
+            if (graph.node(id).is_builtin())
+                continue;
+            ++number;
+            if (id == node_id)
+                break;
+        }
+        return number;
+    }
+
+    void PipelineExecutor::report_stage_started(
+        const std::shared_ptr<output::IOutput> &output,
+        size_t current, size_t total, const std::string &target,
+        int64_t estimate_ms)
+    {
+        if (!output)
+            return;
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (estimate_ms >= 0)
+            output->stage_started_with_estimate(current, total, target, estimate_ms);
+        else
+            output->stage_started(current, total, target);
+    }
+
+    int64_t PipelineExecutor::expected_duration_ms(const ExecutionNode &node,
+                                                   const Pipeline &pipeline,
+                                                   const std::filesystem::path &input,
+                                                   const Buffer *input_data)
+    {
+        if (!engine_->stats())
+            return -1;
+        auto size = input_size(input, input_data);
+        if (size == UINTMAX_MAX)
+            return -1;
+        auto format = utils::detect_format(input);
+        if (format.empty() && node.stage_idx == 0)
+            format = pipeline.input_format.value_or("");
+        auto cost = engine_->estimate(node.target, format, node.plugin, size);
+        return cost ? cost->duration_ms : -1;
+    }
+
+    ResourceClaim PipelineExecutor::resource_claim(const ExecutionNode &node,
+                                                   const Pipeline &pipeline,
+                                                   const std::filesystem::path &input,
+                                                   const Buffer *input_data)
+    {
+        ResourceClaim claim;
+        auto format = utils::detect_format(input);
+        if (format.empty() && node.stage_idx == 0)
+            format = pipeline.input_format.value_or("");
+        auto *plugin = resolve_node_plugin(node, format);
+        if (!plugin)
+            return claim;
+
+        auto info = plugin->info();
+        claim.plugin = info.scope;
+        claim.threads = static_cast<unsigned>(std::max(info.resources.threads, 1));
+        claim.exclusive = info.resources.exclusive;
+        claim.memory = info.resources.memory_mb * 1024 * 1024;
+        if (claim.memory == 0 && engine_->stats())
+        {
+            auto size = input_size(input, input_data);
+            if (size != UINTMAX_MAX)
+            {
+                if (auto cost = engine_->estimate(node.target, format, node.plugin, size))
+                    claim.memory = cost->peak_rss_kb * 1024;
+            }
+        }
+        return claim;
+    }
+
+    void PipelineExecutor::add_stage_result(PipelineResult &result, const StageResult &stage)
+    {
+        ++result.stage_count;
+        if (stage.status != ResultStatus::Success)
+        {
+            ++result.failed_stage_count;
+        }
+        if (!result_stream_)
+        {
+            result.stage_results.push_back(stage);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        result_stream_->stage_result(stage.to_json());
+    }
+
+    void PipelineExecutor::add_final_output(PipelineResult &result, const std::filesystem::path &path)
+    {
+        ++result.output_count;
+        if (!result_stream_)
+        {
+            result.final_outputs.push_back(path);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        result_stream_->output_ready(path.string());
+    }
+
+    void PipelineExecutor::report_stage_completed(
+        const std::shared_ptr<output::IOutput> &output,
+        size_t current, size_t total, const std::string &target,
+        int64_t duration_ms, bool success, const std::string &error)
+    {
+        if (!output)
+            return;
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        output->stage_completed(current, total, target, duration_ms, success, error);
+    }
+
     static std::string target_to_extension(const std::string &target)
     {
         // Compound archive targets use hyphens (tar-gz) but the file
@@ -1002,7 +2291,8 @@ namespace uniconv::core
     std::filesystem::path PipelineExecutor::generate_temp_path(
         const std::string &target,
         size_t stage_index,
-        size_t element_index)
+        size_t element_index,
+        uintmax_t expected_size)
     {
         // Format: run_dir / "s{idx}_e{idx}.{ext}"
         std::ostringstream filename;
@@ -1010,14 +2300,15 @@ namespace uniconv::core
                  << "_e" << element_index
                  << "." << target_to_extension(target);
 
-        return temp_dir_ / filename.str();
+        return scratch_dir_for(expected_size) / filename.str();
     }
 
     std::filesystem::path PipelineExecutor::generate_scatter_temp_path(
         const std::string &target,
         size_t stage_index,
         size_t element_index,
-        size_t scatter_index)
+        size_t scatter_index,
+        uintmax_t expected_size)
     {
         // Format: run_dir / "s{idx}_e{idx}_i{scatter_idx}.{ext}"
         std::ostringstream filename;
@@ -1026,7 +2317,57 @@ namespace uniconv::core
                  << "_i" << scatter_index
                  << "." << target_to_extension(target);
 
-        return temp_dir_ / filename.str();
+        return scratch_dir_for(expected_size) / filename.str();
+    }
+
+    const std::filesystem::path &PipelineExecutor::scratch_dir_for(uintmax_t expected_size) const
+    {
+        if (ram_temp_dir_.empty() || expected_size > ram_threshold_)
+        {
+            return temp_dir_;
+        }
+
+        // Leave a threshold's worth of headroom so concurrent stages can't
+        // fill the RAM filesystem between this check and the write
+        std::error_code ec;
+        auto space = std::filesystem::space(ram_temp_dir_, ec);
+        if (ec || space.available < expected_size + ram_threshold_)
+        {
+            return temp_dir_;
+        }
+        return ram_temp_dir_;
+    }
+
+    uintmax_t PipelineExecutor::expected_output_size(const ExecutionNode &node,
+                                                     const Pipeline &pipeline,
+                                                     const std::filesystem::path &input,
+                                                     const Buffer *input_data)
+    {
+        // Only RAM tier placement reads it; skip the lookup without one
+        auto size = input_size(input, input_data);
+        if (size == UINTMAX_MAX || ram_temp_dir_.empty() || !engine_->stats())
+            return size;
+        auto format = utils::detect_format(input);
+        if (format.empty() && node.stage_idx == 0)
+            format = pipeline.input_format.value_or("");
+        auto cost = engine_->estimate(node.target, format, node.plugin, size);
+        return cost ? cost->bytes_out : size;
+    }
+
+    uintmax_t PipelineExecutor::input_size(const std::filesystem::path &input,
+                                           const Buffer *input_data)
+    {
+        if (input_data)
+        {
+            return input_data->size();
+        }
+        std::error_code ec;
+        if (input.empty() || !std::filesystem::is_regular_file(input, ec))
+        {
+            return UINTMAX_MAX;
+        }
+        auto size = std::filesystem::file_size(input, ec);
+        return ec ? UINTMAX_MAX : size;
     }
 
     std::filesystem::path PipelineExecutor::generate_final_output_path(
@@ -1101,30 +2442,269 @@ namespace uniconv::core
 
     bool PipelineExecutor::is_temp_path(const std::filesystem::path &path) const
     {
-        // Check if path is inside our per-run temp directory
+        // Check if path is inside one of our per-run temp directories
         auto path_str = path.string();
-        auto dir_str = temp_dir_.string();
-        return path_str.size() > dir_str.size() &&
-               path_str.compare(0, dir_str.size(), dir_str) == 0;
+        auto inside = [&path_str](const std::filesystem::path &dir)
+        {
+            auto dir_str = dir.string();
+            return !dir_str.empty() && path_str.size() > dir_str.size() &&
+                   path_str.compare(0, dir_str.size(), dir_str) == 0;
+        };
+        return inside(temp_dir_) || inside(ram_temp_dir_);
     }
 
     void PipelineExecutor::cleanup_temp_files()
     {
-        // Remove the entire per-run temp directory
-        try
+        TraceSpan span("temp_cleanup", "pipeline");
+        // Remove the per-run temp directories
+        for (const auto *dir : {&temp_dir_, &ram_temp_dir_})
+        {
+            try
+            {
+                if (!dir->empty() && std::filesystem::exists(*dir))
+                {
+                    std::filesystem::remove_all(*dir);
+                }
+            }
+            catch (const std::filesystem::filesystem_error &)
+            {
+                // Ignore cleanup errors
+            }
+        }
+    }
+
+    void PipelineExecutor::plan_temp_release(const ExecutionGraph &graph, const Pipeline &pipeline)
+    {
+        const size_t node_count = graph.nodes().size();
+        temp_readers_.assign(node_count, 0);
+        temp_feeds_.assign(node_count, {});
+        temp_retained_.assign(node_count, 0);
+        temp_sizes_.clear();
+        temp_bytes_ = 0;
+        temp_reserved_ = 0;
+        temp_items_ = 0;
+        temp_budget_ = pipeline.core_options.dry_run ? 0 : pipeline.core_options.temp_budget;
+
+        for (const auto &producer : graph.nodes())
+        {
+            if (!producer.has_file_output() && !producer.is_collect)
+            {
+                continue;
+            }
+
+            // Outputs finalize_outputs moves into place
+            auto output_it = producer.options.find("output");
+            if (producer.has_file_output() &&
+                (graph.is_effectively_terminal(producer.id) ||
+                 graph.is_effectively_only_consumed_by_clipboard(producer.id) ||
+                 (output_it != producer.options.end() && !output_it->second.empty())))
+            {
+                temp_retained_[producer.id] = 1;
+            }
+
+            // Tee, passthrough and clipboard hand the same file on to their
+            // consumers; clipboard also reads it itself
+            std::vector<size_t> pending(producer.output_nodes.begin(), producer.output_nodes.end());
+            std::vector<char> seen(node_count, 0);
+            while (!pending.empty())
+            {
+                size_t reader_id = pending.back();
+                pending.pop_back();
+                if (seen[reader_id])
+                {
+                    continue;
+                }
+                seen[reader_id] = 1;
+
+                const auto &reader = graph.node(reader_id);
+                if (reader.is_tee || reader.is_passthrough || reader.is_clipboard)
+                {
+                    pending.insert(pending.end(), reader.output_nodes.begin(), reader.output_nodes.end());
+                    if (!reader.is_clipboard)
+                    {
+                        continue;
+                    }
+                }
+                ++temp_readers_[producer.id];
+                temp_feeds_[reader_id].push_back(producer.id);
+            }
+        }
+    }
+
+    void PipelineExecutor::release_temp_inputs(size_t node_id, const ExecutionGraph &graph)
+    {
+        const auto &node = graph.node(node_id);
+        if (temp_budget_ > 0 && (node.has_file_output() || node.is_collect))
+        {
+            for (const auto &path : temp_outputs_of(node))
+            {
+                track_temp_output(path);
+            }
+        }
+
+        std::vector<std::filesystem::path> released;
+        {
+            std::lock_guard<std::mutex> lock(temp_mutex_);
+            if (node_id >= temp_feeds_.size())
+            {
+                return;
+            }
+            for (size_t producer_id : temp_feeds_[node_id])
+            {
+                if (--temp_readers_[producer_id] == 0 && !temp_retained_[producer_id])
+                {
+                    auto paths = temp_outputs_of(graph.node(producer_id));
+                    released.insert(released.end(), paths.begin(), paths.end());
+                }
+            }
+        }
+
+        for (const auto &path : released)
+        {
+            remove_temp_output(path);
+        }
+    }
+
+    bool PipelineExecutor::consumes_scatter_inputs(const ExecutionNode &node)
+    {
+        std::lock_guard<std::mutex> lock(temp_mutex_);
+        if (node.id >= temp_feeds_.size() || temp_feeds_[node.id].empty())
+        {
+            return false;
+        }
+        for (size_t producer_id : temp_feeds_[node.id])
+        {
+            if (temp_readers_[producer_id] != 1 || temp_retained_[producer_id])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::filesystem::path> PipelineExecutor::temp_outputs_of(const ExecutionNode &node) const
+    {
+        std::vector<std::filesystem::path> paths;
+        for (const auto &path : node.scatter_outputs)
+        {
+            if (is_temp_path(path))
+            {
+                paths.push_back(path);
+            }
+        }
+        if (is_temp_path(node.temp_output) &&
+            std::find(paths.begin(), paths.end(), node.temp_output) == paths.end())
+        {
+            paths.push_back(node.temp_output);
+        }
+        return paths;
+    }
+
+    void PipelineExecutor::track_temp_output(const std::filesystem::path &path)
+    {
+        if (temp_budget_ == 0 || path.empty())
+        {
+            return;
+        }
+        uintmax_t size = utils::regular_file_size(path);
+        std::lock_guard<std::mutex> lock(temp_mutex_);
+        if (temp_sizes_.emplace(path, size).second)
+        {
+            temp_bytes_ += size;
+        }
+    }
+
+    void PipelineExecutor::remove_temp_output(const std::filesystem::path &path)
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+
+        if (temp_budget_ == 0)
+        {
+            return;
+        }
         {
-            if (std::filesystem::exists(temp_dir_))
+            std::lock_guard<std::mutex> lock(temp_mutex_);
+            auto it = temp_sizes_.find(path);
+            if (it == temp_sizes_.end())
             {
-                std::filesystem::remove_all(temp_dir_);
+                return;
             }
+            temp_bytes_ -= it->second;
+            temp_sizes_.erase(it);
+        }
+        temp_cv_.notify_all();
+    }
+
+    uintmax_t PipelineExecutor::reserve_temp(uintmax_t estimate)
+    {
+        if (temp_budget_ == 0)
+        {
+            return 0;
+        }
+        std::unique_lock<std::mutex> lock(temp_mutex_);
+        temp_cv_.wait(lock, [&]()
+                      { return temp_items_ == 0 ||
+                               temp_bytes_ + temp_reserved_ + estimate <= temp_budget_; });
+        temp_reserved_ += estimate;
+        ++temp_items_;
+        return estimate;
+    }
+
+    void PipelineExecutor::settle_temp(uintmax_t reservation, const std::filesystem::path &output)
+    {
+        if (temp_budget_ == 0)
+        {
+            return;
+        }
+        track_temp_output(output);
+        {
+            std::lock_guard<std::mutex> lock(temp_mutex_);
+            temp_reserved_ -= reservation;
+            --temp_items_;
+        }
+        temp_cv_.notify_all();
+    }
+
+    std::optional<std::string> PipelineExecutor::prepare_node(ExecutionNode &node)
+    {
+        if (node.prepared)
+        {
+            return std::nullopt;
+        }
+        node.prepared = true;
+
+        auto *resolved_plugin = engine_->plugin_manager().find_plugin(node.target, node.plugin);
+        if (!resolved_plugin)
+        {
+            // The engine reports the missing plugin when the node runs
+            node.resolved_extension = resolve_extension(node, std::nullopt);
+            return std::nullopt;
         }
-        catch (const std::filesystem::filesystem_error &)
+
+        auto info = resolved_plugin->info();
+        node.resolved_extension = resolve_extension(node, info);
+        node.is_sink = info.sink;
+        auto err = validate_required_options(info.options, node.options, node.target);
+        if (!err.empty())
         {
-            // Ignore cleanup errors
+            return err;
         }
+        return std::nullopt;
     }
 
     std::string PipelineExecutor::resolve_extension(const ExecutionNode &node)
+    {
+        if (node.extension.has_value() && !node.extension->empty())
+        {
+            return *node.extension;
+        }
+        auto *plugin = engine_->plugin_manager().find_plugin(node.target, node.plugin);
+        return resolve_extension(node, plugin ? std::optional<PluginInfo>(plugin->info()) : std::nullopt);
+    }
+
+    std::string PipelineExecutor::resolve_extension(const ExecutionNode &node,
+                                                    const std::optional<PluginInfo> &plugin_info)
     {
         // 1. Explicit extension from user → use as-is
         if (node.extension.has_value() && !node.extension->empty())
@@ -1133,12 +2713,10 @@ namespace uniconv::core
         }
 
         // 2. Look up target in plugin's targets map → use first entry (default)
-        auto *plugin = engine_->plugin_manager().find_plugin(node.target, node.plugin);
-        if (plugin)
+        if (plugin_info)
         {
-            auto plugin_info = plugin->info();
-            auto it = plugin_info.targets.find(node.target);
-            if (it != plugin_info.targets.end() && !it->second.empty())
+            auto it = plugin_info->targets.find(node.target);
+            if (it != plugin_info->targets.end() && !it->second.empty())
             {
                 return it->second[0]; // First extension is the default
             }
@@ -4,7 +4,17 @@
 #include "execution_graph.h"
 #include "engine.h"
 #include "output/output.h"
+#include "prepared_pipeline.h"
+#include "resource_scheduler.h"
+#include "scratch_policy.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace uniconv::core
 {
@@ -12,28 +22,87 @@ namespace uniconv::core
     class PipelineExecutor
     {
     public:
-        explicit PipelineExecutor(std::shared_ptr<Engine> engine);
+        explicit PipelineExecutor(std::shared_ptr<Engine> engine,
+                                  const ScratchPolicy &scratch = ScratchPolicy::defaults());
 
         // Execute a complete pipeline
         PipelineResult execute(const Pipeline &pipeline,
                                const std::shared_ptr<output::IOutput> &output = nullptr);
 
+        // Resolve and check a pipeline once for running it on many inputs
+        // (see PreparedPipeline); fails on a stage no plugin can run, a
+        // missing required option or plugins that cannot connect
+        PrepareResult prepare(const Pipeline &pipeline);
+
+        // Execute a prepared pipeline on source, writing to output_path
+        // instead of the prototype's output when given. An executor runs
+        // one pipeline at a time but can be reused for the next input.
+        PipelineResult execute(const PreparedPipeline &prepared,
+                               const std::filesystem::path &source,
+                               const std::shared_ptr<output::IOutput> &output = nullptr,
+                               const std::optional<std::filesystem::path> &output_path = std::nullopt);
+
+        // Expected cost of each conversion stage from the engine's performance
+        // history, without running anything (--explain). Sizes and formats are
+        // propagated from the source through the graph.
+        PipelineEstimate explain(const Pipeline &pipeline);
+
+        // Admit conversions through a shared scheduler, so several executors
+        // (watch workers) stay within one budget. Without one, each run gets
+        // its own with ResourceBudget::defaults().
+        void set_scheduler(std::shared_ptr<ResourceScheduler> scheduler) { scheduler_ = std::move(scheduler); }
+
+        // Called with each final output path just before the file is moved
+        // there, so a caller walking the output directory (--batch) can
+        // know the file before it becomes visible
+        using OutputReserver = std::function<void(const std::filesystem::path &)>;
+        void set_output_reserver(OutputReserver reserver) { output_reserver_ = std::move(reserver); }
+
     private:
         std::shared_ptr<Engine> engine_;
-        std::filesystem::path temp_dir_;
+        std::shared_ptr<ResourceScheduler> scheduler_;
+        OutputReserver output_reserver_;
+        std::filesystem::path temp_dir_;     // Per-run directory under the disk scratch root
+        std::filesystem::path ram_temp_dir_; // Per-run RAM-backed directory; empty if unavailable
+        uintmax_t ram_threshold_ = 0;
+
+        // Serializes progress reporting when nodes run on worker threads
+        std::mutex output_mutex_;
+
+        // Set for the run when the output streams results (--json-stream)
+        std::shared_ptr<output::IOutput> result_stream_;
 
-        // Scatter/collect pipeline width tracking
-        // When a plugin returns "outputs" (scatter), width increases from 1 to N.
-        // Subsequent stages execute N times (once per scattered output).
-        // "collect" reduces width back to 1.
-        size_t pipeline_width_ = 1;
+        // Eager intermediate cleanup: a producer's temp outputs are deleted as
+        // soon as every node reading them has run, unless they become final
+        // outputs. --temp-budget bounds the intermediate bytes on disk.
+        std::mutex temp_mutex_;
+        std::condition_variable temp_cv_;
+        std::vector<size_t> temp_readers_;                      // Readers still to run, per producer
+        std::vector<std::vector<size_t>> temp_feeds_;           // Producers each node reads from
+        std::vector<char> temp_retained_;                       // Producer output is finalized
+        std::map<std::filesystem::path, uintmax_t> temp_sizes_; // Live intermediates (budget only)
+        uintmax_t temp_bytes_ = 0;                              // Sum of temp_sizes_
+        uintmax_t temp_reserved_ = 0;                           // Expected output of items in flight
+        size_t temp_items_ = 0;                                 // Scatter items in flight
+        uintmax_t temp_budget_ = 0;                             // 0 = unlimited
 
-        // When width > 1, these track the parallel file paths at current width
-        std::vector<std::filesystem::path> scattered_paths_;
+        // Create the per-run temp directories
+        void create_run_dirs();
+
+        // Phases 2 and 3 on a built graph, then temp cleanup
+        PipelineResult run(ExecutionGraph &graph,
+                           const Pipeline &pipeline,
+                           const std::shared_ptr<output::IOutput> &output,
+                           std::chrono::steady_clock::time_point start_time);
 
         // Phase 1: Build execution graph from pipeline
         void build_graph(ExecutionGraph &graph, const Pipeline &pipeline);
 
+        // Splice intermediate conversions in front of nodes no single plugin
+        // can serve from their input format (see RoutePlanner)
+        void plan_routes(ExecutionGraph &graph, const Pipeline &pipeline);
+        void plan_routes(ExecutionGraph &graph, const std::string &source_format, uintmax_t source_size);
+
         // Phase 2: Execute all nodes in topological order (all outputs to temp)
         bool execute_graph(ExecutionGraph &graph,
                           const Pipeline &pipeline,
@@ -41,6 +110,16 @@ namespace uniconv::core
                           size_t total_conversion_nodes,
                           PipelineResult &result);
 
+        // Phase 2 (--jobs N): dispatch nodes to a worker pool as soon as all
+        // their predecessors have finished. Stage results are merged back in
+        // topological order so the result matches a serial run.
+        bool execute_graph_parallel(ExecutionGraph &graph,
+                                   const Pipeline &pipeline,
+                                   const std::shared_ptr<output::IOutput> &output,
+                                   size_t total_conversion_nodes,
+                                   size_t jobs,
+                                   PipelineResult &result);
+
         // Phase 3: Finalize outputs (move/keep/delete based on full visibility)
         // Returns false if there was an error (e.g., non-copyable format without -o)
         bool finalize_outputs(ExecutionGraph &graph,
@@ -95,18 +174,96 @@ namespace uniconv::core
                                          size_t total_nodes,
                                          PipelineResult &result);
 
+        // --pipelined: run each scattered item through a linear chain of
+        // conversion nodes on its own instead of stage by stage. Intermediate
+        // per-item files are removed once the next stage has read them.
+        bool execute_pipelined_chain(const std::vector<size_t> &chain,
+                                     ExecutionGraph &graph,
+                                     const Pipeline &pipeline,
+                                     const std::shared_ptr<output::IOutput> &output,
+                                     size_t total_nodes,
+                                     PipelineResult &result);
+
+        // Conversion nodes reachable from node through single-consumer edges,
+        // starting with node itself
+        std::vector<size_t> pipelined_chain(const ExecutionNode &node,
+                                            const ExecutionGraph &graph) const;
+
+        // Conversion nodes starting at node that can be connected by named
+        // pipes: every producer declares stream output, its single consumer
+        // declares stream input and both are CLI plugins. Just {node.id}
+        // when nothing can be streamed (always on Windows).
+        std::vector<size_t> streamed_chain(const ExecutionNode &node,
+                                           const ExecutionGraph &graph);
+
+        // Run a streamed chain like a shell pipeline: every stage starts at
+        // once, reading from and writing to FIFOs in the run directory
+        // instead of intermediate temp files
+        bool execute_streamed_chain(const std::vector<size_t> &chain,
+                                    ExecutionGraph &graph,
+                                    const Pipeline &pipeline,
+                                    const std::shared_ptr<output::IOutput> &output,
+                                    size_t total_nodes,
+                                    PipelineResult &result);
+
+        // Whether node should hand its output to its only consumer in memory:
+        // both resolve to plugins with buffer I/O (native ABI v4)
+        bool keeps_output_in_memory(const ExecutionNode &node,
+                                    const ExecutionGraph &graph);
+
+        // Plugin the engine will pick for node given its input format
+        plugins::IPlugin *resolve_node_plugin(const ExecutionNode &node,
+                                              const std::string &input_format);
+
+        // 1-based progress number of a conversion node in serial order
+        size_t conversion_number(const ExecutionGraph &graph, size_t node_id) const;
+
+        // Run the conversion for a single scattered input and return its stage
+        // result. Safe to call from several worker threads for the same node.
+        StageResult execute_scatter_item(const ExecutionNode &node,
+                                         const Pipeline &pipeline,
+                                         const std::shared_ptr<output::IOutput> &output,
+                                         size_t current_node,
+                                         size_t total_nodes,
+                                         const std::filesystem::path &scattered_input,
+                                         size_t index,
+                                         size_t count);
+
+        // Number of scatter items to run concurrently (--scatter-jobs, else --jobs)
+        static size_t scatter_width(const CoreOptions &options);
+
         // Generate temp file path: run_dir / s{N}_e{M}.{target}
         std::filesystem::path generate_temp_path(
             const std::string &target,
             size_t stage_index,
-            size_t element_index);
+            size_t element_index,
+            uintmax_t expected_size = UINTMAX_MAX);
 
         // Generate temp file path for scatter index: run_dir / s{N}_e{M}_i{I}.{target}
         std::filesystem::path generate_scatter_temp_path(
             const std::string &target,
             size_t stage_index,
             size_t element_index,
-            size_t scatter_index);
+            size_t scatter_index,
+            uintmax_t expected_size = UINTMAX_MAX);
+
+        // Run directory for an intermediate of expected_size bytes: the RAM
+        // directory when it is under the threshold and fits, else disk
+        const std::filesystem::path &scratch_dir_for(uintmax_t expected_size) const;
+
+        // Size of what a stage reads; UINTMAX_MAX when unknown (no input, a
+        // directory or a pipe)
+        static uintmax_t input_size(const std::filesystem::path &input,
+                                    const Buffer *input_data = nullptr);
+
+        // Expected size of a stage's output: the input size scaled by the
+        // size ratio in the performance history when there is one (a page
+        // split or frame extraction grows far past its input), else the
+        // input size itself
+        uintmax_t expected_output_size(const ExecutionNode &node,
+                                       const Pipeline &pipeline,
+                                       const std::filesystem::path &input,
+                                       const Buffer *input_data = nullptr);
 
         // Generate final output path (current directory)
         std::filesystem::path generate_final_output_path(
@@ -128,14 +285,84 @@ namespace uniconv::core
         std::filesystem::path get_node_input(const ExecutionNode &node,
                                             const ExecutionGraph &graph);
 
+        // Scatter/collect width tracking.
+        // When a plugin returns "outputs" (scatter), width increases from 1 to N
+        // and subsequent stages execute N times (once per scattered output).
+        // "collect" reduces width back to 1. The scattered paths flowing into a
+        // node are derived from its predecessors (looking through tee,
+        // passthrough and clipboard), so independent branches never share state.
+        std::vector<std::filesystem::path> scatter_inputs(const ExecutionNode &node,
+                                                          const ExecutionGraph &graph) const;
+
+        // Thread-safe progress reporting
+        void report_stage_started(const std::shared_ptr<output::IOutput> &output,
+                                  size_t current, size_t total, const std::string &target,
+                                  int64_t estimate_ms = -1);
+
+        // Expected duration of running node on input from the performance
+        // history; -1 when unknown
+        int64_t expected_duration_ms(const ExecutionNode &node,
+                                     const Pipeline &pipeline,
+                                     const std::filesystem::path &input,
+                                     const Buffer *input_data = nullptr);
+
+        // What running node on input is expected to use: the plugin's
+        // declared resources, with the recorded peak RSS when it declares
+        // no memory
+        ResourceClaim resource_claim(const ExecutionNode &node,
+                                     const Pipeline &pipeline,
+                                     const std::filesystem::path &input,
+                                     const Buffer *input_data = nullptr);
+
+        void report_stage_completed(const std::shared_ptr<output::IOutput> &output,
+                                    size_t current, size_t total, const std::string &target,
+                                    int64_t duration_ms, bool success, const std::string &error);
+
+        // Record a stage result / final output: kept in result, or passed
+        // straight to the streaming output. Counted either way.
+        void add_stage_result(PipelineResult &result, const StageResult &stage);
+        void add_final_output(PipelineResult &result, const std::filesystem::path &path);
+
         // Cleanup temp files
         void cleanup_temp_files();
 
+        // Count the readers of every producer's output, looking through tee
+        // and passthrough, and mark outputs that finalize_outputs will keep
+        void plan_temp_release(const ExecutionGraph &graph, const Pipeline &pipeline);
+
+        // node_id finished: count its outputs against the budget and delete
+        // inputs it was the last reader of
+        void release_temp_inputs(size_t node_id, const ExecutionGraph &graph);
+
+        // Whether node is the last unfinished reader of all its scattered
+        // inputs, so each can be deleted as soon as its item is converted
+        bool consumes_scatter_inputs(const ExecutionNode &node);
+
+        // Temp files or directories a node produced
+        std::vector<std::filesystem::path> temp_outputs_of(const ExecutionNode &node) const;
+
+        // Budget accounting: record a new intermediate / delete one
+        void track_temp_output(const std::filesystem::path &path);
+        void remove_temp_output(const std::filesystem::path &path);
+
+        // Wait until an item expected to write estimate bytes fits in
+        // --temp-budget (or nothing else is in flight); returns the
+        // reservation to hand back to settle_temp
+        uintmax_t reserve_temp(uintmax_t estimate);
+        void settle_temp(uintmax_t reservation, const std::filesystem::path &output);
+
         // Resolve extension for a node:
         // 1. Explicit extension from user → use as-is
         // 2. Look up target in plugin's targets map → use first entry
         // 3. Fallback to target_to_extension(target)
         std::string resolve_extension(const ExecutionNode &node);
+        std::string resolve_extension(const ExecutionNode &node,
+                                      const std::optional<PluginInfo> &plugin_info);
+
+        // Resolve a conversion node's extension and sink flag from its
+        // plugin and check its required options; once per node, so nodes of
+        // a prepared graph are not resolved again. Returns the option error.
+        std::optional<std::string> prepare_node(ExecutionNode &node);
 
         // Check if a target format can have its content copied to clipboard
         static bool is_clipboard_content_copyable(const std::string &target);
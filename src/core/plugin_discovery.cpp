@@ -1,5 +1,6 @@
 #include "plugin_discovery.h"
 #include "utils/file_utils.h"
+#include "utils/string_utils.h"
 #include <algorithm>
 #include <cstdlib>
 #include <fstream>
@@ -77,6 +78,7 @@ std::filesystem::path get_executable_dir() {
 
 PluginDiscovery::PluginDiscovery()
     : plugin_dirs_(get_standard_plugin_dirs()) {
+    set_index_path(PluginIndex::default_path());
 }
 
 PluginDiscovery::PluginDiscovery(std::vector<std::filesystem::path> plugin_dirs)
@@ -87,10 +89,70 @@ void PluginDiscovery::add_plugin_dir(const std::filesystem::path& dir) {
     // Avoid duplicates
     if (std::find(plugin_dirs_.begin(), plugin_dirs_.end(), dir) == plugin_dirs_.end()) {
         plugin_dirs_.push_back(dir);
+        index_fresh_ = false;
     }
 }
 
+void PluginDiscovery::set_index_path(const std::filesystem::path& path) {
+    index_ = path.empty() ? nullptr : std::make_shared<PluginIndex>(path);
+    index_fresh_ = false;
+}
+
+void PluginDiscovery::refresh_index() const {
+    index_->refresh(plugin_dirs_, [this](const std::filesystem::path& manifest_path) {
+        return load_manifest_file(manifest_path);
+    });
+    index_fresh_ = true;
+}
+
+std::vector<PluginManifest> PluginDiscovery::discover_matching(
+    const std::string& target, const std::optional<std::string>& explicit_plugin) const {
+    if (index_) {
+        if (!index_fresh_) {
+            refresh_index();
+        }
+        auto found = index_->find(target, explicit_plugin);
+        if (index_->damaged()) {
+            // Reparse the damaged manifests and look again
+            refresh_index();
+            found = index_->find(target, explicit_plugin);
+        }
+        return found;
+    }
+
+    auto target_lower = utils::to_lower(target);
+    std::vector<PluginManifest> matching;
+    for (auto& m : discover_all()) {
+        bool matches = std::any_of(m.targets.begin(), m.targets.end(), [&](const auto& t) {
+            return utils::to_lower(t.first) == target_lower;
+        });
+        if (!matches && explicit_plugin) {
+            auto wanted = utils::to_lower(*explicit_plugin);
+            auto slash = wanted.find('/');
+            matches = slash == std::string::npos
+                          ? utils::to_lower(m.name) == wanted
+                          : utils::to_lower(m.scope) == wanted.substr(0, slash) &&
+                                utils::to_lower(m.name) == wanted.substr(slash + 1);
+        }
+        if (matches) {
+            matching.push_back(std::move(m));
+        }
+    }
+    return matching;
+}
+
 std::vector<PluginManifest> PluginDiscovery::discover_all() const {
+    // The full scan always revalidates: it is what install/remove check
+    if (index_) {
+        refresh_index();
+        auto manifests = index_->manifests();
+        if (index_->damaged()) {
+            refresh_index();
+            manifests = index_->manifests();
+        }
+        return manifests;
+    }
+
     std::vector<PluginManifest> manifests;
     std::set<std::string> seen_names;
 
@@ -157,10 +219,18 @@ std::optional<PluginManifest> PluginDiscovery::load_manifest_file(const std::fil
         manifest.manifest_path = manifest_path;
         manifest.plugin_dir = manifest_path.parent_path();
 
+        // Content types are derived when none are given; a lone "stream"
+        // only declares how data is passed and is kept alongside them
+        auto only_stream = [](const std::vector<DataType> &types)
+        {
+            return std::all_of(types.begin(), types.end(),
+                               [](DataType t) { return t == DataType::Stream; });
+        };
+
         // Derive input_types from accepts if not explicitly provided
-        if (manifest.input_types.empty() && manifest.accepts.has_value() && !manifest.accepts->empty())
+        if (only_stream(manifest.input_types) && manifest.accepts.has_value() && !manifest.accepts->empty())
         {
-            std::set<DataType> types;
+            std::set<DataType> types(manifest.input_types.begin(), manifest.input_types.end());
             for (const auto &fmt : *manifest.accepts)
             {
                 for (auto t : utils::detect_input_types(fmt))
@@ -170,9 +240,9 @@ std::optional<PluginManifest> PluginDiscovery::load_manifest_file(const std::fil
         }
 
         // Derive output_types from targets if not explicitly provided
-        if (manifest.output_types.empty() && !manifest.targets.empty())
+        if (only_stream(manifest.output_types) && !manifest.targets.empty())
         {
-            std::set<DataType> types;
+            std::set<DataType> types(manifest.output_types.begin(), manifest.output_types.end());
             for (const auto &[target, extensions] : manifest.targets)
             {
                 if (extensions.empty())
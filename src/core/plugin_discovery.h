@@ -1,7 +1,9 @@
 #pragma once
 
+#include "plugin_index.h"
 #include "plugin_manifest.h"
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -13,15 +15,20 @@ public:
     // Manifest filename
     static constexpr const char* kManifestFilename = "plugin.json";
 
-    // Default constructor uses standard plugin directories
+    // Default constructor uses standard plugin directories and the
+    // manifest index at PluginIndex::default_path()
     PluginDiscovery();
 
-    // Constructor with custom plugin directories
+    // Constructor with custom plugin directories (no index)
     explicit PluginDiscovery(std::vector<std::filesystem::path> plugin_dirs);
 
     // Add a plugin directory to search
     void add_plugin_dir(const std::filesystem::path& dir);
 
+    // Keep manifests in a persisted index at path; empty scans every time
+    void set_index_path(const std::filesystem::path& path);
+    bool has_index() const { return index_ != nullptr; }
+
     // Get all plugin directories
     const std::vector<std::filesystem::path>& plugin_dirs() const { return plugin_dirs_; }
 
@@ -29,6 +36,12 @@ public:
     // Returns list of loaded manifests
     std::vector<PluginManifest> discover_all() const;
 
+    // Manifests offering target or named by explicit_plugin ("name" or
+    // "scope/name"). With an index, only those manifests are decoded, and
+    // the index is brought up to date on first use only.
+    std::vector<PluginManifest> discover_matching(const std::string& target,
+                                                  const std::optional<std::string>& explicit_plugin) const;
+
     // Discover plugins in a specific directory
     std::vector<PluginManifest> discover_in_dir(const std::filesystem::path& dir) const;
 
@@ -55,6 +68,11 @@ public:
 
 private:
     std::vector<std::filesystem::path> plugin_dirs_;
+    std::shared_ptr<PluginIndex> index_;
+    mutable bool index_fresh_ = false;
+
+    // Bring the index up to date with plugin_dirs_
+    void refresh_index() const;
 };
 
 } // namespace uniconv::core
@@ -0,0 +1,533 @@
+#include "plugin_index.h"
+#include "config_manager.h"
+#include "plugin_discovery.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+
+#ifdef _WIN32
+#include <process.h>
+#define GETPID _getpid
+#else
+#include <unistd.h>
+#define GETPID getpid
+#endif
+
+namespace uniconv::core {
+
+namespace {
+
+// Layout: Header | DirRecord[dir_count] | EntryRecord[entry_count] |
+// TargetRecord[target_count] | string pool. Offsets are into the pool.
+// Native byte order; the index never leaves the machine that wrote it.
+constexpr char kMagic[8] = {'U', 'C', 'P', 'I', 'D', 'X', '\0', '\1'};
+constexpr uint32_t kVersion = 1;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t dir_count;
+    uint32_t entry_count;
+    uint32_t target_count;
+    uint64_t pool_size;
+};
+
+// A scanned directory and its subdirectory names
+struct DirRecord {
+    int64_t mtime; // 0 = unknown, list again
+    uint32_t path_off, path_len;
+    uint32_t children_off, children_len;
+};
+
+// A plugin directory's manifest; an empty blob marks an invalid manifest
+struct EntryRecord {
+    int64_t mtime; // 0 = unknown, parse again
+    uint64_t size;
+    uint32_t dir_off, dir_len;
+    uint32_t name_off, name_len;
+    uint32_t scope_off, scope_len;
+    uint32_t blob_off, blob_len; // Manifest as CBOR
+    uint32_t shadowed;           // An earlier plugin has the same name
+    uint32_t reserved;
+};
+
+// Lower-cased target -> entry, sorted by target then entry
+struct TargetRecord {
+    uint32_t key_off, key_len;
+    uint32_t entry;
+    uint32_t reserved;
+};
+
+struct Layout {
+    Header header;
+    size_t dirs, entries, targets, pool;
+};
+
+template <typename T>
+T read_at(const uint8_t* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+Layout layout_of(const uint8_t* data) {
+    Layout layout;
+    layout.header = read_at<Header>(data, 0);
+    layout.dirs = sizeof(Header);
+    layout.entries = layout.dirs + layout.header.dir_count * sizeof(DirRecord);
+    layout.targets = layout.entries + layout.header.entry_count * sizeof(EntryRecord);
+    layout.pool = layout.targets + layout.header.target_count * sizeof(TargetRecord);
+    return layout;
+}
+
+int64_t raw_time(std::filesystem::file_time_type time) {
+    return time.time_since_epoch().count();
+}
+
+// A change within this window of now may not have moved the timestamp yet
+int64_t trusted_time(std::filesystem::file_time_type time) {
+    constexpr auto kRacyWindow = std::chrono::seconds(2);
+    if (std::filesystem::file_time_type::clock::now() - time < kRacyWindow) {
+        return 0;
+    }
+    return raw_time(time);
+}
+
+std::vector<std::string> split_names(std::string_view joined) {
+    std::vector<std::string> names;
+    while (!joined.empty()) {
+        auto end = joined.find('\0');
+        names.emplace_back(joined.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        joined.remove_prefix(end + 1);
+    }
+    return names;
+}
+
+// An entry of the index being built
+struct BuiltEntry {
+    std::string dir;
+    int64_t mtime = 0;
+    uint64_t size = 0;
+    std::string name;
+    std::string scope;
+    std::string blob;
+    std::vector<std::string> targets;
+    std::optional<size_t> reused; // Index in the previous image
+};
+
+struct BuiltDir {
+    std::string path;
+    int64_t mtime = 0;
+    std::vector<std::string> children;
+    bool reused = false;
+};
+
+} // anonymous namespace
+
+PluginIndex::PluginIndex(std::filesystem::path path)
+    : path_(std::move(path)) {
+}
+
+std::filesystem::path PluginIndex::default_path() {
+    auto dir = ConfigManager::get_default_config_dir();
+    return dir.empty() ? std::filesystem::path() : dir / "plugins.idx";
+}
+
+bool PluginIndex::open() {
+    clear();
+    if (!file_.open(path_) || file_.size() < sizeof(Header)) {
+        clear();
+        return false;
+    }
+
+    auto layout = layout_of(file_.data());
+    if (std::memcmp(layout.header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        layout.header.version != kVersion ||
+        layout.pool + layout.header.pool_size != file_.size()) {
+        clear();
+        return false;
+    }
+
+    data_ = file_.data();
+    size_ = file_.size();
+    return true;
+}
+
+void PluginIndex::clear() {
+    file_.close();
+    memory_.clear();
+    data_ = nullptr;
+    size_ = 0;
+}
+
+size_t PluginIndex::size() const {
+    return data_ ? layout_of(data_).header.entry_count : 0;
+}
+
+size_t PluginIndex::dir_count() const {
+    return data_ ? layout_of(data_).header.dir_count : 0;
+}
+
+size_t PluginIndex::target_count() const {
+    return data_ ? layout_of(data_).header.target_count : 0;
+}
+
+std::string_view PluginIndex::pool(uint32_t offset, uint32_t length) const {
+    auto layout = layout_of(data_);
+    // A damaged record reads as empty rather than out of bounds
+    if (static_cast<uint64_t>(offset) + length > layout.header.pool_size) {
+        return {};
+    }
+    return std::string_view(reinterpret_cast<const char*>(data_ + layout.pool + offset), length);
+}
+
+PluginIndex::DirView PluginIndex::dir_at(size_t i) const {
+    auto record = read_at<DirRecord>(data_, layout_of(data_).dirs + i * sizeof(DirRecord));
+    return {record.mtime, pool(record.path_off, record.path_len),
+            pool(record.children_off, record.children_len)};
+}
+
+PluginIndex::EntryView PluginIndex::entry_at(size_t i) const {
+    auto record = read_at<EntryRecord>(data_, layout_of(data_).entries + i * sizeof(EntryRecord));
+    return {record.mtime,
+            record.size,
+            pool(record.dir_off, record.dir_len),
+            pool(record.name_off, record.name_len),
+            pool(record.scope_off, record.scope_len),
+            pool(record.blob_off, record.blob_len),
+            record.shadowed != 0};
+}
+
+std::string_view PluginIndex::target_at(size_t i, uint32_t* entry) const {
+    auto record = read_at<TargetRecord>(data_, layout_of(data_).targets + i * sizeof(TargetRecord));
+    *entry = record.entry;
+    return pool(record.key_off, record.key_len);
+}
+
+PluginManifest PluginIndex::decode(const EntryView& entry) {
+    auto manifest = PluginManifest::from_json(nlohmann::json::from_cbor(entry.blob.begin(), entry.blob.end()));
+    manifest.plugin_dir = std::filesystem::path(std::string(entry.dir));
+    manifest.manifest_path = manifest.plugin_dir / PluginDiscovery::kManifestFilename;
+    return manifest;
+}
+
+std::optional<PluginManifest> PluginIndex::try_decode(const EntryView& entry) const {
+    try {
+        return decode(entry);
+    } catch (const std::exception&) {
+        damaged_.emplace(entry.dir);
+        return std::nullopt;
+    }
+}
+
+bool PluginIndex::refresh(const std::vector<std::filesystem::path>& plugin_dirs, const ManifestLoader& load) {
+    parsed_ = 0;
+    written_ = false;
+    if (!data_) {
+        open();
+    }
+    bool changed = data_ == nullptr;
+
+    // What the previous image knows, by path
+    std::map<std::string_view, size_t> old_dirs;
+    for (size_t i = 0; i < dir_count(); ++i) {
+        old_dirs[dir_at(i).path] = i;
+    }
+    std::map<std::string_view, size_t> old_entries;
+    for (size_t i = 0; i < size(); ++i) {
+        old_entries[entry_at(i).dir] = i;
+    }
+    std::vector<std::vector<std::string>> old_targets(size());
+    for (size_t i = 0; i < target_count(); ++i) {
+        uint32_t entry = 0;
+        auto key = target_at(i, &entry);
+        if (entry < old_targets.size()) {
+            old_targets[entry].emplace_back(key);
+        }
+    }
+
+    // Subdirectories of dir, listed again only if its mtime moved
+    std::vector<BuiltDir> dirs;
+    auto list = [&](const std::filesystem::path& dir) {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(dir, ec);
+        if (ec || !std::filesystem::is_directory(dir, ec)) {
+            return std::vector<std::string>{};
+        }
+
+        BuiltDir built;
+        built.path = dir.string();
+        built.mtime = trusted_time(time);
+        auto old = old_dirs.find(built.path);
+        if (old != old_dirs.end() && dir_at(old->second).mtime != 0 &&
+            dir_at(old->second).mtime == raw_time(time)) {
+            built.children = split_names(dir_at(old->second).children);
+            built.reused = true;
+        } else {
+            for (const auto& child : std::filesystem::directory_iterator(
+                     dir, std::filesystem::directory_options::skip_permission_denied, ec)) {
+                std::error_code type_ec;
+                if (child.is_directory(type_ec)) {
+                    built.children.push_back(child.path().filename().string());
+                }
+            }
+            std::sort(built.children.begin(), built.children.end());
+        }
+        dirs.push_back(built);
+        return built.children;
+    };
+
+    // plugins/<scope>/<name>/plugin.json, reusing unchanged manifests
+    std::vector<BuiltEntry> entries;
+    for (const auto& root : plugin_dirs) {
+        for (const auto& scope : list(root)) {
+            for (const auto& name : list(root / scope)) {
+                auto plugin_dir = root / scope / name;
+                auto manifest_path = plugin_dir / PluginDiscovery::kManifestFilename;
+                std::error_code ec;
+                auto size = std::filesystem::file_size(manifest_path, ec);
+                auto time = ec ? std::filesystem::file_time_type{} : std::filesystem::last_write_time(manifest_path, ec);
+                if (ec) {
+                    continue;
+                }
+
+                BuiltEntry built;
+                built.dir = plugin_dir.string();
+                auto old = old_entries.find(built.dir);
+                if (old != old_entries.end() && !damaged_.contains(built.dir)) {
+                    auto view = entry_at(old->second);
+                    if (view.mtime != 0 && view.mtime == raw_time(time) && view.size == size) {
+                        built.mtime = view.mtime;
+                        built.size = view.size;
+                        built.name = view.name;
+                        built.scope = view.scope;
+                        built.blob = view.blob;
+                        built.targets = old_targets[old->second];
+                        built.reused = old->second;
+                        entries.push_back(std::move(built));
+                        continue;
+                    }
+                }
+
+                // Invalid manifests are recorded too, so they are not parsed
+                // again until they change
+                ++parsed_;
+                built.mtime = trusted_time(time);
+                built.size = size;
+                if (auto manifest = load(manifest_path)) {
+                    built.name = manifest->name;
+                    built.scope = manifest->scope;
+                    auto cbor = nlohmann::json::to_cbor(manifest->to_json());
+                    built.blob.assign(cbor.begin(), cbor.end());
+                    for (const auto& [target, _] : manifest->targets) {
+                        built.targets.push_back(utils::to_lower(target));
+                    }
+                }
+                entries.push_back(std::move(built));
+            }
+        }
+    }
+
+    // Damaged entries were parsed again above and must be written back
+    changed = changed || !damaged_.empty();
+    damaged_.clear();
+
+    // Unchanged: same directories and the same entries in the same order
+    if (!changed && dirs.size() == dir_count() && entries.size() == size()) {
+        bool same = std::all_of(dirs.begin(), dirs.end(), [](const BuiltDir& d) { return d.reused; });
+        for (size_t i = 0; same && i < entries.size(); ++i) {
+            same = entries[i].reused == i;
+        }
+        if (same) {
+            return true;
+        }
+    }
+
+    // Nothing installed and nothing to replace: don't create the file
+    std::error_code exists_ec;
+    if (entries.empty() && !std::filesystem::exists(path_, exists_ec)) {
+        return true;
+    }
+
+    // Build the new image
+    std::string strings;
+    auto add = [&strings](std::string_view s) {
+        auto offset = static_cast<uint32_t>(strings.size());
+        strings.append(s);
+        return std::make_pair(offset, static_cast<uint32_t>(s.size()));
+    };
+
+    std::vector<DirRecord> dir_records;
+    for (const auto& dir : dirs) {
+        DirRecord record{};
+        record.mtime = dir.mtime;
+        std::tie(record.path_off, record.path_len) = add(dir.path);
+        std::string joined;
+        for (size_t i = 0; i < dir.children.size(); ++i) {
+            if (i > 0) {
+                joined.push_back('\0');
+            }
+            joined += dir.children[i];
+        }
+        std::tie(record.children_off, record.children_len) = add(joined);
+        dir_records.push_back(record);
+    }
+
+    std::vector<EntryRecord> entry_records;
+    std::vector<std::pair<std::string, uint32_t>> targets;
+    std::set<std::string> seen_names;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        EntryRecord record{};
+        record.mtime = entry.mtime;
+        record.size = entry.size;
+        std::tie(record.dir_off, record.dir_len) = add(entry.dir);
+        std::tie(record.name_off, record.name_len) = add(entry.name);
+        std::tie(record.scope_off, record.scope_len) = add(entry.scope);
+        std::tie(record.blob_off, record.blob_len) = add(entry.blob);
+        record.shadowed = !entry.blob.empty() && !seen_names.insert(entry.name).second ? 1 : 0;
+        entry_records.push_back(record);
+        for (const auto& target : entry.targets) {
+            targets.emplace_back(target, static_cast<uint32_t>(i));
+        }
+    }
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.dir_count = static_cast<uint32_t>(dir_records.size());
+    header.entry_count = static_cast<uint32_t>(entry_records.size());
+    header.target_count = static_cast<uint32_t>(targets.size());
+
+    std::vector<TargetRecord> target_records;
+    for (const auto& [key, entry] : targets) {
+        TargetRecord record{};
+        std::tie(record.key_off, record.key_len) = add(key);
+        record.entry = entry;
+        target_records.push_back(record);
+    }
+    header.pool_size = strings.size();
+
+    std::vector<uint8_t> image;
+    append(image, header);
+    for (const auto& record : dir_records) {
+        append(image, record);
+    }
+    for (const auto& record : entry_records) {
+        append(image, record);
+    }
+    for (const auto& record : target_records) {
+        append(image, record);
+    }
+    image.insert(image.end(), strings.begin(), strings.end());
+
+    // Replace the file atomically, so a concurrent reader sees either index
+    std::error_code ec;
+    std::filesystem::create_directories(path_.parent_path(), ec);
+    auto temp = path_;
+    temp += ".tmp." + std::to_string(GETPID());
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+        written_ = static_cast<bool>(out);
+    }
+    if (written_) {
+        std::filesystem::rename(temp, path_, ec);
+        written_ = !ec;
+    }
+    if (!written_) {
+        std::filesystem::remove(temp, ec);
+    }
+
+    if (!written_ || !open()) {
+        clear();
+        memory_ = std::move(image);
+        data_ = memory_.data();
+        size_ = memory_.size();
+    }
+    return written_;
+}
+
+std::vector<PluginManifest> PluginIndex::manifests() const {
+    std::vector<PluginManifest> result;
+    for (size_t i = 0; i < size(); ++i) {
+        auto entry = entry_at(i);
+        if (entry.shadowed || entry.blob.empty()) {
+            continue;
+        }
+        if (auto manifest = try_decode(entry)) {
+            result.push_back(std::move(*manifest));
+        }
+    }
+    return result;
+}
+
+std::vector<PluginManifest> PluginIndex::find(const std::string& target,
+                                              const std::optional<std::string>& explicit_plugin) const {
+    std::set<size_t> hits; // Priority order
+
+    auto key = utils::to_lower(target);
+    size_t lo = 0;
+    size_t hi = target_count();
+    uint32_t entry = 0;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (target_at(mid, &entry) < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (size_t i = lo; i < target_count() && target_at(i, &entry) == key; ++i) {
+        hits.insert(entry);
+    }
+
+    // "name" or "scope/name", as PluginManager matches them
+    if (explicit_plugin) {
+        auto wanted = utils::to_lower(*explicit_plugin);
+        auto slash = wanted.find('/');
+        for (size_t i = 0; i < size(); ++i) {
+            auto view = entry_at(i);
+            auto name = utils::to_lower(std::string(view.name));
+            bool matches = slash == std::string::npos
+                               ? name == wanted
+                               : utils::to_lower(std::string(view.scope)) == wanted.substr(0, slash) &&
+                                     name == wanted.substr(slash + 1);
+            if (matches) {
+                hits.insert(i);
+            }
+        }
+    }
+
+    std::vector<PluginManifest> result;
+    for (size_t i : hits) {
+        if (i >= size()) {
+            continue;
+        }
+        auto view = entry_at(i);
+        if (view.shadowed || view.blob.empty()) {
+            continue;
+        }
+        if (auto manifest = try_decode(view)) {
+            result.push_back(std::move(*manifest));
+        }
+    }
+    return result;
+}
+
+} // namespace uniconv::core
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "plugin_manifest.h"
+#include "utils/mapped_file.h"
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace uniconv::core {
+
+// Persisted index of the plugin manifests under a set of plugin directories
+// (~/.uniconv/plugins.idx), so startup does not parse every plugin.json.
+//
+// The file is a flat binary image that is memory-mapped as is: fixed-size
+// records for the scanned directories and the manifests, a sorted
+// target -> manifest table, and a string pool holding paths and each
+// manifest in CBOR. A lookup by target binary-searches the table and
+// decodes only the manifests it hits.
+//
+// refresh() revalidates against the filesystem. A directory whose mtime is
+// unchanged is not listed again, and a manifest whose size and mtime are
+// unchanged is not parsed again, so only new or edited plugins cost a
+// parse. Timestamps too recent to be trusted (a later change in the same
+// tick would not move them) are recorded as unknown and checked next time.
+// A stored manifest that no longer decodes is skipped and reported by
+// damaged(); the next refresh parses it again.
+class PluginIndex {
+public:
+    // Parses one plugin.json; nullopt if it is not a valid manifest
+    using ManifestLoader = std::function<std::optional<PluginManifest>(const std::filesystem::path&)>;
+
+    explicit PluginIndex(std::filesystem::path path);
+
+    // ~/.uniconv/plugins.idx
+    static std::filesystem::path default_path();
+
+    const std::filesystem::path& path() const { return path_; }
+
+    // Bring the index up to date with plugin_dirs (scanned as
+    // <dir>/<scope>/<name>/plugin.json, in priority order), parsing changed
+    // manifests with load. Rewrites the file only when something changed.
+    // Returns false if it could not be written; the index is still usable.
+    bool refresh(const std::vector<std::filesystem::path>& plugin_dirs, const ManifestLoader& load);
+
+    // Manifests parsed by the last refresh, and whether it rewrote the file
+    size_t parsed() const { return parsed_; }
+    bool written() const { return written_; }
+
+    // Indexed manifests, including ones shadowed by an earlier plugin of
+    // the same name
+    size_t size() const;
+
+    // All manifests in priority order; the first plugin of a name wins
+    std::vector<PluginManifest> manifests() const;
+
+    // Manifests offering target (case-insensitive) or, with explicit_plugin
+    // ("name" or "scope/name"), named by it
+    std::vector<PluginManifest> find(const std::string& target,
+                                     const std::optional<std::string>& explicit_plugin = std::nullopt) const;
+
+    // Whether a lookup since the last refresh hit an entry that failed to
+    // decode. Such entries are left out of results until refreshed.
+    bool damaged() const { return !damaged_.empty(); }
+
+private:
+    std::filesystem::path path_;
+    utils::MappedFile file_;
+    std::vector<uint8_t> memory_; // Image kept in memory when it cannot be written
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t parsed_ = 0;
+    bool written_ = false;
+    mutable std::set<std::string, std::less<>> damaged_; // Plugin dirs of undecodable entries
+
+    // Map the file and check its layout; false leaves the index empty
+    bool open();
+    void clear();
+
+    // Views into the current image
+    struct DirView {
+        int64_t mtime = 0;
+        std::string_view path;
+        std::string_view children; // NUL-separated names
+    };
+    struct EntryView {
+        int64_t mtime = 0;
+        uint64_t size = 0;
+        std::string_view dir;
+        std::string_view name;
+        std::string_view scope;
+        std::string_view blob;
+        bool shadowed = false;
+    };
+    size_t dir_count() const;
+    size_t target_count() const;
+    DirView dir_at(size_t i) const;
+    EntryView entry_at(size_t i) const;
+    std::string_view target_at(size_t i, uint32_t* entry) const;
+    std::string_view pool(uint32_t offset, uint32_t length) const;
+
+    static PluginManifest decode(const EntryView& entry);
+
+    // decode(), recording the entry as damaged if it fails
+    std::optional<PluginManifest> try_decode(const EntryView& entry) const;
+};
+
+} // namespace uniconv::core
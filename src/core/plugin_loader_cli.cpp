@@ -1,7 +1,11 @@
 #include "plugin_loader_cli.h"
 #include "dependency_installer.h"
+#include "trace.h"
+#include "utils/file_utils.h"
+#include "utils/string_utils.h"
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <utility>
@@ -9,6 +13,8 @@
 #ifdef _WIN32
 #include <windows.h>
 #else
+#include <fcntl.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #include <poll.h>
@@ -20,20 +26,13 @@ namespace uniconv::core
     namespace
     {
 
-        std::string to_lower(std::string s)
-        {
-            std::transform(s.begin(), s.end(), s.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
-            return s;
-        }
-
 // Simple subprocess execution
         struct SubprocessResult
         {
             int exit_code = -1;
             std::string stdout_data;
             std::string stderr_data;
+            uintmax_t peak_rss_kb = 0; // 0 when the platform doesn't report it
         };
 
 #ifndef _WIN32
@@ -53,6 +52,14 @@ namespace uniconv::core
                 return result;
             }
 
+            // Keep these pipes out of plugins spawned concurrently by other
+            // stages, which would otherwise hold them open and delay EOF
+            fcntl(stdout_pipe[0], F_SETFD, FD_CLOEXEC);
+            fcntl(stdout_pipe[1], F_SETFD, FD_CLOEXEC);
+            fcntl(stderr_pipe[0], F_SETFD, FD_CLOEXEC);
+            fcntl(stderr_pipe[1], F_SETFD, FD_CLOEXEC);
+
+            int64_t spawn_start_us = Trace::now_us();
             pid_t pid = fork();
 
             if (pid < 0)
@@ -99,6 +106,12 @@ namespace uniconv::core
             }
 
             // Parent process
+            int64_t run_start_us = Trace::now_us();
+            if (Trace::enabled())
+            {
+                Trace::complete("spawn", "plugin", spawn_start_us, run_start_us - spawn_start_us,
+                                {{"command", command}});
+            }
             close(stdout_pipe[1]);
             close(stderr_pipe[1]);
 
@@ -165,9 +178,25 @@ namespace uniconv::core
             close(stdout_pipe[0]);
             close(stderr_pipe[0]);
 
-            // Wait for child
+            // Wait for child; its resource usage goes to the trace and stats
             int status;
-            waitpid(pid, &status, 0);
+            struct rusage usage{};
+            wait4(pid, &status, 0, &usage);
+#ifdef __APPLE__
+            result.peak_rss_kb = static_cast<uintmax_t>(usage.ru_maxrss) / 1024; // Bytes on macOS
+#else
+            result.peak_rss_kb = static_cast<uintmax_t>(usage.ru_maxrss);
+#endif
+            if (Trace::enabled())
+            {
+                auto ms = [](const timeval &tv)
+                { return static_cast<double>(tv.tv_sec) * 1000.0 + static_cast<double>(tv.tv_usec) / 1000.0; };
+                Trace::complete("plugin_process", "plugin", run_start_us, Trace::now_us() - run_start_us,
+                                {{"command", command},
+                                 {"user_cpu_ms", ms(usage.ru_utime)},
+                                 {"sys_cpu_ms", ms(usage.ru_stime)},
+                                 {"max_rss_kb", result.peak_rss_kb}});
+            }
 
             if (WIFEXITED(status))
             {
@@ -319,10 +348,9 @@ namespace uniconv::core
 
     bool CLIPlugin::supports_target(const std::string &target) const
     {
-        auto lower = to_lower(target);
         for (const auto &[t, _] : manifest_.targets)
         {
-            if (to_lower(t) == lower)
+            if (utils::iequals(t, target))
             {
                 return true;
             }
@@ -346,10 +374,9 @@ namespace uniconv::core
             return false;
         }
 
-        auto lower = to_lower(format);
         for (const auto &f : formats)
         {
-            if (to_lower(f) == lower)
+            if (utils::iequals(f, format))
             {
                 return true;
             }
@@ -531,7 +558,7 @@ namespace uniconv::core
 
 #ifdef _WIN32
         // Windows lacks shebang support; map script extensions to interpreters
-        auto ext = to_lower(executable.extension().string());
+        auto ext = utils::to_lower(executable.extension().string());
         std::string interpreter;
         if (ext == ".py")
             interpreter = "python";
@@ -553,6 +580,65 @@ namespace uniconv::core
         result.exit_code = subprocess_result.exit_code;
         result.stdout_output = std::move(subprocess_result.stdout_data);
         result.stderr_output = std::move(subprocess_result.stderr_data);
+        result.peak_rss_kb = subprocess_result.peak_rss_kb;
+        return result;
+    }
+
+    CLIPlugin::ExecuteResult CLIPlugin::run_worker(
+        const std::filesystem::path &executable,
+        const Request &request,
+        const std::vector<std::string> &args)
+    {
+        PluginWorkerPool *pool;
+        {
+            std::lock_guard<std::mutex> lock(workers_mutex_);
+            if (!workers_)
+            {
+                PluginWorkerPool::Options options;
+                options.max_workers = static_cast<size_t>(std::max(manifest_.workers, 1));
+                options.idle_timeout = std::chrono::seconds(std::max(manifest_.idle_timeout, 1));
+                workers_ = std::make_unique<PluginWorkerPool>(
+                    executable.string(), std::vector<std::string>{"--worker"},
+                    build_environment(), options);
+            }
+            pool = workers_.get();
+        }
+
+        // Same information as the exec-mode command line, both structured
+        // and as the argv the plugin would otherwise have received
+        nlohmann::json message;
+        message["type"] = "execute";
+        message["args"] = args;
+        message["input"] = request.source.string();
+        message["target"] = request.target;
+        if (request.input_format)
+            message["input_format"] = *request.input_format;
+        if (request.core_options.output)
+            message["output"] = request.core_options.output->string();
+        message["force"] = request.core_options.force;
+        message["dry_run"] = request.core_options.dry_run;
+        message["options"] = request.plugin_options;
+
+        auto timeout = std::chrono::milliseconds(
+            static_cast<int64_t>(std::max(request.core_options.timeout_seconds, 0)) * 1000);
+        TraceSpan span("worker_call", "plugin");
+        auto call = pool->call(std::move(message), timeout);
+
+        ExecuteResult result;
+        result.stderr_output = std::move(call.stderr_output);
+        if (call.ok)
+        {
+            result.exit_code = 0;
+            result.stdout_output = std::move(call.response);
+        }
+        else
+        {
+            // Surfaces as "Plugin exited with code 1: <reason>"
+            result.exit_code = 1;
+            result.stderr_output = result.stderr_output.empty()
+                                       ? call.error
+                                       : call.error + "\n" + result.stderr_output;
+        }
         return result;
     }
 
@@ -572,7 +658,12 @@ namespace uniconv::core
         // Try to parse JSON output
         try
         {
-            auto j = nlohmann::json::parse(exec_result.stdout_output);
+            nlohmann::json j;
+            {
+                TraceSpan span("parse_result", "plugin");
+                span.arg("bytes", exec_result.stdout_output.size());
+                j = nlohmann::json::parse(exec_result.stdout_output);
+            }
 
             Result result;
             result.target = request.target;
@@ -603,10 +694,9 @@ namespace uniconv::core
             {
                 result.output_size = j.at("output_size").get<size_t>();
             }
-            else if (result.output && std::filesystem::exists(*result.output) &&
-                     !std::filesystem::is_directory(*result.output))
+            else if (result.output && std::filesystem::is_regular_file(*result.output))
             {
-                result.output_size = std::filesystem::file_size(*result.output);
+                result.output_size = utils::regular_file_size(*result.output);
             }
 
             // Error message
@@ -652,13 +742,23 @@ namespace uniconv::core
         // Build arguments
         auto args = build_arguments(request);
 
-        // Execute
-        auto exec_result = run_process(exe_path, args);
+        // Execute (worker protocol needs POSIX pipes; Windows always spawns)
+        ExecuteResult exec_result;
+#ifndef _WIN32
+        if (manifest_.protocol == PluginProtocol::Worker)
+        {
+            exec_result = run_worker(exe_path, request, args);
+        }
+        else
+#endif
+        {
+            exec_result = run_process(exe_path, args);
+        }
 
         // Parse and return result
         auto result = parse_result(request, exec_result);
-        result.input_size = (request.source.empty() || std::filesystem::is_directory(request.source))
-            ? 0 : std::filesystem::file_size(request.source);
+        result.input_size = request.source.empty() ? 0 : utils::regular_file_size(request.source);
+        result.peak_rss_kb = exec_result.peak_rss_kb;
         return result;
     }
 
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "plugin_manifest.h"
+#include "plugin_worker.h"
 #include "plugins/plugin_interface.h"
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 namespace uniconv::core {
@@ -33,6 +35,10 @@ private:
     PluginManifest manifest_;
     std::optional<std::filesystem::path> dep_env_dir_;
 
+    // Worker processes for "protocol": "worker" (started on first request)
+    std::mutex workers_mutex_;
+    std::unique_ptr<PluginWorkerPool> workers_;
+
     // Resolve the full path to the executable
     std::filesystem::path resolve_executable() const;
 
@@ -47,11 +53,17 @@ private:
         int exit_code = -1;
         std::string stdout_output;
         std::string stderr_output;
+        uintmax_t peak_rss_kb = 0;
     };
     ExecuteResult run_process(const std::filesystem::path& executable,
                               const std::vector<std::string>& args,
                               const std::map<std::string, std::string>& env = {}) const;
 
+    // Send the request to a long-lived worker process (worker protocol)
+    ExecuteResult run_worker(const std::filesystem::path& executable,
+                             const Request& request,
+                             const std::vector<std::string>& args);
+
     // Parse JSON result from plugin stdout
     Result parse_result(const Request& request, const ExecuteResult& exec_result) const;
 };
@@ -1,7 +1,11 @@
 #include "plugin_loader_native.h"
+#include "utils/file_utils.h"
+#include "utils/mapped_file.h"
+#include "utils/string_utils.h"
 #include <uniconv/plugin_api.h>
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <map>
 
@@ -17,14 +21,6 @@ namespace uniconv::core
     namespace
     {
 
-        std::string to_lower(std::string s)
-        {
-            std::transform(s.begin(), s.end(), s.begin(),
-                           [](unsigned char c)
-                           { return std::tolower(c); });
-            return s;
-        }
-
         // Option context for passing to native plugins
         struct OptionContext
         {
@@ -55,13 +51,57 @@ namespace uniconv::core
             return nullptr;
         }
 
+        // Destination of a v4 output sink: memory or the output file
+        struct OutputSinkState
+        {
+            bool in_memory = false;
+            Buffer buffer;
+            std::ofstream file;
+            size_t written = 0;
+            bool failed = false;
+        };
+
+        int write_output_sink_impl(UniconvOutputSink *sink, const void *data, size_t size)
+        {
+            auto *state = static_cast<OutputSinkState *>(sink->ctx);
+            if (state->failed || (size > 0 && !data))
+            {
+                state->failed = true;
+                return 1;
+            }
+
+            // Never let an exception unwind into plugin code
+            try
+            {
+                if (state->in_memory)
+                {
+                    auto *bytes = static_cast<const uint8_t *>(data);
+                    state->buffer.insert(state->buffer.end(), bytes, bytes + size);
+                }
+                else if (!state->file.write(static_cast<const char *>(data),
+                                            static_cast<std::streamsize>(size)))
+                {
+                    state->failed = true;
+                    return 1;
+                }
+            }
+            catch (...)
+            {
+                state->failed = true;
+                return 1;
+            }
+            state->written += size;
+            return 0;
+        }
+
     } // anonymous namespace
 
     // NativePlugin implementation
 
     NativePlugin::NativePlugin(PluginManifest manifest, void *handle,
-                               void *info_func, void *execute_func, void *free_result_func)
-        : manifest_(std::move(manifest)), handle_(handle), info_func_(info_func), execute_func_(execute_func), free_result_func_(free_result_func)
+                               void *info_func, void *execute_func, void *free_result_func,
+                               void *execute_buffer_func)
+        : manifest_(std::move(manifest)), handle_(handle), info_func_(info_func), execute_func_(execute_func), free_result_func_(free_result_func), execute_buffer_func_(execute_buffer_func)
     {
     }
 
@@ -70,8 +110,82 @@ namespace uniconv::core
         unload();
     }
 
+    void NativePlugin::configure_threading(void *threading_func, void *create_context_func,
+                                           void *destroy_context_func)
+    {
+        if (!threading_func)
+        {
+            return;
+        }
+
+        auto threading_fn = reinterpret_cast<UniconvPluginThreadingFunc>(threading_func);
+        switch (threading_fn())
+        {
+        case UNICONV_THREADING_THREAD_SAFE:
+            threading_ = NativeThreading::ThreadSafe;
+            break;
+        case UNICONV_THREADING_CONTEXT:
+            if (!create_context_func || !destroy_context_func)
+            {
+                std::cerr << "Warning: native plugin '" << manifest_.name
+                          << "' declares context threading without context functions; "
+                          << "calls will be serialized" << std::endl;
+                break;
+            }
+            threading_ = NativeThreading::Context;
+            create_context_func_ = create_context_func;
+            destroy_context_func_ = destroy_context_func;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void *NativePlugin::acquire_context()
+    {
+        {
+            std::lock_guard<std::mutex> lock(contexts_mutex_);
+            if (!idle_contexts_.empty())
+            {
+                void *context = idle_contexts_.back();
+                idle_contexts_.pop_back();
+                return context;
+            }
+        }
+
+        // Create outside the lock; plugins may take a while to set up state
+        auto create_fn = reinterpret_cast<UniconvPluginCreateContextFunc>(create_context_func_);
+        void *context = create_fn();
+        if (context)
+        {
+            std::lock_guard<std::mutex> lock(contexts_mutex_);
+            contexts_.push_back(context);
+        }
+        return context;
+    }
+
+    void NativePlugin::release_context(void *context)
+    {
+        std::lock_guard<std::mutex> lock(contexts_mutex_);
+        idle_contexts_.push_back(context);
+    }
+
     void NativePlugin::unload()
     {
+        // Contexts belong to the library; destroy them while it is loaded
+        if (destroy_context_func_)
+        {
+            auto destroy_fn = reinterpret_cast<UniconvPluginDestroyContextFunc>(destroy_context_func_);
+            for (void *context : contexts_)
+            {
+                destroy_fn(context);
+            }
+        }
+        contexts_.clear();
+        idle_contexts_.clear();
+        create_context_func_ = nullptr;
+        destroy_context_func_ = nullptr;
+
         if (handle_)
         {
             NativePluginLoader::unload_library(handle_);
@@ -80,23 +194,33 @@ namespace uniconv::core
         info_func_ = nullptr;
         execute_func_ = nullptr;
         free_result_func_ = nullptr;
+        execute_buffer_func_ = nullptr;
     }
 
     PluginInfo NativePlugin::info() const
     {
-        if (info_cached_)
-        {
-            return cached_info_;
-        }
+        return cached_info();
+    }
+
+    const PluginInfo &NativePlugin::cached_info() const
+    {
+        // call_once publishes cached_info_ to every thread that gets past it
+        std::call_once(info_once_, [this]
+                       { load_info(); });
+        return cached_info_;
+    }
 
+    void NativePlugin::load_info() const
+    {
         // Call the plugin's info function
         auto info_fn = reinterpret_cast<UniconvPluginInfoFunc>(info_func_);
         UniconvPluginInfo *native_info = info_fn();
 
         if (!native_info)
         {
-            // Return info from manifest as fallback
-            return manifest_.to_plugin_info();
+            // Use info from manifest as fallback
+            cached_info_ = manifest_.to_plugin_info();
+            return;
         }
 
         // Convert to PluginInfo
@@ -108,6 +232,8 @@ namespace uniconv::core
         cached_info_.description = native_info->description ? native_info->description : manifest_.description;
         cached_info_.builtin = false;
         cached_info_.sink = manifest_.sink;
+        cached_info_.deterministic = manifest_.deterministic;
+        cached_info_.resources = manifest_.resources;
 
         // Copy targets (native plugins provide flat list, convert to map with empty extensions)
         if (native_info->targets)
@@ -131,18 +257,13 @@ namespace uniconv::core
         // else: stays nullopt → accept all
 
         cached_info_.options = manifest_.options;
-
-        info_cached_ = true;
-        return cached_info_;
     }
 
     bool NativePlugin::supports_target(const std::string &target) const
     {
-        auto plugin_info = info();
-        auto lower = to_lower(target);
-        for (const auto &[t, _] : plugin_info.targets)
+        for (const auto &[t, _] : cached_info().targets)
         {
-            if (to_lower(t) == lower)
+            if (utils::iequals(t, target))
             {
                 return true;
             }
@@ -152,26 +273,18 @@ namespace uniconv::core
 
     bool NativePlugin::supports_input(const std::string &format) const
     {
-        auto plugin_info = info();
+        const auto &accepts = cached_info().accepts;
 
         // nullopt (field omitted) → accept all
-        if (!plugin_info.accepts.has_value())
+        if (!accepts.has_value())
         {
             return true;
         }
 
-        const auto &formats = *plugin_info.accepts;
-
         // Empty array → accept nothing
-        if (formats.empty())
-        {
-            return false;
-        }
-
-        auto lower = to_lower(format);
-        for (const auto &f : formats)
+        for (const auto &f : *accepts)
         {
-            if (to_lower(f) == lower)
+            if (utils::iequals(f, format))
             {
                 return true;
             }
@@ -256,12 +369,96 @@ namespace uniconv::core
         native_req.get_plugin_option = get_plugin_option_impl;
         native_req.options_ctx = &opt_ctx;
 
+        // v4 plugins get single-file inputs as a buffer (in-memory data or
+        // the mapped source) and write through a sink; everything else, such
+        // as directories and generators, goes through the path entry point
+        bool use_buffers = execute_buffer_func_ && !request.source.empty() &&
+                           (request.input_data || std::filesystem::is_regular_file(request.source)) &&
+                           (request.output_in_memory || request.core_options.output);
+        if (request.input_data && !use_buffers)
+        {
+            return Result::failure(
+                request.target, request.source,
+                "Plugin cannot take in-memory input");
+        }
+
+        utils::MappedFile mapped_input;
+        OutputSinkState sink_state;
+        UniconvOutputSink sink{write_output_sink_impl, &sink_state};
+        UniconvBufferRequest buffer_req{};
+        if (use_buffers)
+        {
+            buffer_req.base = native_req;
+            if (request.input_data)
+            {
+                buffer_req.input.data = request.input_data->data();
+                buffer_req.input.size = request.input_data->size();
+            }
+            else if (mapped_input.open(request.source))
+            {
+                buffer_req.input.data = mapped_input.data();
+                buffer_req.input.size = mapped_input.size();
+            }
+            else
+            {
+                return Result::failure(
+                    request.target, request.source,
+                    "Cannot read input: " + request.source.string());
+            }
+
+            sink_state.in_memory = request.output_in_memory;
+            if (!sink_state.in_memory)
+            {
+                sink_state.file.open(*request.core_options.output, std::ios::binary | std::ios::trunc);
+                if (!sink_state.file)
+                {
+                    return Result::failure(
+                        request.target, request.source,
+                        "Cannot write output: " + request.core_options.output->string());
+                }
+            }
+            buffer_req.output = &sink;
+        }
+
+        // Honour the plugin's concurrency contract
+        std::unique_lock<std::mutex> execute_lock(execute_mutex_, std::defer_lock);
+        void *context = nullptr;
+        if (threading_ == NativeThreading::Serial)
+        {
+            execute_lock.lock();
+        }
+        else if (threading_ == NativeThreading::Context)
+        {
+            context = acquire_context();
+            if (!context)
+            {
+                return Result::failure(
+                    request.target, request.source,
+                    "Plugin failed to create a context");
+            }
+        }
+        native_req.context = context;
+        buffer_req.base.context = context;
+
         // Execute
-        auto execute_fn = reinterpret_cast<UniconvPluginExecuteFunc>(execute_func_);
-        UniconvResult *native_result = execute_fn(&native_req);
+        UniconvResult *native_result = nullptr;
+        if (use_buffers)
+        {
+            auto execute_fn = reinterpret_cast<UniconvPluginExecuteBufferFunc>(execute_buffer_func_);
+            native_result = execute_fn(&buffer_req);
+        }
+        else
+        {
+            auto execute_fn = reinterpret_cast<UniconvPluginExecuteFunc>(execute_func_);
+            native_result = execute_fn(&native_req);
+        }
 
         if (!native_result)
         {
+            if (context)
+            {
+                release_context(context);
+            }
             return Result::failure(
                 request.target, request.source,
                 "Plugin returned null result");
@@ -272,8 +469,8 @@ namespace uniconv::core
         result.target = request.target;
         result.plugin_used = manifest_.scope;
         result.input = request.source;
-        result.input_size = std::filesystem::is_directory(request.source)
-            ? 0 : std::filesystem::file_size(request.source);
+        result.input_size = request.input_data ? request.input_data->size()
+                                               : utils::regular_file_size(request.source);
 
         switch (native_result->status)
         {
@@ -317,6 +514,45 @@ namespace uniconv::core
             auto free_fn = reinterpret_cast<UniconvPluginFreeResultFunc>(free_result_func_);
             free_fn(native_result);
         }
+        if (execute_lock.owns_lock())
+        {
+            execute_lock.unlock();
+        }
+        if (context)
+        {
+            release_context(context);
+        }
+
+        // Buffer mode: the sink, not the plugin, determines the output
+        if (use_buffers)
+        {
+            if (!sink_state.in_memory)
+            {
+                sink_state.file.close();
+                if (sink_state.file.fail())
+                    sink_state.failed = true;
+            }
+            if (result.status == ResultStatus::Success && sink_state.failed)
+            {
+                result.status = ResultStatus::Error;
+                result.error = "Failed to write plugin output";
+            }
+
+            result.output = request.core_options.output;
+            if (result.status == ResultStatus::Success)
+            {
+                result.output_size = sink_state.written;
+                if (sink_state.in_memory)
+                {
+                    result.output_data = std::make_shared<const Buffer>(std::move(sink_state.buffer));
+                }
+            }
+            else if (!sink_state.in_memory)
+            {
+                std::error_code ec;
+                std::filesystem::remove(*request.core_options.output, ec);
+            }
+        }
 
         return result;
     }
@@ -385,6 +621,7 @@ namespace uniconv::core
         void *info_func = get_symbol(handle, UNICONV_PLUGIN_INFO_FUNC);
         void *execute_func = get_symbol(handle, UNICONV_PLUGIN_EXECUTE_FUNC);
         void *free_result_func = get_symbol(handle, UNICONV_PLUGIN_FREE_RESULT_FUNC);
+        void *execute_buffer_func = get_symbol(handle, UNICONV_PLUGIN_EXECUTE_BUFFER_FUNC);
 
         if (!info_func || !execute_func)
         {
@@ -400,8 +637,12 @@ namespace uniconv::core
 
         // Note: API version check removed - UniconvPluginInfo no longer has api_version field
 
-        return std::unique_ptr<plugins::IPlugin>(
-            new NativePlugin(manifest, handle, info_func, execute_func, free_result_func));
+        auto *plugin = new NativePlugin(manifest, handle, info_func, execute_func, free_result_func,
+                                        execute_buffer_func);
+        plugin->configure_threading(get_symbol(handle, UNICONV_PLUGIN_THREADING_FUNC),
+                                    get_symbol(handle, UNICONV_PLUGIN_CREATE_CONTEXT_FUNC),
+                                    get_symbol(handle, UNICONV_PLUGIN_DESTROY_CONTEXT_FUNC));
+        return std::unique_ptr<plugins::IPlugin>(plugin);
     }
 
     bool NativePluginLoader::is_native_plugin(const PluginManifest &manifest)
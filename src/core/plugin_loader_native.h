@@ -4,9 +4,18 @@
 #include "plugins/plugin_interface.h"
 #include <filesystem>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace uniconv::core {
 
+// How calls into a native plugin may overlap (uniconv_plugin_threading)
+enum class NativeThreading {
+    Serial,     // One call at a time (default)
+    ThreadSafe, // Calls may run concurrently
+    Context     // Concurrent calls, each with its own plugin context
+};
+
 // Native Plugin wrapper - adapts shared library to IPlugin interface
 class NativePlugin : public plugins::IPlugin {
 public:
@@ -17,6 +26,7 @@ public:
     bool supports_target(const std::string& target) const override;
     bool supports_input(const std::string& format) const override;
     Result execute(const Request& request) override;
+    bool supports_buffers() const override { return execute_buffer_func_ != nullptr; }
 
     // Get the manifest
     const PluginManifest& manifest() const { return manifest_; }
@@ -24,12 +34,16 @@ public:
     // Check if plugin is loaded
     bool is_loaded() const { return handle_ != nullptr; }
 
+    // Declared concurrency contract
+    NativeThreading threading() const { return threading_; }
+
 private:
     friend class NativePluginLoader;
 
     // Private constructor - use NativePluginLoader::load()
     NativePlugin(PluginManifest manifest, void* handle,
-                 void* info_func, void* execute_func, void* free_result_func);
+                 void* info_func, void* execute_func, void* free_result_func,
+                 void* execute_buffer_func = nullptr);
 
     PluginManifest manifest_;
     void* handle_ = nullptr;
@@ -38,10 +52,34 @@ private:
     void* info_func_ = nullptr;
     void* execute_func_ = nullptr;
     void* free_result_func_ = nullptr;
+    void* execute_buffer_func_ = nullptr; // Optional v4 buffer entry point
 
-    // Cached plugin info from the loaded library
+    // Plugin info from the loaded library, queried once; after that it is
+    // read without locking
     mutable PluginInfo cached_info_;
-    mutable bool info_cached_ = false;
+    mutable std::once_flag info_once_;
+    const PluginInfo& cached_info() const;
+    void load_info() const;
+
+    // Serializes calls into plugins that do not declare themselves
+    // thread-safe or context-based
+    NativeThreading threading_ = NativeThreading::Serial;
+    std::mutex execute_mutex_;
+
+    // Context-based plugins: one context per concurrently running call
+    void* create_context_func_ = nullptr;
+    void* destroy_context_func_ = nullptr;
+    std::mutex contexts_mutex_;
+    std::vector<void*> contexts_;      // Every context created
+    std::vector<void*> idle_contexts_; // Contexts not used by a running call
+
+    // Read the optional v4 threading exports (called by the loader)
+    void configure_threading(void* threading_func, void* create_context_func,
+                             void* destroy_context_func);
+
+    // Take an idle context or create one; nullptr if creation failed
+    void* acquire_context();
+    void release_context(void* context);
 
     void unload();
 };
@@ -3,6 +3,7 @@
 #include "plugin_loader_cli.h"
 #include "plugin_loader_native.h"
 #include "utils/file_utils.h"
+#include "utils/string_utils.h"
 #include <algorithm>
 
 namespace uniconv::core
@@ -25,6 +26,7 @@ namespace uniconv::core
         : dep_installer_(ConfigManager::get_default_config_dir() / "deps")
     {
         register_builtin_plugins();
+        publish();
     }
 
     void PluginManager::register_builtin_plugins()
@@ -32,19 +34,117 @@ namespace uniconv::core
         // All plugins are now external (loaded via load_external_plugins)
     }
 
+    void PluginManager::publish()
+    {
+        resolver_.index(plugins_);
+        std::unique_ptr<const Snapshot> snapshot(new Snapshot{resolver_, preloaded_});
+        snapshot_.store(snapshot.get());
+        if (current_)
+        {
+            retired_.push_back(std::move(current_));
+            has_retired_ = true;
+        }
+        current_ = std::move(snapshot);
+        reclaim();
+    }
+
+    void PluginManager::reclaim()
+    {
+        // Sequentially consistent with the reader count: a lookup not
+        // counted yet will load the snapshot published above
+        if (!retired_.empty() && readers_.load() == 0)
+        {
+            retired_.clear();
+            has_retired_ = false;
+        }
+    }
+
+    PluginManager::SnapshotReader::SnapshotReader(PluginManager &manager)
+        : manager_(manager)
+    {
+        ++manager_.readers_;
+        snapshot_ = manager_.snapshot_.load();
+    }
+
+    PluginManager::SnapshotReader::~SnapshotReader()
+    {
+        // The last lookup out frees what was retired while it read; if the
+        // lock is busy, the next publish() does
+        if (--manager_.readers_ == 0 && manager_.has_retired_)
+        {
+            std::unique_lock<std::recursive_mutex> lock(manager_.mutex_, std::try_to_lock);
+            if (lock.owns_lock())
+            {
+                manager_.reclaim();
+            }
+        }
+    }
+
+    size_t PluginManager::retained_snapshots() const
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return retired_.size() + (current_ ? 1 : 0);
+    }
+
     void PluginManager::ensure_discovered() const
     {
         if (discovered_)
             return;
         manifests_ = discovery_.discover_all();
+        // Manifests found through the index are plugins already
+        manifests_.erase(std::remove_if(manifests_.begin(), manifests_.end(),
+                                        [this](const PluginManifest &m)
+                                        { return loads_.count(m.manifest_path) > 0; }),
+                         manifests_.end());
         discovered_ = true;
     }
 
-    void PluginManager::load_matching(const ResolutionContext &context)
+    std::unique_ptr<plugins::IPlugin> PluginManager::load_manifest(const PluginManifest &manifest) const
     {
+        std::unique_ptr<plugins::IPlugin> plugin;
+
+        if (CLIPluginLoader::is_cli_plugin(manifest))
+        {
+            plugin = CLIPluginLoader::load(manifest);
+            // Set dependency environment for CLI plugins
+            if (auto *cp = dynamic_cast<CLIPlugin *>(plugin.get()))
+            {
+                cp->set_dep_environment(dep_installer_.get_env(manifest.name));
+            }
+        }
+        else if (NativePluginLoader::is_native_plugin(manifest))
+        {
+            plugin = NativePluginLoader::load(manifest);
+        }
+
+        return plugin;
+    }
+
+    std::vector<PluginManifest> PluginManager::find_matching(const ResolutionContext &context)
+    {
+        // Until something needs every manifest, the index finds the
+        // matching ones without decoding the rest
+        if (!discovered_ && discovery_.has_index())
+        {
+            return discovery_.discover_matching(context.target, context.explicit_plugin);
+        }
+
         ensure_discovered();
 
-        auto target = to_lower(context.target);
+        // Explicit plugin (scope/plugin:target syntax): "scope/name" or "name"
+        std::string_view ep_scope, ep_name;
+        if (context.explicit_plugin)
+        {
+            ep_name = *context.explicit_plugin;
+            auto slash_pos = ep_name.find('/');
+            if (slash_pos != std::string_view::npos)
+            {
+                ep_scope = ep_name.substr(0, slash_pos);
+                ep_name = ep_name.substr(slash_pos + 1);
+            }
+        }
+
+        std::vector<PluginManifest> result;
         auto it = manifests_.begin();
         while (it != manifests_.end())
         {
@@ -53,66 +153,112 @@ namespace uniconv::core
             // Match by target
             for (const auto &[t, _] : it->targets)
             {
-                if (to_lower(t) == target)
+                if (utils::iequals(t, context.target))
                 {
                     matches = true;
                     break;
                 }
             }
 
-            // Match by explicit plugin (scope/plugin:target syntax)
+            // Match by explicit plugin
             if (!matches && context.explicit_plugin)
             {
-                auto ep = to_lower(*context.explicit_plugin);
-                auto slash_pos = ep.find('/');
-                if (slash_pos != std::string::npos)
-                {
-                    // scope/name format (e.g., "geo/postgis")
-                    auto ep_scope = ep.substr(0, slash_pos);
-                    auto ep_name = ep.substr(slash_pos + 1);
-                    if (to_lower(it->scope) == ep_scope && to_lower(it->name) == ep_name)
-                        matches = true;
-                }
-                else
-                {
-                    // name-only format (e.g., "postgis")
-                    if (to_lower(it->name) == ep)
-                        matches = true;
-                }
+                matches = utils::iequals(it->name, ep_name) &&
+                          (ep_scope.empty() || utils::iequals(it->scope, ep_scope));
             }
 
             if (matches)
             {
-                std::unique_ptr<plugins::IPlugin> plugin;
+                result.push_back(std::move(*it));
+                it = manifests_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return result;
+    }
 
-                if (CLIPluginLoader::is_cli_plugin(*it))
+    void PluginManager::load_matching(const ResolutionContext &context)
+    {
+        std::vector<std::pair<PluginManifest, std::promise<void>>> claimed;
+        std::vector<std::shared_future<void>> waits;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+            // A context loads everything it matches the first time, so
+            // asking again (the same stage for the next file) only waits
+            // for those loads
+            uint64_t key = uint64_t{match_symbols_.intern(context.target)} << 32 |
+                           (context.explicit_plugin ? match_symbols_.intern(*context.explicit_plugin)
+                                                    : utils::SymbolTable::kNone);
+            if (auto it = matched_.find(key); it != matched_.end())
+            {
+                waits = it->second;
+            }
+            else
+            {
+                for (auto &manifest : find_matching(context))
                 {
-                    plugin = CLIPluginLoader::load(*it);
-                    if (auto *cp = dynamic_cast<CLIPlugin *>(plugin.get()))
+                    auto [load, added] = loads_.try_emplace(manifest.manifest_path);
+                    if (added)
                     {
-                        cp->set_dep_environment(dep_installer_.get_env(it->name));
+                        claimed.emplace_back(std::move(manifest), std::promise<void>());
+                        load->second = claimed.back().second.get_future().share();
                     }
+                    waits.push_back(load->second);
                 }
-                else if (NativePluginLoader::is_native_plugin(*it))
-                {
-                    plugin = NativePluginLoader::load(*it);
-                }
+                matched_.emplace(key, waits);
+            }
+        }
 
-                if (plugin)
+        // Load the plugins this call claimed without holding the lock, and
+        // finish them before waiting on anyone else's
+        if (!claimed.empty())
+        {
+            std::vector<std::unique_ptr<plugins::IPlugin>> loaded;
+            for (const auto &[manifest, _] : claimed)
+            {
+                loaded.push_back(load_manifest(manifest));
+            }
+            {
+                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                for (auto &plugin : loaded)
                 {
-                    register_plugin(std::move(plugin));
+                    if (plugin)
+                    {
+                        plugins_.push_back(std::move(plugin));
+                    }
                 }
-                it = manifests_.erase(it);
+                publish();
             }
-            else
+            for (auto &[_, done] : claimed)
             {
-                ++it;
+                done.set_value();
+            }
+        }
+        for (const auto &load : waits)
+        {
+            load.wait();
+        }
+
+        // Every plugin for the target is loaded now; auto-fastest can rank
+        // it from the snapshot alone
+        if (!context.explicit_plugin)
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            if (preloaded_.find(context.target) == utils::SymbolTable::kNone)
+            {
+                preloaded_.intern(context.target);
+                publish();
             }
         }
     }
 
     void PluginManager::load_external_plugins()
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (external_loaded_)
         {
             return; // Already loaded
@@ -122,72 +268,44 @@ namespace uniconv::core
 
         for (const auto &manifest : manifests_)
         {
-            std::unique_ptr<plugins::IPlugin> plugin;
-
-            if (CLIPluginLoader::is_cli_plugin(manifest))
+            if (auto plugin = load_manifest(manifest))
             {
-                plugin = CLIPluginLoader::load(manifest);
-                // Set dependency environment for CLI plugins
-                if (auto* cli_plugin = dynamic_cast<CLIPlugin*>(plugin.get()))
-                {
-                    auto dep_env = dep_installer_.get_env(manifest.name);
-                    cli_plugin->set_dep_environment(dep_env);
-                }
-            }
-            else if (NativePluginLoader::is_native_plugin(manifest))
-            {
-                plugin = NativePluginLoader::load(manifest);
-            }
-
-            if (plugin)
-            {
-                register_plugin(std::move(plugin));
+                plugins_.push_back(std::move(plugin));
             }
         }
 
         manifests_.clear();
         external_loaded_ = true;
+        publish();
     }
 
     void PluginManager::load_plugins_from_dir(const std::filesystem::path &dir)
     {
-        auto manifests = discovery_.discover_in_dir(dir);
-        for (const auto &manifest : manifests)
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        for (const auto &manifest : discovery_.discover_in_dir(dir))
         {
-            std::unique_ptr<plugins::IPlugin> plugin;
-
-            if (CLIPluginLoader::is_cli_plugin(manifest))
-            {
-                plugin = CLIPluginLoader::load(manifest);
-                // Set dependency environment for CLI plugins
-                if (auto* cli_plugin = dynamic_cast<CLIPlugin*>(plugin.get()))
-                {
-                    auto dep_env = dep_installer_.get_env(manifest.name);
-                    cli_plugin->set_dep_environment(dep_env);
-                }
-            }
-            else if (NativePluginLoader::is_native_plugin(manifest))
-            {
-                plugin = NativePluginLoader::load(manifest);
-            }
-
-            if (plugin)
+            if (auto plugin = load_manifest(manifest))
             {
-                register_plugin(std::move(plugin));
+                plugins_.push_back(std::move(plugin));
             }
         }
+        publish();
     }
 
     void PluginManager::add_plugin_dir(const std::filesystem::path &dir)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         discovery_.add_plugin_dir(dir);
+        matched_.clear();
     }
 
     void PluginManager::register_plugin(std::unique_ptr<plugins::IPlugin> plugin)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (plugin)
         {
             plugins_.push_back(std::move(plugin));
+            publish();
         }
     }
 
@@ -207,20 +325,35 @@ namespace uniconv::core
     // Find plugin with full resolution context (new enhanced method)
     plugins::IPlugin *PluginManager::find_plugin(const ResolutionContext &context)
     {
-        ensure_discovered();
+        return resolve(context).plugin;
+    }
 
-        // Try already-loaded plugins first
-        auto result = resolver_.resolve(context, plugins_);
-        if (result.plugin)
-            return result.plugin;
+    ResolutionResult PluginManager::resolve(const ResolutionContext &context)
+    {
+        // Lock-free: resolve against the current snapshot, and take the
+        // loading path only when it has no answer
+        {
+            SnapshotReader snapshot(*this);
+
+            // Auto-fastest compares every compatible plugin, so load them all
+            // up front instead of stopping at the first loaded match
+            bool preload = snapshot->resolver.policy() == ResolutionPolicy::AutoFastest &&
+                           !context.explicit_plugin &&
+                           snapshot->preloaded.find(context.target) == utils::SymbolTable::kNone;
+            if (!preload)
+            {
+                auto result = snapshot->resolver.resolve(context);
+                if (result.plugin)
+                    return result;
+            }
+        }
 
         // Load matching manifests and try again
         load_matching(context);
-        result = resolver_.resolve(context, plugins_);
-        return result.plugin;
+        SnapshotReader snapshot(*this);
+        return snapshot->resolver.resolve(context);
     }
 
-    // Find plugin for input format and target (backward compatible)
     plugins::IPlugin *PluginManager::find_plugin_for_input(
         const std::string &input_format,
         const std::string &target)
@@ -242,6 +375,7 @@ namespace uniconv::core
 
     std::vector<PluginInfo> PluginManager::list_plugins() const
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         ensure_discovered();
 
         std::vector<PluginInfo> result;
@@ -259,6 +393,7 @@ namespace uniconv::core
 
     std::vector<PluginInfo> PluginManager::list_plugins_for_target(const std::string &target) const
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         ensure_discovered();
 
         auto lower_target = to_lower(target);
@@ -274,7 +409,7 @@ namespace uniconv::core
         {
             for (const auto &[t, _] : m.targets)
             {
-                if (to_lower(t) == lower_target)
+                if (utils::iequals(t, lower_target))
                 {
                     result.push_back(m.to_plugin_info());
                     break;
@@ -286,6 +421,7 @@ namespace uniconv::core
 
     std::unordered_set<std::string> PluginManager::known_formats() const
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         ensure_discovered();
 
         std::unordered_set<std::string> formats;
@@ -325,11 +461,28 @@ namespace uniconv::core
 
     void PluginManager::set_default(const std::string &target, const std::string &plugin_scope)
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         resolver_.set_default(target, plugin_scope);
+        publish();
+    }
+
+    void PluginManager::set_policy(ResolutionPolicy policy)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        resolver_.set_policy(policy);
+        publish();
+    }
+
+    void PluginManager::set_stats(std::shared_ptr<const PerfStats> stats)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        resolver_.set_stats(std::move(stats));
+        publish();
     }
 
     std::optional<std::string> PluginManager::get_default(const std::string &target) const
     {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return resolver_.get_default(target);
     }
 
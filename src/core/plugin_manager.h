@@ -5,17 +5,25 @@
 #include "core/plugin_discovery.h"
 #include "core/plugin_resolver.h"
 #include "plugins/plugin_interface.h"
+#include "utils/symbol_table.h"
+#include <atomic>
 #include <filesystem>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace uniconv::core
 {
 
+    // Registry of the available plugins, safe to share between threads.
+    // Lookups resolve against an immutable snapshot without locking; only
+    // loading plugins, listing and changing settings take the lock.
     class PluginManager
     {
     public:
@@ -52,6 +60,9 @@ namespace uniconv::core
         // Uses PluginResolver for intelligent matching based on input format, type, and target
         plugins::IPlugin *find_plugin(const ResolutionContext &context);
 
+        // Like find_plugin, with the reasoning behind the choice (--why)
+        ResolutionResult resolve(const ResolutionContext &context);
+
         // Find plugin that can handle a specific input format and target (backward compatible)
         plugins::IPlugin *find_plugin_for_input(
             const std::string &input_format,
@@ -73,21 +84,90 @@ namespace uniconv::core
         void set_default(const std::string &target, const std::string &plugin_scope);
         std::optional<std::string> get_default(const std::string &target) const;
 
+        // Resolution policy and the performance history auto-fastest ranks by
+        void set_policy(ResolutionPolicy policy);
+        void set_stats(std::shared_ptr<const PerfStats> stats);
+
+        // Snapshots still allocated: the current one plus any replaced
+        // ones a lookup may still be reading
+        size_t retained_snapshots() const;
+
     private:
+        // What lookups see: a resolver indexed over the loaded plugins.
+        // Published snapshots are never modified; changes publish a new one.
+        struct Snapshot
+        {
+            PluginResolver resolver;
+            utils::SymbolTable preloaded; // Targets with every matching manifest loaded
+        };
+
         std::vector<std::unique_ptr<plugins::IPlugin>> plugins_;
-        PluginResolver resolver_;
+        PluginResolver resolver_; // Indexed over plugins_; copied into each snapshot
+        utils::SymbolTable preloaded_;
         PluginDiscovery discovery_;
         DependencyInstaller dep_installer_;
         bool external_loaded_ = false;
 
+        // Lookups read the current snapshot without locking, counted in
+        // readers_ while they use it. A replaced snapshot is retired and
+        // freed as soon as no lookup is in flight, so at most the current
+        // one outlives a quiet moment.
+        std::atomic<const Snapshot *> snapshot_{nullptr};
+        std::atomic<size_t> readers_{0};
+        std::atomic<bool> has_retired_{false};
+        std::unique_ptr<const Snapshot> current_;              // Owns snapshot_ (under mutex_)
+        std::vector<std::unique_ptr<const Snapshot>> retired_; // Under mutex_
+
+        // Guards everything but the current snapshot: plugins_, the
+        // resolver settings and the lazy discovery state
+        mutable std::recursive_mutex mutex_;
+
         // Lazy discovery state
         mutable std::vector<PluginManifest> manifests_;
         mutable bool discovered_ = false;
 
+        // Manifests load_matching has claimed. Each is loaded once, outside
+        // mutex_, by the call that claimed it; lookups needing the same
+        // plugin wait for that load and no other.
+        std::map<std::filesystem::path, std::shared_future<void>> loads_;
+
+        // Contexts load_matching has served, as interned (target,
+        // explicit plugin) pairs, with the loads they wait for
+        utils::SymbolTable match_symbols_;
+        std::unordered_map<uint64_t, std::vector<std::shared_future<void>>> matched_;
+
+        // Index plugins_ and make the result the current snapshot (under mutex_)
+        void publish();
+
+        // Free the retired snapshots if no lookup is in flight (under mutex_)
+        void reclaim();
+
+        // Counts a lookup in readers_ for as long as it uses a snapshot
+        class SnapshotReader
+        {
+        public:
+            explicit SnapshotReader(PluginManager &manager);
+            ~SnapshotReader();
+            SnapshotReader(const SnapshotReader &) = delete;
+            SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+            const Snapshot *operator->() const { return snapshot_; }
+
+        private:
+            PluginManager &manager_;
+            const Snapshot *snapshot_;
+        };
+
         // Scan plugin dirs and store manifests (lazy, first-access)
         void ensure_discovered() const;
 
-        // Load only manifests matching a resolution context
+        // The plugin a manifest describes; nullptr if it cannot be loaded
+        std::unique_ptr<plugins::IPlugin> load_manifest(const PluginManifest &manifest) const;
+
+        // Manifests matching a resolution context (under mutex_)
+        std::vector<PluginManifest> find_matching(const ResolutionContext &context);
+
+        // Load the manifests matching a resolution context
         void load_matching(const ResolutionContext &context);
     };
 
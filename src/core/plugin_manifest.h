@@ -38,6 +38,34 @@ namespace uniconv::core
         return std::nullopt;
     }
 
+    // How uniconv talks to a CLI plugin
+    enum class PluginProtocol
+    {
+        Exec,  // One process per request, arguments on the command line
+        Worker // Long-lived process exchanging NDJSON over stdin/stdout
+    };
+
+    inline std::string plugin_protocol_to_string(PluginProtocol protocol)
+    {
+        switch (protocol)
+        {
+        case PluginProtocol::Exec:
+            return "exec";
+        case PluginProtocol::Worker:
+            return "worker";
+        }
+        return "unknown";
+    }
+
+    inline std::optional<PluginProtocol> plugin_protocol_from_string(const std::string &s)
+    {
+        if (s == "exec")
+            return PluginProtocol::Exec;
+        if (s == "worker")
+            return PluginProtocol::Worker;
+        return std::nullopt;
+    }
+
     // Plugin dependency definition (from manifest)
     struct Dependency
     {
@@ -89,6 +117,8 @@ namespace uniconv::core
         std::map<std::string, std::vector<std::string>> targets; // Supported output targets → extensions
         std::optional<std::vector<std::string>> accepts; // nullopt=accept all, empty=accept nothing, values=accept listed
         bool sink = false;                      // Sink plugin: owns output, uniconv skips finalization
+        bool deterministic = true;              // Same input + options always give the same output (cacheable)
+        ResourceHints resources;                // Expected memory / threads per conversion
         std::map<std::string, std::vector<std::string>> target_input_formats; // Per-target input format overrides
 
         // Data types
@@ -100,6 +130,11 @@ namespace uniconv::core
         std::string executable; // For CLI: executable name or path
         std::string library;    // For Native: library filename
 
+        // CLI protocol (worker mode keeps processes alive between requests)
+        PluginProtocol protocol = PluginProtocol::Exec;
+        int workers = 1;           // Max concurrent worker processes
+        int idle_timeout = 60;     // Seconds before an idle worker is shut down
+
         // Options
         std::vector<PluginOptionDef> options;
 
@@ -130,11 +165,21 @@ namespace uniconv::core
                 j["accepts"] = *accepts;
             if (sink)
                 j["sink"] = true;
+            if (!deterministic)
+                j["deterministic"] = false;
+            if (!resources.is_default())
+                j["resources"] = resources.to_json();
             j["interface"] = plugin_interface_to_string(iface);
             if (!executable.empty())
                 j["executable"] = executable;
             if (!library.empty())
                 j["library"] = library;
+            if (protocol != PluginProtocol::Exec)
+            {
+                j["protocol"] = plugin_protocol_to_string(protocol);
+                j["workers"] = workers;
+                j["idle_timeout"] = idle_timeout;
+            }
 
             if (!options.empty())
             {
@@ -213,6 +258,14 @@ namespace uniconv::core
             // Sink flag
             m.sink = j.value("sink", false);
 
+            // Non-deterministic plugins opt out of the conversion cache
+            m.deterministic = j.value("deterministic", true);
+
+            if (j.contains("resources") && j.at("resources").is_object())
+            {
+                m.resources = ResourceHints::from_json(j.at("resources"));
+            }
+
             if (j.contains("target_input_formats") && j.at("target_input_formats").is_object())
             {
                 m.target_input_formats = j.at("target_input_formats").get<std::map<std::string, std::vector<std::string>>>();
@@ -225,6 +278,26 @@ namespace uniconv::core
             m.executable = j.value("executable", "");
             m.library = j.value("library", "");
 
+            // Data types (unknown names are ignored)
+            auto parse_types = [&j](const char *key, std::vector<DataType> &out)
+            {
+                if (!j.contains(key) || !j.at(key).is_array())
+                    return;
+                for (const auto &t : j.at(key))
+                {
+                    if (auto type = data_type_from_string(t.get<std::string>()))
+                        out.push_back(*type);
+                }
+            };
+            parse_types("input_types", m.input_types);
+            parse_types("output_types", m.output_types);
+
+            // Protocol (CLI plugins only)
+            auto protocol_str = j.value("protocol", "exec");
+            m.protocol = plugin_protocol_from_string(protocol_str).value_or(PluginProtocol::Exec);
+            m.workers = j.value("workers", 1);
+            m.idle_timeout = j.value("idle_timeout", 60);
+
             // Options
             if (j.contains("options") && j.at("options").is_array())
             {
@@ -256,6 +329,8 @@ namespace uniconv::core
             info.targets = targets;
             info.accepts = accepts;
             info.sink = sink;
+            info.deterministic = deterministic;
+            info.resources = resources;
             info.input_types = input_types;
             info.output_types = output_types;
             info.version = version;
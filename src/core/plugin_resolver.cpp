@@ -1,4 +1,5 @@
 #include "plugin_resolver.h"
+#include "utils/string_utils.h"
 #include <algorithm>
 
 namespace uniconv::core
@@ -15,69 +16,249 @@ namespace uniconv::core
             return s;
         }
 
+        // Data types describing content; Stream is a transport capability
+        std::vector<DataType> content_types(const std::vector<DataType> &types)
+        {
+            std::vector<DataType> result;
+            for (auto t : types)
+            {
+                if (t != DataType::Stream)
+                    result.push_back(t);
+            }
+            return result;
+        }
+
     } // anonymous namespace
 
-    ResolutionResult PluginResolver::resolve(
-        const ResolutionContext &context,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
+    std::optional<ResolutionPolicy> resolution_policy_from_string(const std::string &name)
+    {
+        auto lower = to_lower(name);
+        if (lower == "ordered")
+            return ResolutionPolicy::Ordered;
+        if (lower == "auto-fastest")
+            return ResolutionPolicy::AutoFastest;
+        return std::nullopt;
+    }
+
+    size_t PluginResolver::ResolutionKeyHash::operator()(const ResolutionKey &key) const
+    {
+        size_t hash = key.target;
+        hash = hash * 1000003 ^ key.input_format;
+        hash = hash * 1000003 ^ key.explicit_plugin;
+        hash = hash * 1000003 ^ key.has_explicit;
+        hash = hash * 1000003 ^ key.input_types;
+        return hash;
+    }
+
+    PluginResolver::PluginResolver(const PluginResolver &other)
+        : defaults_(other.defaults_),
+          policy_(other.policy_),
+          stats_(other.stats_),
+          symbols_(other.symbols_),
+          indexed_list_(other.indexed_list_),
+          indexed_(other.indexed_),
+          by_target_(other.by_target_)
+    {
+    }
+
+    ResolutionResult PluginResolver::resolve(const ResolutionContext &context) const
+    {
+        // Entries are neither changed nor erased once added (only the
+        // unsynchronized setters clear the memo) and references into an
+        // unordered_map survive rehashing, so they are read unlocked
+        auto key = make_key(context);
+        const Resolution *resolution = nullptr;
+        {
+            std::shared_lock<std::shared_mutex> lock(memo_mutex_);
+            if (auto it = memo_.find(key); it != memo_.end())
+            {
+                resolution = &it->second;
+            }
+        }
+        if (!resolution)
+        {
+            auto computed = compute(context);
+            std::unique_lock<std::shared_mutex> lock(memo_mutex_);
+            resolution = &memo_.emplace(key, std::move(computed)).first->second;
+        }
+
+        if (!resolution->rank.empty())
+        {
+            return rank_fastest(context, resolution->rank, resolution->result.matched_by);
+        }
+        return resolution->result;
+    }
+
+    void PluginResolver::index(const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins)
+    {
+        bool same_list = indexed_list_ == &plugins && indexed_.size() <= plugins.size() &&
+                         (indexed_.empty() || indexed_.back().plugin == plugins[indexed_.size() - 1].get());
+        if (!same_list)
+        {
+            indexed_list_ = &plugins;
+            indexed_.clear();
+            by_target_.clear();
+            memo_.clear();
+        }
+        if (indexed_.size() == plugins.size())
+        {
+            return;
+        }
+
+        memo_.clear();
+        symbols_.intern("");
+        for (size_t pos = indexed_.size(); pos < plugins.size(); ++pos)
+        {
+            IndexedPlugin entry{plugins[pos].get(), plugins[pos]->info()};
+            for (const auto &[target, _] : entry.info.targets)
+            {
+                auto id = symbols_.intern(target);
+                if (id >= by_target_.size())
+                {
+                    by_target_.resize(id + 1);
+                }
+                auto &positions = by_target_[id];
+                // Targets differing only in case list a plugin once
+                if (positions.empty() || positions.back() != pos)
+                {
+                    positions.push_back(static_cast<uint32_t>(pos));
+                }
+            }
+            // Everything else a context can name
+            for (const auto &format : entry.info.accepts.value_or(std::vector<std::string>{}))
+            {
+                symbols_.intern(format);
+            }
+            symbols_.intern(entry.info.name);
+            symbols_.intern(entry.info.scope + "/" + entry.info.name);
+            indexed_.push_back(std::move(entry));
+        }
+    }
+
+    const PluginResolver::Positions &PluginResolver::candidates(Id target) const
+    {
+        static const Positions none;
+        return target < by_target_.size() ? by_target_[target] : none;
+    }
+
+    PluginResolver::ResolutionKey PluginResolver::make_key(const ResolutionContext &context) const
+    {
+        ResolutionKey key;
+        key.target = symbols_.find(context.target);
+        key.input_format = symbols_.find(context.input_format);
+        if (context.explicit_plugin)
+        {
+            key.explicit_plugin = symbols_.find(*context.explicit_plugin);
+            key.has_explicit = true;
+        }
+        for (auto type : context.input_types)
+        {
+            key.input_types |= 1u << static_cast<uint32_t>(type);
+        }
+        return key;
+    }
+
+    template <typename Accepts>
+    PluginResolver::Positions PluginResolver::find_in(Id target, bool all, Accepts &&accepts) const
     {
+        Positions found;
+        for (auto pos : candidates(target))
+        {
+            if (accepts(indexed_[pos]))
+            {
+                found.push_back(pos);
+                if (!all)
+                    break;
+            }
+        }
+        return found;
+    }
+
+    PluginResolver::Resolution PluginResolver::compute(const ResolutionContext &original) const
+    {
+        auto context = original;
+        context.target = to_lower(context.target);
+        context.input_format = to_lower(context.input_format);
+        auto target = symbols_.find(context.target);
+
         // Priority 1: Explicit plugin (scope/plugin:target syntax)
         // If specified but not found, fail immediately — don't fall through
         if (context.explicit_plugin)
         {
-            if (auto *p = find_by_explicit(*context.explicit_plugin, context.target, plugins))
+            if (auto *p = find_by_explicit(*context.explicit_plugin, context.target, target))
             {
-                return {p, "explicit"};
+                return {{p, "explicit", {}}, {}};
             }
-            return {nullptr, "explicit_not_found"};
+            return {{nullptr, "explicit_not_found", {}}, {}};
         }
 
         // Priority 2: Default plugin for target
-        if (auto *p = find_by_default(context.target, plugins))
+        if (auto *p = find_by_default(context.target, target))
         {
-            return {p, "default"};
+            return {{p, "default", {}}, {}};
+        }
+
+        // Auto-fastest: rank all plugins of the first matching tier below
+        if (policy_ == ResolutionPolicy::AutoFastest)
+        {
+            std::string tier;
+            auto matches = fastest_tier(context, target, tier);
+            if (matches.empty())
+            {
+                return {{nullptr, "none", {}}, {}};
+            }
+            return {{nullptr, tier, {}}, std::move(matches)};
         }
 
         // Priority 3: Type compatible + Format matching (NEW)
         // Only use this if we have input information
         if (!context.input_format.empty())
         {
-            if (auto *p = find_by_type_and_format(context, plugins))
+            auto found = find_in(target, false, [&](const IndexedPlugin &p)
+                                 { return accepts_type_and_format(p, context); });
+            if (!found.empty())
             {
-                return {p, "type+format"};
+                return {{indexed_[found.front()].plugin, "type+format", {}}, {}};
             }
         }
 
         // Priority 4: Type compatible only
         if (!context.input_types.empty())
         {
-            if (auto *p = find_by_type_only(context, plugins))
+            auto found = find_in(target, false, [&](const IndexedPlugin &p)
+                                 { return accepts_type(p, context); });
+            if (!found.empty())
             {
-                return {p, "type"};
+                return {{indexed_[found.front()].plugin, "type", {}}, {}};
             }
         }
 
         // Priority 5: Target only (fallback)
-        if (auto *p = find_by_target_only(context.target, plugins))
+        auto found = find_in(target, false, [&](const IndexedPlugin &p)
+                             { return p.plugin->supports_target(context.target); });
+        if (!found.empty())
         {
-            return {p, "target"};
+            return {{indexed_[found.front()].plugin, "target", {}}, {}};
         }
 
-        return {nullptr, "none"};
+        return {{nullptr, "none", {}}, {}};
     }
 
     bool PluginResolver::can_connect(const PluginInfo &from, const PluginInfo &to) const
     {
+        auto from_types = content_types(from.output_types);
+        auto to_types = content_types(to.input_types);
+
         // If either plugin doesn't specify types, assume File type (always compatible)
-        if (from.output_types.empty() || to.input_types.empty())
+        if (from_types.empty() || to_types.empty())
         {
             return true;
         }
 
         // Check if any output type from 'from' matches any input type in 'to'
-        for (const auto &out_type : from.output_types)
+        for (const auto &out_type : from_types)
         {
-            for (const auto &in_type : to.input_types)
+            for (const auto &in_type : to_types)
             {
                 if (out_type == in_type ||
                     out_type == DataType::File ||
@@ -94,6 +275,19 @@ namespace uniconv::core
     void PluginResolver::set_default(const std::string &target, const std::string &plugin_scope)
     {
         defaults_[to_lower(target)] = to_lower(plugin_scope);
+        memo_.clear();
+    }
+
+    void PluginResolver::set_policy(ResolutionPolicy policy)
+    {
+        policy_ = policy;
+        memo_.clear();
+    }
+
+    void PluginResolver::set_stats(std::shared_ptr<const PerfStats> stats)
+    {
+        stats_ = std::move(stats);
+        memo_.clear();
     }
 
     std::optional<std::string> PluginResolver::get_default(const std::string &target) const
@@ -109,154 +303,171 @@ namespace uniconv::core
     plugins::IPlugin *PluginResolver::find_by_explicit(
         const std::string &plugin_specifier,
         const std::string &target,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
+        Id target_id) const
     {
-        auto lower_spec = to_lower(plugin_specifier);
-        auto lower_target = to_lower(target);
-
         // Check if specifier contains / (scope/name format)
-        auto slash_pos = lower_spec.find('/');
-        std::string match_scope, match_name;
-        if (slash_pos != std::string::npos)
-        {
-            // scope/name: match both scope and name
-            match_scope = lower_spec.substr(0, slash_pos);
-            match_name = lower_spec.substr(slash_pos + 1);
-        }
+        std::string_view spec = plugin_specifier;
+        auto slash_pos = spec.find('/');
 
-        for (const auto &plugin : plugins)
+        for (auto pos : candidates(target_id))
         {
-            auto info = plugin->info();
+            const auto &[plugin, info] = indexed_[pos];
             bool plugin_match;
-            if (!match_name.empty())
+            if (slash_pos != std::string_view::npos)
             {
                 // scope/name: match both scope and name
-                plugin_match = to_lower(info.scope) == match_scope &&
-                               to_lower(info.name) == match_name;
+                plugin_match = utils::iequals(info.scope, spec.substr(0, slash_pos)) &&
+                               utils::iequals(info.name, spec.substr(slash_pos + 1));
             }
             else
             {
                 // name-only: match by plugin name
-                plugin_match = to_lower(info.name) == lower_spec;
+                plugin_match = utils::iequals(info.name, spec);
             }
 
-            if (plugin_match && plugin->supports_target(lower_target))
+            if (plugin_match && plugin->supports_target(target))
             {
-                return plugin.get();
+                return plugin;
             }
         }
         return nullptr;
     }
 
-    plugins::IPlugin *PluginResolver::find_by_default(
-        const std::string &target,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
+    plugins::IPlugin *PluginResolver::find_by_default(const std::string &target, Id target_id) const
     {
-        auto lower_target = to_lower(target);
-        auto default_it = defaults_.find(lower_target);
+        auto default_it = defaults_.find(target);
 
         if (default_it != defaults_.end())
         {
-            for (const auto &plugin : plugins)
+            for (auto pos : candidates(target_id))
             {
-                auto info = plugin->info();
-                if (to_lower(info.scope) == default_it->second &&
-                    plugin->supports_target(lower_target))
+                const auto &[plugin, info] = indexed_[pos];
+                if (utils::iequals(info.scope, default_it->second) &&
+                    plugin->supports_target(target))
                 {
-                    return plugin.get();
+                    return plugin;
                 }
             }
         }
         return nullptr;
     }
 
-    plugins::IPlugin *PluginResolver::find_by_type_and_format(
-        const ResolutionContext &context,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
+    bool PluginResolver::accepts_type_and_format(const IndexedPlugin &plugin,
+                                                 const ResolutionContext &context) const
     {
-        auto lower_target = to_lower(context.target);
-        auto lower_input = to_lower(context.input_format);
-
-        for (const auto &plugin : plugins)
+        // ┌────────────────────────────────────────────────────┐
+        // │  PAIR MATCHING: Both input AND output must match   │
+        // │                                                    │
+        // │  input_format ──┬── plugin.accepts  (INPUT side)   │
+        // │                 │                                   │
+        // │  target ────────┴── plugin.targets  (OUTPUT side)  │
+        // └────────────────────────────────────────────────────┘
+
+        // Check 1: OUTPUT - Plugin can produce the target format
+        if (!plugin.plugin->supports_target(context.target))
         {
-            auto info = plugin->info();
-
-            // ┌────────────────────────────────────────────────────┐
-            // │  PAIR MATCHING: Both input AND output must match   │
-            // │                                                    │
-            // │  input_format ──┬── plugin.accepts  (INPUT side)   │
-            // │                 │                                   │
-            // │  target ────────┴── plugin.targets  (OUTPUT side)  │
-            // └────────────────────────────────────────────────────┘
+            return false;
+        }
 
-            // Check 1: OUTPUT - Plugin can produce the target format
-            if (!plugin->supports_target(lower_target))
+        // Check 2: INPUT TYPE - Data types are compatible (if we have type info)
+        if (!context.input_types.empty() && !plugin.info.input_types.empty())
+        {
+            if (!types_compatible(context.input_types, plugin.info.input_types))
             {
-                continue;
+                return false;
             }
+        }
 
-            // Check 2: INPUT TYPE - Data types are compatible (if we have type info)
-            if (!context.input_types.empty() && !info.input_types.empty())
-            {
-                if (!types_compatible(context.input_types, info.input_types))
-                {
-                    continue;
-                }
-            }
+        // Check 3: INPUT FORMAT - Plugin accepts this specific format
+        return plugin.plugin->supports_input(context.input_format);
+    }
 
-            // Check 3: INPUT FORMAT - Plugin accepts this specific format
-            if (!plugin->supports_input(lower_input))
-            {
-                continue;
-            }
+    bool PluginResolver::accepts_type(const IndexedPlugin &plugin,
+                                      const ResolutionContext &context) const
+    {
+        // Check if plugin can produce the target, then if data types are compatible
+        return plugin.plugin->supports_target(context.target) &&
+               types_compatible(context.input_types, plugin.info.input_types);
+    }
 
-            // All checks passed: this plugin can handle input_format -> target
-            return plugin.get();
+    PluginResolver::Positions PluginResolver::fastest_tier(
+        const ResolutionContext &context, Id target, std::string &tier) const
+    {
+        // Same tiers as the ordered policy; the first one with any match wins
+        Positions matches;
+        if (!context.input_format.empty())
+        {
+            matches = find_in(target, true, [&](const IndexedPlugin &p)
+                              { return accepts_type_and_format(p, context); });
+            tier = "type+format";
         }
-        return nullptr;
+        if (matches.empty() && !context.input_types.empty())
+        {
+            matches = find_in(target, true, [&](const IndexedPlugin &p)
+                              { return accepts_type(p, context); });
+            tier = "type";
+        }
+        if (matches.empty())
+        {
+            matches = find_in(target, true, [&](const IndexedPlugin &p)
+                              { return p.plugin->supports_target(context.target); });
+            tier = "target";
+        }
+        return matches;
     }
 
-    plugins::IPlugin *PluginResolver::find_by_type_only(
-        const ResolutionContext &context,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
+    ResolutionResult PluginResolver::rank_fastest(
+        const ResolutionContext &context, const Positions &matches, const std::string &tier) const
     {
-        auto lower_target = to_lower(context.target);
-
-        for (const auto &plugin : plugins)
+        struct Ranked
         {
-            auto info = plugin->info();
-
-            // Check if plugin can produce the target
-            if (!plugin->supports_target(lower_target))
-            {
-                continue;
-            }
-
-            // Check if data types are compatible
-            if (!types_compatible(context.input_types, info.input_types))
+            const IndexedPlugin *plugin;
+            std::optional<PerfEstimate> estimate;
+        };
+        std::vector<Ranked> ranked;
+        ranked.reserve(matches.size());
+        for (auto pos : matches)
+        {
+            Ranked r{&indexed_[pos], std::nullopt};
+            if (stats_ && matches.size() > 1)
             {
-                continue;
+                r.estimate = stats_->estimate(r.plugin->info.scope, r.plugin->info.version, to_lower(context.target),
+                                              to_lower(context.input_format), context.input_size);
             }
-
-            return plugin.get();
+            ranked.push_back(std::move(r));
         }
-        return nullptr;
-    }
 
-    plugins::IPlugin *PluginResolver::find_by_target_only(
-        const std::string &target,
-        const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const
-    {
-        auto lower_target = to_lower(target);
-
-        for (const auto &plugin : plugins)
+        // Stable: unmeasured plugins keep registration order
+        std::stable_sort(ranked.begin(), ranked.end(), [](const Ranked &a, const Ranked &b)
+                         {
+            if (a.estimate.has_value() != b.estimate.has_value())
+                return a.estimate.has_value();
+            if (!a.estimate)
+                return false;
+            if (a.estimate->duration_ms != b.estimate->duration_ms)
+                return a.estimate->duration_ms < b.estimate->duration_ms;
+            if (a.estimate->exact != b.estimate->exact)
+                return a.estimate->exact;
+            if (a.estimate->samples != b.estimate->samples)
+                return a.estimate->samples > b.estimate->samples;
+            if (a.plugin->info.scope != b.plugin->info.scope)
+                return a.plugin->info.scope < b.plugin->info.scope;
+            return a.plugin->info.name < b.plugin->info.name; });
+
+        ResolutionResult result{ranked.front().plugin->plugin,
+                                ranked.front().estimate ? "fastest" : tier, {}};
+        for (const auto &r : ranked)
         {
-            if (plugin->supports_target(lower_target))
+            ResolutionCandidate candidate;
+            candidate.plugin = r.plugin->info.scope;
+            if (r.estimate)
             {
-                return plugin.get();
+                candidate.estimated_ms = r.estimate->duration_ms;
+                candidate.samples = r.estimate->samples;
             }
+            result.candidates.push_back(std::move(candidate));
         }
-        return nullptr;
+        return result;
     }
 
     bool PluginResolver::types_compatible(
@@ -270,7 +481,8 @@ namespace uniconv::core
         }
 
         // Empty plugin input types means plugin accepts anything
-        if (plugin_input_types.empty())
+        auto plugin_types = content_types(plugin_input_types);
+        if (plugin_types.empty())
         {
             return true;
         }
@@ -278,7 +490,7 @@ namespace uniconv::core
         // Check if any input type matches any plugin input type
         for (const auto &in_type : input_types)
         {
-            for (const auto &plugin_type : plugin_input_types)
+            for (const auto &plugin_type : plugin_types)
             {
                 // Direct match
                 if (in_type == plugin_type)
@@ -1,11 +1,15 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/perf_stats.h"
 #include "plugins/plugin_interface.h"
+#include "utils/symbol_table.h"
 #include <map>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace uniconv::core
@@ -18,24 +22,56 @@ namespace uniconv::core
         std::string target;                         // e.g., "pdf", "docx", "png"
         std::optional<std::string> explicit_plugin; // e.g., "image-convert" (from scope/plugin:target)
         std::vector<DataType> input_types;          // e.g., {Image} or {File}
+        uintmax_t input_size = 0;                   // Input bytes, 0 if unknown (auto-fastest)
+    };
+
+    // How to choose among several compatible plugins
+    enum class ResolutionPolicy
+    {
+        Ordered,    // First compatible plugin in registration order
+        AutoFastest // Lowest expected duration from the performance history
+    };
+
+    std::optional<ResolutionPolicy> resolution_policy_from_string(const std::string &name);
+
+    // A compatible plugin considered by auto-fastest
+    struct ResolutionCandidate
+    {
+        std::string plugin;                  // Scope
+        std::optional<int64_t> estimated_ms; // nullopt: no history
+        size_t samples = 0;
     };
 
     // Result of plugin resolution with reasoning
     struct ResolutionResult
     {
         plugins::IPlugin *plugin = nullptr;
-        std::string matched_by; // "explicit", "default", "type+format", "type", "target", "none"
+        std::string matched_by; // "explicit", "default", "fastest", "type+format", "type", "target", "none"
+        std::vector<ResolutionCandidate> candidates; // Ranked, best first (auto-fastest only)
     };
 
+    // Resolves targets through an index of the registered plugins (target
+    // -> plugins, by interned, case-folded id) and memoizes the outcome per
+    // context, so resolving the same stage for every file of a batch is a
+    // hash lookup. Plugins are indexed by the targets in their info().
+    //
+    // index() and the setters are not synchronized; once they are done,
+    // resolve() may be called from any number of threads.
     class PluginResolver
     {
     public:
         PluginResolver() = default;
 
+        // Copies start with an empty memo
+        PluginResolver(const PluginResolver &other);
+        PluginResolver &operator=(const PluginResolver &) = delete;
+
+        // Index plugins appended to the list since the last call (all of
+        // them if it is another list); drops the memoized resolutions
+        void index(const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins);
+
         // Main resolution method - finds best plugin for context
-        ResolutionResult resolve(
-            const ResolutionContext &context,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
+        ResolutionResult resolve(const ResolutionContext &context) const;
 
         // Check if two plugins can be connected in a pipeline
         bool can_connect(const PluginInfo &from, const PluginInfo &to) const;
@@ -46,34 +82,92 @@ namespace uniconv::core
 
         // Get access to defaults (for PluginManager backward compatibility)
         const std::map<std::string, std::string> &defaults() const { return defaults_; }
-        std::map<std::string, std::string> &defaults() { return defaults_; }
+
+        // Selection among compatible plugins; explicit and default plugins
+        // always win. AutoFastest ranks candidates with stats.
+        void set_policy(ResolutionPolicy policy);
+        ResolutionPolicy policy() const { return policy_; }
+        void set_stats(std::shared_ptr<const PerfStats> stats);
 
     private:
         std::map<std::string, std::string> defaults_; // target -> plugin_scope
-
-        // Resolution steps (in priority order)
-        plugins::IPlugin *find_by_explicit(
-            const std::string &plugin_specifier,
-            const std::string &target,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
-
-        plugins::IPlugin *find_by_default(
-            const std::string &target,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
-
-        plugins::IPlugin *find_by_type_and_format(
-            const ResolutionContext &context,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
-
-        plugins::IPlugin *find_by_type_only(
-            const ResolutionContext &context,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
-
-        plugins::IPlugin *find_by_target_only(
-            const std::string &target,
-            const std::vector<std::unique_ptr<plugins::IPlugin>> &plugins) const;
+        ResolutionPolicy policy_ = ResolutionPolicy::Ordered;
+        std::shared_ptr<const PerfStats> stats_;
+
+        using Id = utils::SymbolTable::Id;
+        using Positions = std::vector<uint32_t>;
+
+        struct IndexedPlugin
+        {
+            plugins::IPlugin *plugin = nullptr;
+            PluginInfo info; // Snapshot taken when indexed
+        };
+
+        // Everything that decides a resolution except the input size,
+        // which only ranks auto-fastest candidates. Names are looked up,
+        // not interned: every name a plugin offers is interned when it is
+        // indexed, and names no plugin offers all resolve alike.
+        struct ResolutionKey
+        {
+            Id target = utils::SymbolTable::kNone;
+            Id input_format = utils::SymbolTable::kNone;
+            Id explicit_plugin = utils::SymbolTable::kNone;
+            bool has_explicit = false;
+            uint32_t input_types = 0; // Bit per DataType
+
+            bool operator==(const ResolutionKey &) const = default;
+        };
+        struct ResolutionKeyHash
+        {
+            size_t operator()(const ResolutionKey &key) const;
+        };
+
+        // A memoized resolution. For auto-fastest the matching tier is
+        // kept instead and ranked on every call, as the stats move.
+        struct Resolution
+        {
+            ResolutionResult result;
+            Positions rank;
+        };
+
+        utils::SymbolTable symbols_;
+        const std::vector<std::unique_ptr<plugins::IPlugin>> *indexed_list_ = nullptr;
+        std::vector<IndexedPlugin> indexed_;
+        std::vector<Positions> by_target_; // Target id -> positions, in registration order
+
+        // Readers share the memo; a miss computes outside the lock
+        mutable std::shared_mutex memo_mutex_;
+        mutable std::unordered_map<ResolutionKey, Resolution, ResolutionKeyHash> memo_;
+
+        // Plugins offering target, in registration order
+        const Positions &candidates(Id target) const;
+
+        ResolutionKey make_key(const ResolutionContext &context) const;
+        Resolution compute(const ResolutionContext &context) const;
+
+        // AutoFastest: the plugins of the first matching tier, ranked by
+        // expected duration. Measured plugins come first; ties go to the
+        // exact size class, then more samples, then scope and name order.
+        // Without any measurement the ordered choice stands.
+        Positions fastest_tier(const ResolutionContext &context, Id target, std::string &tier) const;
+        ResolutionResult rank_fastest(const ResolutionContext &context, const Positions &matches,
+                                      const std::string &tier) const;
+
+        // Resolution steps (in priority order); context.target and
+        // context.input_format are lower-cased here
+        plugins::IPlugin *find_by_explicit(const std::string &plugin_specifier, const std::string &target,
+                                           Id target_id) const;
+        plugins::IPlugin *find_by_default(const std::string &target, Id target_id) const;
+
+        // Candidates for target that accepts approves: the first one, or
+        // with all every one
+        template <typename Accepts>
+        Positions find_in(Id target, bool all, Accepts &&accepts) const;
 
         // Helper methods
+        bool accepts_type_and_format(const IndexedPlugin &plugin, const ResolutionContext &context) const;
+        bool accepts_type(const IndexedPlugin &plugin, const ResolutionContext &context) const;
+
         bool types_compatible(
             const std::vector<DataType> &input_types,
             const std::vector<DataType> &plugin_input_types) const;
@@ -0,0 +1,545 @@
+#include "plugin_worker.h"
+#include <algorithm>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace uniconv::core
+{
+
+#ifndef _WIN32
+    namespace
+    {
+
+        void close_fd(int &fd)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+                fd = -1;
+            }
+        }
+
+        void set_cloexec(int fd)
+        {
+            int flags = fcntl(fd, F_GETFD);
+            if (flags >= 0)
+            {
+                fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+            }
+        }
+
+        // Write all bytes without letting a dead reader raise SIGPIPE
+        bool write_all(int fd, const std::string &data)
+        {
+            sigset_t pipe_set, old_set;
+            sigemptyset(&pipe_set);
+            sigaddset(&pipe_set, SIGPIPE);
+            pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+            bool ok = true;
+            size_t written = 0;
+            while (written < data.size())
+            {
+                ssize_t n = write(fd, data.data() + written, data.size() - written);
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    ok = false;
+                    break;
+                }
+                written += static_cast<size_t>(n);
+            }
+
+            if (!ok && errno == EPIPE)
+            {
+                // Consume the SIGPIPE raised for this thread before unblocking
+                sigset_t pending;
+                sigpending(&pending);
+                if (sigismember(&pending, SIGPIPE))
+                {
+                    int sig;
+                    sigwait(&pipe_set, &sig);
+                }
+            }
+
+            pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+            return ok;
+        }
+
+    } // anonymous namespace
+#endif
+
+    // PluginWorker implementation
+
+    PluginWorker::PluginWorker(std::string command,
+                               std::vector<std::string> args,
+                               std::map<std::string, std::string> env)
+        : command_(std::move(command)),
+          args_(std::move(args)),
+          env_(std::move(env)),
+          last_used_(std::chrono::steady_clock::now())
+    {
+    }
+
+    PluginWorker::~PluginWorker()
+    {
+        stop();
+    }
+
+#ifndef _WIN32
+    bool PluginWorker::start(std::string &error)
+    {
+        int in_pipe[2];
+        int out_pipe[2];
+        int err_pipe[2];
+
+        if (pipe(in_pipe) != 0)
+        {
+            error = "Failed to create pipes";
+            return false;
+        }
+        if (pipe(out_pipe) != 0)
+        {
+            close(in_pipe[0]);
+            close(in_pipe[1]);
+            error = "Failed to create pipes";
+            return false;
+        }
+        if (pipe(err_pipe) != 0)
+        {
+            close(in_pipe[0]);
+            close(in_pipe[1]);
+            close(out_pipe[0]);
+            close(out_pipe[1]);
+            error = "Failed to create pipes";
+            return false;
+        }
+
+        // Our ends must not leak into other plugin subprocesses
+        set_cloexec(in_pipe[1]);
+        set_cloexec(out_pipe[0]);
+        set_cloexec(err_pipe[0]);
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            for (int fd : {in_pipe[0], in_pipe[1], out_pipe[0], out_pipe[1], err_pipe[0], err_pipe[1]})
+            {
+                close(fd);
+            }
+            error = "Failed to fork process";
+            return false;
+        }
+
+        if (pid == 0)
+        {
+            // Child process
+            dup2(in_pipe[0], STDIN_FILENO);
+            dup2(out_pipe[1], STDOUT_FILENO);
+            dup2(err_pipe[1], STDERR_FILENO);
+            close(in_pipe[0]);
+            close(in_pipe[1]);
+            close(out_pipe[0]);
+            close(out_pipe[1]);
+            close(err_pipe[0]);
+            close(err_pipe[1]);
+
+            for (const auto &[key, value] : env_)
+            {
+                setenv(key.c_str(), value.c_str(), 1);
+            }
+
+            std::vector<char *> argv;
+            argv.push_back(const_cast<char *>(command_.c_str()));
+            for (const auto &arg : args_)
+            {
+                argv.push_back(const_cast<char *>(arg.c_str()));
+            }
+            argv.push_back(nullptr);
+
+            execvp(command_.c_str(), argv.data());
+            _exit(127);
+        }
+
+        // Parent process
+        close(in_pipe[0]);
+        close(out_pipe[1]);
+        close(err_pipe[1]);
+
+        pid_ = pid;
+        stdin_fd_ = in_pipe[1];
+        stdout_fd_ = out_pipe[0];
+        stderr_fd_ = err_pipe[0];
+        last_used_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool PluginWorker::running()
+    {
+        if (pid_ < 0)
+            return false;
+
+        int status;
+        pid_t r = waitpid(pid_, &status, WNOHANG);
+        if (r == pid_)
+        {
+            pid_ = -1;
+            return false;
+        }
+        return r == 0;
+    }
+
+    bool PluginWorker::call(const std::string &line,
+                            uint64_t id,
+                            std::chrono::milliseconds timeout,
+                            std::string &response,
+                            std::string &stderr_output,
+                            std::string &error)
+    {
+        timed_out_ = false;
+        if (pid_ < 0)
+        {
+            error = "Worker process is not running";
+            return false;
+        }
+
+        if (!write_all(stdin_fd_, line))
+        {
+            error = "Worker process closed its input";
+            return false;
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        bool stdout_open = true;
+
+        while (stdout_open)
+        {
+            // Hand back the first complete line that answers this request
+            size_t newline;
+            while ((newline = read_buffer_.find('\n')) != std::string::npos)
+            {
+                std::string candidate = read_buffer_.substr(0, newline);
+                read_buffer_.erase(0, newline + 1);
+
+                auto j = nlohmann::json::parse(candidate, nullptr, false);
+                if (j.is_object() && j.contains("id") && j.at("id").is_number_unsigned() &&
+                    j.at("id").get<uint64_t>() == id)
+                {
+                    response = std::move(candidate);
+                    last_used_ = std::chrono::steady_clock::now();
+                    return true;
+                }
+            }
+
+            int wait_ms = -1;
+            if (timeout.count() > 0)
+            {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                if (remaining.count() <= 0)
+                {
+                    timed_out_ = true;
+                    error = "Plugin execution timed out";
+                    return false;
+                }
+                wait_ms = static_cast<int>(remaining.count());
+            }
+
+            pollfd fds[2] = {{stdout_fd_, POLLIN, 0}, {stderr_fd_, POLLIN, 0}};
+            nfds_t nfds = stderr_fd_ >= 0 ? 2 : 1;
+            int ready = poll(fds, nfds, wait_ms);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                error = "Failed to wait for worker output";
+                return false;
+            }
+
+            char buf[4096];
+            if (nfds == 2 && (fds[1].revents & (POLLIN | POLLHUP)))
+            {
+                ssize_t n = read(stderr_fd_, buf, sizeof(buf));
+                if (n > 0)
+                    stderr_output.append(buf, static_cast<size_t>(n));
+                else
+                    close_fd(stderr_fd_);
+            }
+            if (fds[0].revents & (POLLIN | POLLHUP))
+            {
+                ssize_t n = read(stdout_fd_, buf, sizeof(buf));
+                if (n > 0)
+                    read_buffer_.append(buf, static_cast<size_t>(n));
+                else
+                    stdout_open = false;
+            }
+        }
+
+        error = "Worker process exited unexpectedly";
+        return false;
+    }
+
+    void PluginWorker::stop()
+    {
+        close_fd(stdin_fd_);
+
+        if (pid_ > 0)
+        {
+            // Closing stdin asks the worker to exit; give it a moment
+            int status;
+            bool exited = false;
+            for (int i = 0; i < 50 && !exited; ++i)
+            {
+                if (waitpid(pid_, &status, WNOHANG) == pid_)
+                {
+                    exited = true;
+                    break;
+                }
+                usleep(20 * 1000);
+            }
+            if (!exited)
+            {
+                kill(pid_, SIGKILL);
+                waitpid(pid_, &status, 0);
+            }
+            pid_ = -1;
+        }
+
+        close_fd(stdout_fd_);
+        close_fd(stderr_fd_);
+        read_buffer_.clear();
+    }
+#else
+    // The worker protocol relies on POSIX pipes and poll(); CLIPlugin falls
+    // back to one process per request on Windows.
+    bool PluginWorker::start(std::string &error)
+    {
+        error = "Worker protocol is not supported on Windows";
+        return false;
+    }
+
+    bool PluginWorker::running()
+    {
+        return false;
+    }
+
+    bool PluginWorker::call(const std::string &, uint64_t, std::chrono::milliseconds,
+                            std::string &, std::string &, std::string &error)
+    {
+        error = "Worker protocol is not supported on Windows";
+        return false;
+    }
+
+    void PluginWorker::stop()
+    {
+    }
+#endif
+
+    // PluginWorkerPool implementation
+
+    PluginWorkerPool::PluginWorkerPool(std::string command,
+                                       std::vector<std::string> args,
+                                       std::map<std::string, std::string> env,
+                                       Options options)
+        : command_(std::move(command)),
+          args_(std::move(args)),
+          env_(std::move(env)),
+          options_(options)
+    {
+        options_.max_workers = std::max<size_t>(options_.max_workers, 1);
+        reaper_ = std::thread([this]()
+                              { reaper_loop(); });
+    }
+
+    PluginWorkerPool::~PluginWorkerPool()
+    {
+        std::vector<std::unique_ptr<PluginWorker>> workers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            workers = std::move(idle_);
+            idle_.clear();
+        }
+        reaper_cv_.notify_all();
+        if (reaper_.joinable())
+        {
+            reaper_.join();
+        }
+        // Destructors close stdin and reap each process
+        workers.clear();
+    }
+
+    PluginWorkerPool::CallResult PluginWorkerPool::call(nlohmann::json request,
+                                                        std::chrono::milliseconds timeout)
+    {
+        CallResult result;
+
+        uint64_t id;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            id = next_id_++;
+        }
+        request["id"] = id;
+        std::string line = request.dump() + "\n";
+
+        for (int attempt = 0; attempt < 2; ++attempt)
+        {
+            auto worker = acquire(result.error);
+            if (!worker)
+            {
+                return result;
+            }
+
+            result.stderr_output.clear();
+            if (worker->call(line, id, timeout, result.response, result.stderr_output, result.error))
+            {
+                release(std::move(worker));
+                result.ok = true;
+                result.error.clear();
+                return result;
+            }
+
+            bool timed_out = worker->timed_out();
+            discard(std::move(worker));
+            if (timed_out)
+            {
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    size_t PluginWorkerPool::live_workers() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return live_;
+    }
+
+    std::unique_ptr<PluginWorker> PluginWorkerPool::acquire(std::string &error)
+    {
+        while (true)
+        {
+            std::unique_ptr<PluginWorker> worker;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                available_cv_.wait(lock, [this]()
+                                   { return !idle_.empty() || live_ < options_.max_workers; });
+
+                if (!idle_.empty())
+                {
+                    worker = std::move(idle_.back());
+                    idle_.pop_back();
+                }
+                else
+                {
+                    ++live_;
+                }
+            }
+
+            if (worker)
+            {
+                // Health check: a worker that sat idle may have died or hung
+                auto idle_for = std::chrono::steady_clock::now() - worker->last_used();
+                if (!worker->running() || (idle_for >= options_.ping_after && !ping(*worker)))
+                {
+                    discard(std::move(worker));
+                    continue;
+                }
+                return worker;
+            }
+
+            worker = std::make_unique<PluginWorker>(command_, args_, env_);
+            if (!worker->start(error))
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --live_;
+                available_cv_.notify_one();
+                return nullptr;
+            }
+            return worker;
+        }
+    }
+
+    void PluginWorkerPool::release(std::unique_ptr<PluginWorker> worker)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_.push_back(std::move(worker));
+        }
+        available_cv_.notify_one();
+    }
+
+    void PluginWorkerPool::discard(std::unique_ptr<PluginWorker> worker)
+    {
+        worker.reset();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --live_;
+        }
+        available_cv_.notify_one();
+    }
+
+    bool PluginWorkerPool::ping(PluginWorker &worker)
+    {
+        uint64_t id;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            id = next_id_++;
+        }
+        nlohmann::json request{{"id", id}, {"type", "ping"}};
+
+        std::string response, stderr_output, error;
+        return worker.call(request.dump() + "\n", id, options_.ping_timeout,
+                           response, stderr_output, error);
+    }
+
+    void PluginWorkerPool::reaper_loop()
+    {
+        auto interval = std::max<std::chrono::milliseconds>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(options_.idle_timeout) / 2,
+            std::chrono::milliseconds(100));
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_)
+        {
+            reaper_cv_.wait_for(lock, interval);
+            if (stopping_)
+                break;
+
+            // Move expired workers out and stop them without holding the lock
+            auto now = std::chrono::steady_clock::now();
+            std::vector<std::unique_ptr<PluginWorker>> expired;
+            for (auto it = idle_.begin(); it != idle_.end();)
+            {
+                if (now - (*it)->last_used() >= options_.idle_timeout)
+                {
+                    expired.push_back(std::move(*it));
+                    it = idle_.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            if (expired.empty())
+                continue;
+
+            live_ -= expired.size();
+            lock.unlock();
+            expired.clear();
+            available_cv_.notify_all();
+            lock.lock();
+        }
+    }
+
+} // namespace uniconv::core
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace uniconv::core
+{
+
+    // One long-lived plugin process speaking the worker protocol:
+    // newline-delimited JSON requests on stdin, one JSON result line per
+    // request on stdout. Every message carries an "id" that the result echoes.
+    class PluginWorker
+    {
+    public:
+        PluginWorker(std::string command,
+                     std::vector<std::string> args,
+                     std::map<std::string, std::string> env);
+        ~PluginWorker();
+
+        // Non-copyable
+        PluginWorker(const PluginWorker &) = delete;
+        PluginWorker &operator=(const PluginWorker &) = delete;
+
+        // Spawn the process
+        bool start(std::string &error);
+
+        // Whether the process is still alive
+        bool running();
+
+        // Send one request line and wait for the result line carrying id.
+        // timeout of zero waits indefinitely. Lines that are not JSON objects
+        // with a matching id are ignored. Returns false if the process died,
+        // timed out or closed its pipes; the worker must then be discarded.
+        bool call(const std::string &line,
+                  uint64_t id,
+                  std::chrono::milliseconds timeout,
+                  std::string &response,
+                  std::string &stderr_output,
+                  std::string &error);
+
+        // Close stdin and reap the process (killed if it does not exit promptly)
+        void stop();
+
+        std::chrono::steady_clock::time_point last_used() const { return last_used_; }
+
+        // Whether the last call failed because the timeout expired
+        bool timed_out() const { return timed_out_; }
+
+    private:
+        std::string command_;
+        std::vector<std::string> args_;
+        std::map<std::string, std::string> env_;
+
+#ifndef _WIN32
+        int pid_ = -1;
+        int stdin_fd_ = -1;
+        int stdout_fd_ = -1;
+        int stderr_fd_ = -1;
+#endif
+        std::string read_buffer_;
+        std::chrono::steady_clock::time_point last_used_;
+        bool timed_out_ = false;
+    };
+
+    // Pool of workers for one plugin. Up to max_workers processes run at a
+    // time; idle ones are reused, health-checked with a ping after sitting
+    // idle, replaced when they crash and shut down after idle_timeout.
+    class PluginWorkerPool
+    {
+    public:
+        struct Options
+        {
+            size_t max_workers = 1;
+            std::chrono::seconds idle_timeout{60};
+            std::chrono::seconds ping_after{10};       // Ping idle workers before reuse
+            std::chrono::milliseconds ping_timeout{5000};
+        };
+
+        struct CallResult
+        {
+            bool ok = false;
+            std::string response;      // Result line from the worker
+            std::string stderr_output; // Worker stderr captured during the call
+            std::string error;         // Set when ok is false
+        };
+
+        PluginWorkerPool(std::string command,
+                         std::vector<std::string> args,
+                         std::map<std::string, std::string> env,
+                         Options options);
+        ~PluginWorkerPool();
+
+        // Non-copyable
+        PluginWorkerPool(const PluginWorkerPool &) = delete;
+        PluginWorkerPool &operator=(const PluginWorkerPool &) = delete;
+
+        // Send a request (an "id" is added) and return the worker's result.
+        // A worker that crashes mid-request is restarted and the request
+        // retried once; timeouts are not retried.
+        CallResult call(nlohmann::json request, std::chrono::milliseconds timeout);
+
+        // Number of worker processes currently alive
+        size_t live_workers() const;
+
+    private:
+        std::unique_ptr<PluginWorker> acquire(std::string &error);
+        void release(std::unique_ptr<PluginWorker> worker);
+        void discard(std::unique_ptr<PluginWorker> worker);
+        bool ping(PluginWorker &worker);
+        void reaper_loop();
+
+        std::string command_;
+        std::vector<std::string> args_;
+        std::map<std::string, std::string> env_;
+        Options options_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable available_cv_;
+        std::condition_variable reaper_cv_;
+        std::vector<std::unique_ptr<PluginWorker>> idle_;
+        size_t live_ = 0;
+        uint64_t next_id_ = 1;
+        bool stopping_ = false;
+        std::thread reaper_;
+    };
+
+} // namespace uniconv::core
@@ -0,0 +1,25 @@
+#include "prepared_pipeline.h"
+
+namespace uniconv::core
+{
+
+    PreparedPipeline::PreparedPipeline(Pipeline pipeline, ExecutionGraph graph)
+        : pipeline_(std::move(pipeline)), graph_(std::move(graph))
+    {
+    }
+
+    ExecutionGraph PreparedPipeline::graph_for(const std::string &format,
+                                               const std::function<void(ExecutionGraph &)> &plan) const
+    {
+        std::lock_guard<std::mutex> lock(routed_mutex_);
+        auto it = routed_.find(format);
+        if (it == routed_.end())
+        {
+            ExecutionGraph graph = graph_;
+            plan(graph);
+            it = routed_.emplace(format, std::move(graph)).first;
+        }
+        return it->second;
+    }
+
+} // namespace uniconv::core
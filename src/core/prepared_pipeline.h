@@ -0,0 +1,53 @@
+#pragma once
+
+#include "pipeline.h"
+#include "execution_graph.h"
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace uniconv::core
+{
+
+    // A pipeline parsed, resolved and checked once to run on many inputs
+    // (--batch, watch). PipelineExecutor::prepare resolves every stage's
+    // plugin, extension, sink flag and required options up front and checks
+    // that adjacent plugins can connect, so a bad pipeline fails before any
+    // file is touched and each run only copies the graph and binds its
+    // source. Routes depend on the input format; they are planned on the
+    // first input of each format and reused for the next ones.
+    class PreparedPipeline
+    {
+    public:
+        PreparedPipeline(Pipeline pipeline, ExecutionGraph graph);
+
+        // The prototype; its source is only a placeholder
+        const Pipeline &pipeline() const { return pipeline_; }
+
+        // The resolved graph, before routing
+        const ExecutionGraph &graph() const { return graph_; }
+
+        // Graph for inputs of format. On the first call for a format, plan
+        // is applied to a copy of graph() and the result kept.
+        ExecutionGraph graph_for(const std::string &format,
+                                 const std::function<void(ExecutionGraph &)> &plan) const;
+
+    private:
+        Pipeline pipeline_;
+        ExecutionGraph graph_;
+
+        mutable std::mutex routed_mutex_;
+        mutable std::map<std::string, ExecutionGraph> routed_; // Planned graph per input format
+    };
+
+    // Result of PipelineExecutor::prepare
+    struct PrepareResult
+    {
+        bool success = false;
+        std::shared_ptr<const PreparedPipeline> prepared;
+        std::string error;
+    };
+
+} // namespace uniconv::core
@@ -0,0 +1,203 @@
+#include "resource_scheduler.h"
+#include "config_manager.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace uniconv::core {
+
+namespace {
+
+const std::string kLimitPrefix = "scheduler.limit.";
+
+uintmax_t physical_memory() {
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGE_SIZE)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && page_size > 0) {
+        return static_cast<uintmax_t>(pages) * static_cast<uintmax_t>(page_size);
+    }
+#endif
+    return 0;
+}
+
+} // anonymous namespace
+
+ResourceBudget ResourceBudget::defaults() {
+    ResourceBudget budget;
+    budget.memory = physical_memory() / 5 * 4;
+    return budget;
+}
+
+ResourceBudget ResourceBudget::from_config(const ConfigManager& config) {
+    auto budget = defaults();
+    if (auto configured = config.get("scheduler.memory")) {
+        if (auto parsed = utils::parse_size(*configured)) {
+            budget.memory = *parsed;
+        }
+    }
+    if (auto configured = config.get("scheduler.cpus")) {
+        try {
+            budget.cpus = static_cast<unsigned>(std::max(std::stoi(*configured), 0));
+        } catch (const std::exception&) {
+            // Keep the default
+        }
+    }
+    for (const auto& key : config.list_keys()) {
+        if (key.compare(0, kLimitPrefix.size(), kLimitPrefix) != 0) {
+            continue;
+        }
+        try {
+            int limit = std::stoi(*config.get(key));
+            if (limit > 0) {
+                budget.plugin_limits[key.substr(kLimitPrefix.size())] = static_cast<size_t>(limit);
+            }
+        } catch (const std::exception&) {
+            // Ignore malformed limits
+        }
+    }
+    return budget;
+}
+
+ResourceScheduler::Lease::Lease(ResourceScheduler* owner, std::vector<ResourceClaim> claims)
+    : owner_(owner), claims_(std::move(claims)) {
+}
+
+ResourceScheduler::Lease::~Lease() {
+    release();
+}
+
+ResourceScheduler::Lease::Lease(Lease&& other) noexcept
+    : owner_(other.owner_), claims_(std::move(other.claims_)) {
+    other.owner_ = nullptr;
+}
+
+ResourceScheduler::Lease& ResourceScheduler::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        owner_ = other.owner_;
+        claims_ = std::move(other.claims_);
+        other.owner_ = nullptr;
+    }
+    return *this;
+}
+
+void ResourceScheduler::Lease::release() {
+    if (owner_) {
+        owner_->release(claims_);
+        owner_ = nullptr;
+    }
+}
+
+ResourceScheduler::ResourceScheduler(ResourceBudget budget, unsigned min_cpus)
+    : budget_(std::move(budget)) {
+    if (budget_.cpus == 0) {
+        budget_.cpus = std::max({std::thread::hardware_concurrency(), min_cpus, 1u});
+    }
+}
+
+ResourceScheduler::Lease ResourceScheduler::acquire(const ResourceClaim& claim) {
+    return acquire(std::vector<ResourceClaim>{claim});
+}
+
+ResourceScheduler::Lease ResourceScheduler::acquire(std::vector<ResourceClaim> claims) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto self = waiters_.insert(waiters_.end(), &claims);
+    cv_.wait(lock, [&]() { return admissible(self); });
+    waiters_.erase(self);
+
+    for (const auto& claim : claims) {
+        ++running_;
+        exclusive_running_ += claim.exclusive ? 1 : 0;
+        memory_used_ += claim.memory;
+        threads_used_ += claim.threads;
+        if (!claim.plugin.empty()) {
+            ++plugin_running_[claim.plugin];
+        }
+    }
+    // Later waiters may have been held back behind this one
+    cv_.notify_all();
+    return Lease(this, std::move(claims));
+}
+
+void ResourceScheduler::release(const std::vector<ResourceClaim>& claims) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& claim : claims) {
+            --running_;
+            exclusive_running_ -= claim.exclusive ? 1 : 0;
+            memory_used_ -= claim.memory;
+            threads_used_ -= claim.threads;
+            if (!claim.plugin.empty()) {
+                --plugin_running_[claim.plugin];
+            }
+        }
+    }
+    cv_.notify_all();
+}
+
+size_t ResourceScheduler::running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+bool ResourceScheduler::fits_budget(const std::vector<ResourceClaim>& claims) const {
+    if (running_ == 0) {
+        return true;
+    }
+    if (exclusive_running_ > 0) {
+        return false;
+    }
+    uintmax_t memory = 0;
+    unsigned threads = 0;
+    for (const auto& claim : claims) {
+        if (claim.exclusive) {
+            return false;
+        }
+        memory += claim.memory;
+        threads += claim.threads;
+    }
+    if (budget_.memory > 0 && memory_used_ + memory > budget_.memory) {
+        return false;
+    }
+    return threads_used_ + threads <= budget_.cpus;
+}
+
+bool ResourceScheduler::fits_plugin_limits(const std::vector<ResourceClaim>& claims) const {
+    std::map<std::string, size_t> wanted;
+    for (const auto& claim : claims) {
+        if (!claim.plugin.empty()) {
+            ++wanted[claim.plugin];
+        }
+    }
+    for (const auto& [plugin, count] : wanted) {
+        auto limit = budget_.plugin_limits.find(plugin);
+        if (limit == budget_.plugin_limits.end()) {
+            continue;
+        }
+        auto running = plugin_running_.find(plugin);
+        size_t current = running == plugin_running_.end() ? 0 : running->second;
+        // A chain using one plugin more often than its limit still runs alone
+        if (current > 0 && current + count > limit->second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ResourceScheduler::admissible(Waiters::const_iterator waiter) const {
+    // Arrival order for the shared budget, so a large claim is not starved
+    // by a stream of small ones
+    for (auto it = waiters_.begin(); it != waiter; ++it) {
+        if (!fits_budget(**it)) {
+            return false;
+        }
+    }
+    return fits_budget(**waiter) && fits_plugin_limits(**waiter);
+}
+
+} // namespace uniconv::core
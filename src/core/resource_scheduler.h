@@ -0,0 +1,103 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace uniconv::core {
+
+class ConfigManager;
+
+// Machine-wide limits for conversions running at the same time
+struct ResourceBudget {
+    uintmax_t memory = 0;                       // Bytes of expected RSS; 0 = unlimited
+    unsigned cpus = 0;                          // Busy cores; 0 = the larger of cores and --jobs
+    std::map<std::string, size_t> plugin_limits; // Plugin scope -> max concurrent conversions
+
+    // 80% of physical memory where it can be read, cores as above
+    static ResourceBudget defaults();
+
+    // Defaults overridden by settings: scheduler.memory (e.g. "12GB", "0"
+    // for unlimited), scheduler.cpus and scheduler.limit.<plugin>
+    static ResourceBudget from_config(const ConfigManager& config);
+};
+
+// What one conversion is expected to use while it runs
+struct ResourceClaim {
+    std::string plugin; // Scope, for plugin_limits; empty = not limited
+    uintmax_t memory = 0;
+    unsigned threads = 1;
+    bool exclusive = false;
+};
+
+// Admits conversions while their claims fit the budget; the rest wait in
+// arrival order. Work waiting for a plugin's own limit does not hold back
+// other plugins. A claim larger than the whole budget still runs, alone,
+// so nothing waits forever.
+class ResourceScheduler {
+public:
+    // Held for the duration of a conversion; releases its claims on
+    // destruction
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease();
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        void release();
+
+    private:
+        friend class ResourceScheduler;
+        Lease(ResourceScheduler* owner, std::vector<ResourceClaim> claims);
+
+        ResourceScheduler* owner_ = nullptr;
+        std::vector<ResourceClaim> claims_;
+    };
+
+    // budget.cpus == 0 resolves to hardware concurrency, at least min_cpus
+    explicit ResourceScheduler(ResourceBudget budget, unsigned min_cpus = 0);
+
+    ResourceScheduler(const ResourceScheduler&) = delete;
+    ResourceScheduler& operator=(const ResourceScheduler&) = delete;
+
+    // Block until claim can run
+    Lease acquire(const ResourceClaim& claim);
+
+    // Admit several claims together, for stages that must run at the same
+    // time (a streamed chain)
+    Lease acquire(std::vector<ResourceClaim> claims);
+
+    const ResourceBudget& budget() const { return budget_; }
+
+    // Conversions currently admitted
+    size_t running() const;
+
+private:
+    using Waiters = std::list<const std::vector<ResourceClaim>*>;
+
+    void release(const std::vector<ResourceClaim>& claims);
+
+    // Called with mutex_ held
+    bool fits_budget(const std::vector<ResourceClaim>& claims) const;
+    bool fits_plugin_limits(const std::vector<ResourceClaim>& claims) const;
+    bool admissible(Waiters::const_iterator waiter) const;
+
+    ResourceBudget budget_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    Waiters waiters_; // Oldest first
+    size_t running_ = 0;
+    size_t exclusive_running_ = 0;
+    uintmax_t memory_used_ = 0;
+    unsigned threads_used_ = 0;
+    std::map<std::string, size_t> plugin_running_;
+};
+
+} // namespace uniconv::core
@@ -0,0 +1,184 @@
+#include "route_planner.h"
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+#include <tuple>
+
+namespace uniconv::core
+{
+
+    namespace
+    {
+
+        std::string to_lower(std::string s)
+        {
+            std::transform(s.begin(), s.end(), s.begin(),
+                           [](unsigned char c)
+                           { return std::tolower(c); });
+            return s;
+        }
+
+        bool contains_ci(const std::vector<std::string> &values, const std::string &lower)
+        {
+            return std::any_of(values.begin(), values.end(), [&](const std::string &v)
+                               { return to_lower(v) == lower; });
+        }
+
+    } // anonymous namespace
+
+    RoutePlanner::RoutePlanner(std::vector<PluginInfo> plugins, const PerfStats *stats)
+        : plugins_(std::move(plugins)), stats_(stats)
+    {
+        // Sinks own their output and cannot feed a later hop
+        plugins_.erase(std::remove_if(plugins_.begin(), plugins_.end(),
+                                      [](const PluginInfo &info)
+                                      { return info.sink; }),
+                       plugins_.end());
+        std::sort(plugins_.begin(), plugins_.end(), [](const PluginInfo &a, const PluginInfo &b)
+                  { return std::tie(a.scope, a.name) < std::tie(b.scope, b.name); });
+    }
+
+    bool RoutePlanner::accepts(const PluginInfo &info, const std::string &target,
+                               const std::string &input_format)
+    {
+        auto lower = to_lower(input_format);
+        for (const auto &[t, formats] : info.target_input_formats)
+        {
+            if (to_lower(t) == to_lower(target))
+            {
+                return contains_ci(formats, lower);
+            }
+        }
+        // nullopt (field omitted) → accept all
+        return !info.accepts || contains_ci(*info.accepts, lower);
+    }
+
+    std::string RoutePlanner::output_format(const PluginInfo &info, const std::string &target)
+    {
+        for (const auto &[t, extensions] : info.targets)
+        {
+            if (to_lower(t) == to_lower(target) && !extensions.empty())
+            {
+                return to_lower(extensions[0]);
+            }
+        }
+        return to_lower(target);
+    }
+
+    bool RoutePlanner::has_direct(const std::string &input_format, const std::string &target) const
+    {
+        auto lower_target = to_lower(target);
+        for (const auto &info : plugins_)
+        {
+            for (const auto &[t, _] : info.targets)
+            {
+                if (to_lower(t) == lower_target && accepts(info, t, input_format))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    std::optional<Route> RoutePlanner::plan(const std::string &input_format,
+                                            const std::string &target,
+                                            uintmax_t input_size) const
+    {
+        auto from = to_lower(input_format);
+        auto goal = to_lower(target);
+
+        // Dijkstra over formats; the label of a format is the cheapest route to it
+        struct Label
+        {
+            Route route;
+            uintmax_t size = 0; // Expected size of a file in this format
+        };
+        std::map<std::string, Label> best;
+        best[from] = {Route{}, input_size};
+
+        using Entry = std::tuple<int64_t, size_t, std::string>; // cost, hops, format
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+        queue.emplace(0, 0, from);
+
+        auto better = [](const Route &a, const Route &b)
+        {
+            if (a.cost_ms != b.cost_ms)
+                return a.cost_ms < b.cost_ms;
+            if (a.hops.size() != b.hops.size())
+                return a.hops.size() < b.hops.size();
+            return std::lexicographical_compare(a.hops.begin(), a.hops.end(), b.hops.begin(), b.hops.end(),
+                                                [](const RouteHop &x, const RouteHop &y)
+                                                { return x.plugin < y.plugin; });
+        };
+
+        std::optional<Route> found;
+        while (!queue.empty())
+        {
+            auto [cost, hops, format] = queue.top();
+            queue.pop();
+            const auto label = best.at(format);
+            if (cost != label.route.cost_ms || hops != label.route.hops.size())
+                continue; // Superseded
+            if (found && cost >= found->cost_ms)
+                break;
+            if (hops >= kMaxHops)
+                continue;
+
+            for (const auto &info : plugins_)
+            {
+                for (const auto &[t, _] : info.targets)
+                {
+                    auto hop_target = to_lower(t);
+                    if (!accepts(info, hop_target, format))
+                        continue;
+
+                    // Only plain format conversions can be intermediate steps;
+                    // a transformation (e.g. "thumbnail") only as the last one
+                    bool last = hop_target == goal;
+                    auto out = output_format(info, hop_target);
+                    if (!last && (out != hop_target || out == format || out == from))
+                        continue;
+
+                    RouteHop hop;
+                    hop.target = hop_target;
+                    hop.plugin = info.scope + "/" + info.name;
+                    hop.output_format = out;
+
+                    uintmax_t out_size = label.size;
+                    int64_t step = kUnknownHopCostMs;
+                    if (stats_)
+                    {
+                        if (auto e = stats_->estimate(info.scope, info.version, hop_target, format, label.size))
+                        {
+                            hop.estimated_ms = e->duration_ms;
+                            step = e->duration_ms;
+                            out_size = e->bytes_out;
+                        }
+                    }
+
+                    Route route = label.route;
+                    route.hops.push_back(hop);
+                    route.cost_ms += step;
+
+                    if (last)
+                    {
+                        if (!found || better(route, *found))
+                            found = route;
+                        continue;
+                    }
+
+                    auto it = best.find(out);
+                    if (it == best.end() || better(route, it->second.route))
+                    {
+                        queue.emplace(route.cost_ms, route.hops.size(), out);
+                        best[out] = {std::move(route), out_size};
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+} // namespace uniconv::core
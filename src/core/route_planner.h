@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/perf_stats.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace uniconv::core
+{
+
+    // One conversion of a planned route
+    struct RouteHop
+    {
+        std::string target;                  // Target requested from the plugin
+        std::string plugin;                  // "scope/name", usable as an explicit plugin
+        std::string output_format;           // Format the hop produces
+        std::optional<int64_t> estimated_ms; // nullopt: no history for this hop
+    };
+
+    // Chain of conversions from an input format to a target
+    struct Route
+    {
+        std::vector<RouteHop> hops;
+        int64_t cost_ms = 0; // Sum of hop costs (unmeasured hops count kUnknownHopCostMs)
+    };
+
+    // Finds conversion chains when no single plugin converts an input format
+    // to a target, e.g. heic -> png -> pdf. Nodes are formats; every plugin
+    // target whose accepted inputs (accepts, or target_input_formats for that
+    // target) include a format is an edge out of it. Edges cost the expected
+    // duration from the performance history, so the cheapest measured path
+    // wins over a merely shorter one.
+    class RoutePlanner
+    {
+    public:
+        static constexpr size_t kMaxHops = 4;
+        static constexpr int64_t kUnknownHopCostMs = 1000;
+
+        explicit RoutePlanner(std::vector<PluginInfo> plugins, const PerfStats *stats = nullptr);
+
+        // Some plugin converts input_format to target in one step
+        bool has_direct(const std::string &input_format, const std::string &target) const;
+
+        // Cheapest chain of at most kMaxHops conversions; ties go to fewer
+        // hops, then plugin scope/name order. nullopt if there is none.
+        std::optional<Route> plan(const std::string &input_format,
+                                  const std::string &target,
+                                  uintmax_t input_size = 0) const;
+
+        // Whether info's target accepts input_format
+        static bool accepts(const PluginInfo &info, const std::string &target,
+                            const std::string &input_format);
+
+        // Format info's target produces (its first extension, else the target)
+        static std::string output_format(const PluginInfo &info, const std::string &target);
+
+    private:
+        std::vector<PluginInfo> plugins_; // Sorted by scope, then name
+        const PerfStats *stats_;
+    };
+
+} // namespace uniconv::core
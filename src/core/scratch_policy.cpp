@@ -0,0 +1,50 @@
+#include "scratch_policy.h"
+#include "config_manager.h"
+#include "utils/string_utils.h"
+
+namespace uniconv::core {
+
+namespace {
+
+constexpr uintmax_t kDefaultRamThreshold = 16ULL * 1024 * 1024;
+
+// scratch.ram_dir = auto: /dev/shm where it exists, else no RAM tier
+std::filesystem::path auto_ram_dir() {
+#ifdef __linux__
+    std::error_code ec;
+    if (std::filesystem::is_directory("/dev/shm", ec)) {
+        return std::filesystem::path("/dev/shm") / "uniconv";
+    }
+#endif
+    return {};
+}
+
+} // anonymous namespace
+
+ScratchPolicy ScratchPolicy::defaults() {
+    ScratchPolicy policy;
+    std::error_code ec;
+    policy.dir = std::filesystem::temp_directory_path(ec) / "uniconv";
+    return policy;
+}
+
+ScratchPolicy ScratchPolicy::from_config(const ConfigManager& config) {
+    auto policy = defaults();
+    if (auto configured = config.get("scratch.dir"); configured && !configured->empty()) {
+        policy.dir = *configured;
+    }
+    if (auto configured = config.get("scratch.ram_dir")) {
+        policy.ram_dir = *configured == "auto" ? auto_ram_dir() : std::filesystem::path(*configured);
+        if (!policy.ram_dir.empty() && policy.ram_threshold == 0) {
+            policy.ram_threshold = kDefaultRamThreshold;
+        }
+    }
+    if (auto configured = config.get("scratch.ram_threshold")) {
+        if (auto parsed = utils::parse_size(*configured)) {
+            policy.ram_threshold = *parsed;
+        }
+    }
+    return policy;
+}
+
+} // namespace uniconv::core
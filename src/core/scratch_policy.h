@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+
+namespace uniconv::core {
+
+class ConfigManager;
+
+// Where a pipeline run keeps its intermediates. Those expected to stay
+// small can go to a RAM-backed directory, everything else to disk scratch.
+// The RAM tier is opt-in: a stage that expands its input (pages, frames)
+// could otherwise fill the RAM filesystem mid-write.
+struct ScratchPolicy {
+    std::filesystem::path dir;     // Disk scratch root
+    std::filesystem::path ram_dir; // RAM-backed root; empty disables it
+    uintmax_t ram_threshold = 0;   // Largest expected size placed in ram_dir
+
+    // <system temp>/uniconv on disk, no RAM tier
+    static ScratchPolicy defaults();
+
+    // Defaults overridden by settings: scratch.dir, scratch.ram_dir (a
+    // path, or "auto" for /dev/shm/uniconv where it exists; 16 MB
+    // threshold unless set) and scratch.ram_threshold (e.g. "64MB")
+    static ScratchPolicy from_config(const ConfigManager& config);
+};
+
+} // namespace uniconv::core
@@ -0,0 +1,101 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace uniconv::core
+{
+
+    size_t ThreadPool::resolve_worker_count(size_t requested)
+    {
+        if (requested == 0)
+        {
+            requested = std::thread::hardware_concurrency();
+        }
+        return std::max<size_t>(requested, 1);
+    }
+
+    ThreadPool::ThreadPool(size_t workers)
+    {
+        size_t count = resolve_worker_count(workers);
+        workers_.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            workers_.emplace_back([this]()
+                                  { worker_loop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        task_cv_.notify_all();
+
+        for (auto &worker : workers_)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+    void ThreadPool::submit(Task task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        task_cv_.notify_one();
+    }
+
+    void ThreadPool::wait_idle()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this]()
+                      { return tasks_.empty() && active_ == 0; });
+    }
+
+    void ThreadPool::worker_loop()
+    {
+        while (true)
+        {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                task_cv_.wait(lock, [this]()
+                              { return stopping_ || !tasks_.empty(); });
+
+                // Drain remaining tasks before exiting
+                if (tasks_.empty())
+                {
+                    return;
+                }
+
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                ++active_;
+            }
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                // Tasks report their own failures; never let one kill a worker
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --active_;
+                if (tasks_.empty() && active_ == 0)
+                {
+                    idle_cv_.notify_all();
+                }
+            }
+        }
+    }
+
+} // namespace uniconv::core
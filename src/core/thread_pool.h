@@ -0,0 +1,53 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace uniconv::core
+{
+
+    // Fixed-size worker pool used for parallel pipeline execution.
+    // Tasks are run in FIFO order; the pool drains and joins on destruction.
+    class ThreadPool
+    {
+    public:
+        using Task = std::function<void()>;
+
+        // workers == 0 uses std::thread::hardware_concurrency()
+        explicit ThreadPool(size_t workers);
+        ~ThreadPool();
+
+        // Non-copyable
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // Queue a task for execution on a worker thread
+        void submit(Task task);
+
+        // Block until the queue is empty and no task is running
+        void wait_idle();
+
+        // Number of worker threads
+        size_t size() const { return workers_.size(); }
+
+        // Resolve a requested worker count (0 = hardware concurrency, min 1)
+        static size_t resolve_worker_count(size_t requested);
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> workers_;
+        std::deque<Task> tasks_;
+        std::mutex mutex_;
+        std::condition_variable task_cv_;
+        std::condition_variable idle_cv_;
+        size_t active_ = 0;
+        bool stopping_ = false;
+    };
+
+} // namespace uniconv::core
@@ -0,0 +1,127 @@
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define GETPID _getpid
+#else
+#include <unistd.h>
+#define GETPID getpid
+#endif
+
+namespace uniconv::core {
+
+namespace {
+
+struct TraceState {
+    std::atomic<bool> enabled{false};
+    std::mutex mutex;
+    std::filesystem::path path;
+    std::vector<nlohmann::json> events;
+    std::map<std::thread::id, int> thread_ids; // Small, stable tids for the viewer
+};
+
+TraceState& state() {
+    static TraceState instance;
+    return instance;
+}
+
+} // anonymous namespace
+
+void Trace::start(const std::filesystem::path& path) {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.path = path;
+    s.events.clear();
+    s.thread_ids.clear();
+    s.enabled = true;
+}
+
+bool Trace::enabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+bool Trace::finish() {
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!s.enabled) {
+        return true;
+    }
+    s.enabled = false;
+
+    nlohmann::json doc;
+    doc["displayTimeUnit"] = "ms";
+    doc["traceEvents"] = nlohmann::json::array();
+    int pid = GETPID();
+    doc["traceEvents"].push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", pid},
+                                  {"args", {{"name", "uniconv"}}}});
+    for (auto& event : s.events) {
+        event["pid"] = pid;
+        doc["traceEvents"].push_back(std::move(event));
+    }
+    s.events.clear();
+
+    std::ofstream out(s.path, std::ios::trunc);
+    out << doc.dump() << "\n";
+    return static_cast<bool>(out);
+}
+
+int64_t Trace::now_us() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - epoch)
+        .count();
+}
+
+void Trace::complete(const std::string& name, const char* category,
+                     int64_t start_us, int64_t duration_us, nlohmann::json args) {
+    if (!enabled()) {
+        return;
+    }
+
+    nlohmann::json event;
+    event["name"] = name;
+    event["cat"] = category;
+    event["ph"] = "X";
+    event["ts"] = start_us;
+    event["dur"] = duration_us;
+    if (!args.is_null()) {
+        event["args"] = std::move(args);
+    }
+
+    auto& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto [it, inserted] = s.thread_ids.emplace(std::this_thread::get_id(),
+                                               static_cast<int>(s.thread_ids.size()) + 1);
+    event["tid"] = it->second;
+    s.events.push_back(std::move(event));
+}
+
+TraceSpan::TraceSpan(std::string name, const char* category)
+    : active_(Trace::enabled())
+    , category_(category) {
+    if (active_) {
+        name_ = std::move(name);
+        start_us_ = Trace::now_us();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (active_) {
+        Trace::complete(name_, category_, start_us_, Trace::now_us() - start_us_, std::move(args_));
+    }
+}
+
+void TraceSpan::arg(const std::string& key, nlohmann::json value) {
+    if (active_) {
+        args_[key] = std::move(value);
+    }
+}
+
+} // namespace uniconv::core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+
+namespace uniconv::core {
+
+// Chrome trace-event recorder (--trace). Process-wide: once started, spans
+// from any thread are collected and written as a JSON trace file that
+// chrome://tracing and Perfetto open directly. Recording is a no-op until
+// start() is called.
+class Trace {
+public:
+    // Begin recording; the file is written by finish()
+    static void start(const std::filesystem::path& path);
+
+    static bool enabled();
+
+    // Write the recorded events and stop recording. Returns false if the
+    // file could not be written.
+    static bool finish();
+
+    // Microseconds on the trace clock
+    static int64_t now_us();
+
+    // Record a complete span ("X" event) on the calling thread
+    static void complete(const std::string& name, const char* category,
+                         int64_t start_us, int64_t duration_us,
+                         nlohmann::json args = nullptr);
+};
+
+// Records the enclosing scope as a span when tracing is enabled
+class TraceSpan {
+public:
+    TraceSpan(std::string name, const char* category);
+
+    // Build the name only when tracing is enabled
+    template <typename MakeName>
+        requires std::is_invocable_r_v<std::string, MakeName>
+    TraceSpan(MakeName&& make_name, const char* category)
+        : TraceSpan(Trace::enabled() ? std::string(make_name()) : std::string(), category) {}
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Whether the span is being recorded. Check it before building
+    // argument values that cost anything to produce.
+    bool active() const { return active_; }
+
+    // Attach a value shown with the span
+    void arg(const std::string& key, nlohmann::json value);
+
+private:
+    bool active_;
+    std::string name_;
+    const char* category_;
+    int64_t start_us_ = 0;
+    nlohmann::json args_;
+};
+
+} // namespace uniconv::core
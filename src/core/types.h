@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -160,11 +163,17 @@ namespace uniconv::core
         std::optional<std::filesystem::path> output;
         bool force = false;       // Overwrite existing
         bool json_output = false; // Output as JSON
+        bool json_stream = false; // Stream NDJSON events as results happen (implies json_output)
         bool verbose = false;     // Verbose output
         bool quiet = false;       // Suppress output
         bool dry_run = false;     // Don't actually execute
         bool recursive = false;   // Process directories recursively
         int timeout_seconds = 0;  // Plugin timeout (0 = no timeout)
+        int jobs = 1;             // Parallel pipeline workers (1 = serial, 0 = one per CPU)
+        int scatter_jobs = -1;    // Parallel scatter items (-1 = same as jobs)
+        bool pipelined = false;   // Stream scattered items through stages until collect
+        bool cache = false;       // Reuse outputs from the conversion cache
+        uintmax_t temp_budget = 0; // Max bytes of intermediates on disk (0 = unlimited)
 
         nlohmann::json to_json() const
         {
@@ -173,16 +182,31 @@ namespace uniconv::core
                 j["output"] = output->string();
             j["force"] = force;
             j["json_output"] = json_output;
+            if (json_stream)
+                j["json_stream"] = true;
             j["verbose"] = verbose;
             j["quiet"] = quiet;
             j["dry_run"] = dry_run;
             j["recursive"] = recursive;
             if (timeout_seconds > 0)
                 j["timeout_seconds"] = timeout_seconds;
+            if (jobs != 1)
+                j["jobs"] = jobs;
+            if (scatter_jobs >= 0)
+                j["scatter_jobs"] = scatter_jobs;
+            if (pipelined)
+                j["pipelined"] = true;
+            if (cache)
+                j["cache"] = true;
+            if (temp_budget > 0)
+                j["temp_budget"] = temp_budget;
             return j;
         }
     };
 
+    // File contents held in memory between buffer-capable plugins
+    using Buffer = std::vector<uint8_t>;
+
     // Request structure for plugin execution
     struct Request
     {
@@ -193,6 +217,11 @@ namespace uniconv::core
         CoreOptions core_options;
         std::vector<std::string> plugin_options;  // Options after --
 
+        // In-memory I/O (native ABI v4). With input_data set, source only
+        // names the data and need not exist on disk.
+        std::shared_ptr<const Buffer> input_data;
+        bool output_in_memory = false;            // Return output in Result::output_data
+
         nlohmann::json to_json() const
         {
             nlohmann::json j;
@@ -221,6 +250,8 @@ namespace uniconv::core
         std::optional<size_t> output_size;
         std::optional<std::string> error;
         nlohmann::json extra; // Plugin-specific result data
+        std::shared_ptr<const Buffer> output_data; // In-memory output (output names it)
+        uintmax_t peak_rss_kb = 0;                  // Plugin process peak RSS, 0 if unknown
 
         // Check if this result is a scatter (1→N) result
         bool is_scatter() const { return !outputs.empty(); }
@@ -360,6 +391,39 @@ namespace uniconv::core
     };
 
     // Plugin information
+    // What one conversion by a plugin needs, declared under "resources" in
+    // plugin.json. Used to schedule parallel work against memory and CPU
+    // budgets; zero memory means unknown.
+    struct ResourceHints
+    {
+        uint64_t memory_mb = 0; // Expected peak RSS
+        int threads = 1;        // Cores kept busy
+        bool exclusive = false; // Must run alone (e.g. a GPU model)
+
+        bool is_default() const { return memory_mb == 0 && threads == 1 && !exclusive; }
+
+        nlohmann::json to_json() const
+        {
+            nlohmann::json j;
+            if (memory_mb > 0)
+                j["memory_mb"] = memory_mb;
+            if (threads != 1)
+                j["threads"] = threads;
+            if (exclusive)
+                j["exclusive"] = true;
+            return j;
+        }
+
+        static ResourceHints from_json(const nlohmann::json &j)
+        {
+            ResourceHints h;
+            h.memory_mb = j.value("memory_mb", uint64_t{0});
+            h.threads = std::max(j.value("threads", 1), 1);
+            h.exclusive = j.value("exclusive", false);
+            return h;
+        }
+    };
+
     struct PluginInfo
     {
         std::string name;                       // Plugin name: "image-convert"
@@ -372,6 +436,8 @@ namespace uniconv::core
         std::string description;
         bool builtin = false;
         bool sink = false;          // Sink plugin: owns output, uniconv skips finalization
+        bool deterministic = true;  // Output depends only on input and options (cacheable)
+        ResourceHints resources;
 
         // Options
         std::vector<PluginOptionDef> options;
@@ -380,6 +446,18 @@ namespace uniconv::core
         std::vector<DataType> input_types;  // Supported input data types
         std::vector<DataType> output_types; // Supported output data types
 
+        // Stream in input_types / output_types marks a transport capability
+        // rather than content: the plugin reads its input / writes its output
+        // sequentially, so it can be connected to a neighbouring stage by a pipe
+        bool streams_input() const
+        {
+            return std::find(input_types.begin(), input_types.end(), DataType::Stream) != input_types.end();
+        }
+        bool streams_output() const
+        {
+            return std::find(output_types.begin(), output_types.end(), DataType::Stream) != output_types.end();
+        }
+
         nlohmann::json to_json() const
         {
             auto j = nlohmann::json{
@@ -397,6 +475,12 @@ namespace uniconv::core
             if (sink)
                 j["sink"] = true;
 
+            if (!deterministic)
+                j["deterministic"] = false;
+
+            if (!resources.is_default())
+                j["resources"] = resources.to_json();
+
             // Add data type info
             if (!input_types.empty())
             {
@@ -0,0 +1,196 @@
+#include "watch_journal.h"
+#include "config_manager.h"
+#include "utils/hash_utils.h"
+#include <nlohmann/json.hpp>
+
+namespace uniconv::core {
+
+namespace {
+
+// Rewrite when more than this many lines are superseded
+constexpr size_t kMaxStaleLines = 1024;
+
+int64_t mtime_ticks(const std::filesystem::path& file, std::error_code& ec) {
+    return std::filesystem::last_write_time(file, ec).time_since_epoch().count();
+}
+
+std::string to_line(const std::string& key, const JournalEntry& entry, const std::string& fingerprint) {
+    nlohmann::json j = {
+        {"path", key},
+        {"size", entry.size},
+        {"mtime", entry.mtime},
+        {"hash", entry.hash},
+        {"pipeline", fingerprint}};
+    return j.dump() + '\n';
+}
+
+} // anonymous namespace
+
+std::filesystem::path WatchJournal::get_default_journal_dir() {
+    auto config_dir = ConfigManager::get_default_config_dir();
+    if (config_dir.empty()) {
+        return std::filesystem::path();
+    }
+    return config_dir / "watch";
+}
+
+std::string WatchJournal::fingerprint(const std::string& pipeline,
+                                      const std::optional<std::filesystem::path>& output) {
+    std::string data = pipeline + '\n';
+    if (output) {
+        data += std::filesystem::absolute(*output).lexically_normal().string();
+    }
+    return utils::sha256_hex(data);
+}
+
+WatchJournal::WatchJournal(const std::filesystem::path& journal_dir,
+                           const std::filesystem::path& watch_dir,
+                           std::string fingerprint)
+    : watch_dir_(std::filesystem::absolute(watch_dir).lexically_normal())
+    , fingerprint_(std::move(fingerprint)) {
+    auto key = utils::sha256_hex(watch_dir_.string() + '\n' + fingerprint_).substr(0, 16);
+    journal_path_ = journal_dir / (key + ".journal");
+}
+
+bool WatchJournal::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    size_t lines = 0;
+    bool torn = false;
+    {
+        std::ifstream in(journal_path_, std::ios::binary);
+        std::string line;
+        while (std::getline(in, line)) {
+            ++lines;
+            auto j = nlohmann::json::parse(line, nullptr, false);
+            if (j.is_discarded() || !j.is_object() || j.value("pipeline", "") != fingerprint_) {
+                torn = true;
+                continue;
+            }
+            JournalEntry entry;
+            entry.size = j.value("size", uintmax_t{0});
+            entry.mtime = j.value("mtime", int64_t{0});
+            entry.hash = j.value("hash", "");
+            entries_[j.value("path", "")] = std::move(entry);
+        }
+        // A crash mid-append leaves a line without its newline
+        if (in.eof() && lines > 0) {
+            in.clear();
+            in.seekg(-1, std::ios::end);
+            torn = torn || in.get() != '\n';
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(journal_path_.parent_path(), ec);
+    if (torn || lines > entries_.size() + kMaxStaleLines) {
+        if (!rewrite_locked()) {
+            return false;
+        }
+    }
+
+    out_.open(journal_path_, std::ios::binary | std::ios::app);
+    return static_cast<bool>(out_);
+}
+
+JournalCheck WatchJournal::check(const std::filesystem::path& file) {
+    auto key = key_for(file);
+    JournalEntry recorded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return JournalCheck::New;
+        }
+        recorded = it->second;
+    }
+
+    std::error_code ec;
+    auto size = std::filesystem::file_size(file, ec);
+    if (ec || size != recorded.size) {
+        return JournalCheck::Changed;
+    }
+    auto mtime = mtime_ticks(file, ec);
+    if (!ec && mtime == recorded.mtime) {
+        return JournalCheck::Unchanged;
+    }
+
+    // Touched or rewritten with the same bytes: compare contents
+    auto hash = utils::sha256_hex_file(file);
+    if (!hash || *hash != recorded.hash) {
+        return JournalCheck::Changed;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    recorded.mtime = mtime;
+    entries_[key] = recorded;
+    append_locked(key, recorded);
+    return JournalCheck::Unchanged;
+}
+
+std::optional<JournalEntry> WatchJournal::snapshot(const std::filesystem::path& file) {
+    std::error_code ec;
+    JournalEntry entry;
+    entry.size = std::filesystem::file_size(file, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    entry.mtime = mtime_ticks(file, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto hash = utils::sha256_hex_file(file);
+    if (!hash) {
+        return std::nullopt;
+    }
+    entry.hash = *hash;
+    return entry;
+}
+
+void WatchJournal::record(const std::filesystem::path& file, const JournalEntry& entry) {
+    auto key = key_for(file);
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = entry;
+    append_locked(key, entry);
+}
+
+size_t WatchJournal::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::string WatchJournal::key_for(const std::filesystem::path& file) const {
+    auto absolute = std::filesystem::absolute(file).lexically_normal();
+    return absolute.lexically_relative(watch_dir_).generic_string();
+}
+
+void WatchJournal::append_locked(const std::string& key, const JournalEntry& entry) {
+    if (!out_) {
+        return;
+    }
+    out_ << to_line(key, entry, fingerprint_);
+    out_.flush();
+}
+
+bool WatchJournal::rewrite_locked() {
+    auto tmp = journal_path_;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        for (const auto& [key, entry] : entries_) {
+            out << to_line(key, entry, fingerprint_);
+        }
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, journal_path_, ec);
+    return !ec;
+}
+
+} // namespace uniconv::core
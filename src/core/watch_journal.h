@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace uniconv::core {
+
+// A watched file as it was when last converted
+struct JournalEntry {
+    uintmax_t size = 0;
+    int64_t mtime = 0; // file_time_type ticks
+    std::string hash;  // SHA-256 of the contents
+};
+
+// How a file compares with its journal entry
+enum class JournalCheck {
+    New,      // Never converted
+    Changed,  // Contents differ from the last conversion
+    Unchanged // Same contents (possibly a new mtime)
+};
+
+// Append-only journal of files converted by `uniconv watch`, so a restart
+// only catches up on files that are new or whose contents changed.
+// Stored in ~/.uniconv/watch/<key>.journal, one JSON line per conversion
+// with the path (relative to the watched directory), size, mtime, content
+// hash and pipeline fingerprint. The key hashes the watched directory and
+// the fingerprint, so a different pipeline starts with an empty journal.
+class WatchJournal {
+public:
+    // Default journal directory (~/.uniconv/watch)
+    static std::filesystem::path get_default_journal_dir();
+
+    // Identify a pipeline and the options that change its outputs
+    static std::string fingerprint(const std::string& pipeline,
+                                   const std::optional<std::filesystem::path>& output);
+
+    WatchJournal(const std::filesystem::path& journal_dir,
+                 const std::filesystem::path& watch_dir,
+                 std::string fingerprint);
+
+    // Read existing entries; rewrites the file when it holds many stale
+    // or torn lines. Returns false if the journal cannot be written.
+    bool open();
+
+    // Compare a file with its entry. Only hashes when the size matches but
+    // the mtime does not; an unchanged hash refreshes the entry's mtime.
+    JournalCheck check(const std::filesystem::path& file);
+
+    // Stat and hash a file as it is now (nullopt if unreadable)
+    static std::optional<JournalEntry> snapshot(const std::filesystem::path& file);
+
+    // Record a successful conversion of file in the state given by snapshot()
+    void record(const std::filesystem::path& file, const JournalEntry& entry);
+
+    size_t size() const;
+    const std::filesystem::path& path() const { return journal_path_; }
+
+private:
+    std::filesystem::path watch_dir_;
+    std::string fingerprint_;
+    std::filesystem::path journal_path_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, JournalEntry> entries_; // Relative path -> entry
+    std::ofstream out_;
+
+    std::string key_for(const std::filesystem::path& file) const;
+
+    // Append one line; called with mutex_ held
+    void append_locked(const std::string& key, const JournalEntry& entry);
+
+    // Replace the file with one line per entry; called with mutex_ held
+    bool rewrite_locked();
+};
+
+} // namespace uniconv::core
@@ -0,0 +1,183 @@
+#include "watch_queue.h"
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace uniconv::core
+{
+
+    namespace
+    {
+
+        // Two events for one file collapse into one job: a file that was
+        // created and then written to is still new
+        FileEvent merge(FileEvent queued, FileEvent incoming)
+        {
+            return queued == FileEvent::Created ? queued : incoming;
+        }
+
+    } // namespace
+
+    WatchQueue::WatchQueue(size_t workers, size_t capacity, Handler handler)
+        : handler_(std::move(handler)), capacity_(std::max<size_t>(capacity, 1))
+    {
+        size_t count = ThreadPool::resolve_worker_count(workers);
+        workers_.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            workers_.emplace_back([this]()
+                                  { worker_loop(); });
+        }
+    }
+
+    WatchQueue::~WatchQueue()
+    {
+        close();
+
+        for (auto &worker : workers_)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+    }
+
+    bool WatchQueue::push(const std::filesystem::path &path, FileEvent event,
+                          std::chrono::milliseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            if (closed_)
+            {
+                return false;
+            }
+
+            // Coalesce with a job that has not started yet
+            auto queued = queued_.find(path);
+            if (queued != queued_.end())
+            {
+                queued->second = merge(queued->second, event);
+                return true;
+            }
+
+            // Run again once the current job for this path is done
+            if (running_.count(path))
+            {
+                auto [rerun, inserted] = rerun_.emplace(path, event);
+                if (!inserted)
+                {
+                    rerun->second = merge(rerun->second, event);
+                }
+                return true;
+            }
+
+            if (order_.size() < capacity_)
+            {
+                break;
+            }
+
+            // Full: wait for a worker to take a job, then check again
+            if (space_cv_.wait_until(lock, deadline) == std::cv_status::timeout &&
+                order_.size() >= capacity_)
+            {
+                return false;
+            }
+        }
+
+        queued_.emplace(path, event);
+        order_.push_back(path);
+        lock.unlock();
+        work_cv_.notify_one();
+        return true;
+    }
+
+    void WatchQueue::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        work_cv_.notify_all();
+        space_cv_.notify_all();
+    }
+
+    size_t WatchQueue::discard_pending()
+    {
+        size_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dropped = order_.size() + rerun_.size();
+            order_.clear();
+            queued_.clear();
+            rerun_.clear();
+        }
+        space_cv_.notify_all();
+        idle_cv_.notify_all();
+        return dropped;
+    }
+
+    bool WatchQueue::wait_idle(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idle_cv_.wait_for(lock, timeout, [this]()
+                                 { return order_.empty() && running_.empty(); });
+    }
+
+    size_t WatchQueue::pending() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_.size();
+    }
+
+    void WatchQueue::worker_loop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            work_cv_.wait(lock, [this]()
+                          { return closed_ || !order_.empty(); });
+
+            // Drain remaining jobs before exiting
+            if (order_.empty())
+            {
+                return;
+            }
+
+            auto path = std::move(order_.front());
+            order_.pop_front();
+            auto event = queued_[path];
+            queued_.erase(path);
+            running_.insert(path);
+            space_cv_.notify_one();
+
+            lock.unlock();
+            try
+            {
+                handler_(path, event);
+            }
+            catch (...)
+            {
+                // The handler reports its own failures; never let one kill a worker
+            }
+            lock.lock();
+
+            running_.erase(path);
+            auto rerun = rerun_.find(path);
+            if (rerun != rerun_.end())
+            {
+                // Requeue even when full or closed: the event was accepted
+                queued_.emplace(path, rerun->second);
+                order_.push_back(path);
+                rerun_.erase(rerun);
+                work_cv_.notify_one();
+            }
+            else if (order_.empty() && running_.empty())
+            {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+
+} // namespace uniconv::core
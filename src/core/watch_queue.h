@@ -0,0 +1,74 @@
+#pragma once
+
+#include "watcher.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace uniconv::core
+{
+
+    // Bounded queue of watch events served by a fixed set of workers.
+    // Events for a path that is already queued are coalesced into one job;
+    // a path is never processed by two workers at once.
+    class WatchQueue
+    {
+    public:
+        using Handler = std::function<void(const std::filesystem::path &, FileEvent)>;
+
+        // workers == 0 uses std::thread::hardware_concurrency()
+        WatchQueue(size_t workers, size_t capacity, Handler handler);
+
+        // Closes the queue and finishes every accepted job
+        ~WatchQueue();
+
+        // Non-copyable
+        WatchQueue(const WatchQueue &) = delete;
+        WatchQueue &operator=(const WatchQueue &) = delete;
+
+        // Queue an event. Blocks while the queue is full (backpressure), up
+        // to timeout. Returns false if the event was not accepted because
+        // the queue stayed full or is closed.
+        bool push(const std::filesystem::path &path, FileEvent event,
+                  std::chrono::milliseconds timeout);
+
+        // Stop accepting events; queued jobs still run
+        void close();
+
+        // Drop queued jobs that have not started; returns how many
+        size_t discard_pending();
+
+        // Wait until no job is queued or running. Returns false on timeout.
+        bool wait_idle(std::chrono::milliseconds timeout);
+
+        // Jobs queued but not started
+        size_t pending() const;
+
+    private:
+        void worker_loop();
+
+        Handler handler_;
+        size_t capacity_;
+        std::vector<std::thread> workers_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable work_cv_;  // Job queued or queue closed
+        std::condition_variable space_cv_; // Job started or queue closed
+        std::condition_variable idle_cv_;  // Job finished
+
+        std::deque<std::filesystem::path> order_;            // Queued paths, oldest first
+        std::map<std::filesystem::path, FileEvent> queued_;  // Queued path -> event
+        std::set<std::filesystem::path> running_;            // Paths being processed
+        std::map<std::filesystem::path, FileEvent> rerun_;   // Changed again while running
+        bool closed_ = false;
+    };
+
+} // namespace uniconv::core
@@ -1,9 +1,53 @@
 #include "watcher.h"
+#include <algorithm>
+#include <cerrno>
 #include <thread>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+#include <unordered_map>
+#endif
+
 namespace uniconv::core
 {
 
+#ifdef __linux__
+    namespace
+    {
+
+        constexpr uint32_t kWatchMask = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO |
+                                        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+        // Changes made on other hosts never reach inotify on these
+        bool is_network_filesystem(const std::filesystem::path &directory)
+        {
+            struct statfs fs{};
+            if (statfs(directory.c_str(), &fs) != 0)
+            {
+                return true;
+            }
+
+            switch (static_cast<uint32_t>(fs.f_type))
+            {
+            case 0x6969:     // NFS
+            case 0x517B:     // SMB
+            case 0xFF534D42: // CIFS
+            case 0xFE534D42: // SMB2
+            case 0x65735546: // FUSE
+            case 0x01021997: // 9P
+                return true;
+            default:
+                return false;
+            }
+        }
+
+    } // namespace
+#endif
+
     Watcher::Watcher(std::chrono::milliseconds poll_interval)
         : poll_interval_(poll_interval)
     {
@@ -12,6 +56,13 @@ namespace uniconv::core
     Watcher::~Watcher()
     {
         stop();
+
+#ifdef __linux__
+        if (wake_fd_ >= 0)
+        {
+            close(wake_fd_);
+        }
+#endif
     }
 
     void Watcher::set_callback(WatchCallback callback)
@@ -19,6 +70,21 @@ namespace uniconv::core
         callback_ = std::move(callback);
     }
 
+    void Watcher::set_ready_callback(std::function<void()> callback)
+    {
+        ready_callback_ = std::move(callback);
+    }
+
+    void Watcher::notify_ready()
+    {
+        // A fallback from inotify to polling does not count as a new start
+        if (!ready_notified_ && ready_callback_)
+        {
+            ready_notified_ = true;
+            ready_callback_();
+        }
+    }
+
     void Watcher::set_extensions(const std::set<std::string> &extensions)
     {
         extensions_ = extensions;
@@ -43,10 +109,9 @@ namespace uniconv::core
         return extensions_.count(ext) > 0;
     }
 
-    std::map<std::filesystem::path, std::filesystem::file_time_type>
-    Watcher::scan_directory(const std::filesystem::path &directory, bool recursive)
+    Watcher::FileTimes Watcher::scan_directory(const std::filesystem::path &directory, bool recursive)
     {
-        std::map<std::filesystem::path, std::filesystem::file_time_type> files;
+        FileTimes files;
 
         try
         {
@@ -79,6 +144,16 @@ namespace uniconv::core
         return files;
     }
 
+    void Watcher::set_backend(WatchBackend backend)
+    {
+        preferred_backend_ = backend;
+    }
+
+    WatchBackend Watcher::backend() const
+    {
+        return backend_;
+    }
+
     bool Watcher::watch(const std::filesystem::path &directory, bool recursive)
     {
         if (!std::filesystem::exists(directory) || !std::filesystem::is_directory(directory))
@@ -87,9 +162,33 @@ namespace uniconv::core
         }
 
         running_ = true;
+        ready_notified_ = false;
+
+        // What inotify had seen when it gave up, if it got as far as watching
+        std::optional<FileTimes> seen;
+
+#ifdef __linux__
+        if (preferred_backend_ == WatchBackend::Inotify && watch_inotify(directory, recursive, seen))
+        {
+            return true;
+        }
+#endif
+
+        if (running_)
+        {
+            watch_polling(directory, recursive, std::move(seen));
+        }
+        return true;
+    }
 
-        // Initial scan to get baseline
-        auto previous = scan_directory(directory, recursive);
+    void Watcher::watch_polling(const std::filesystem::path &directory, bool recursive,
+                                std::optional<FileTimes> baseline)
+    {
+        backend_ = WatchBackend::Polling;
+
+        // Initial scan to get baseline, unless taking over from inotify
+        auto previous = baseline ? std::move(*baseline) : scan_directory(directory, recursive);
+        notify_ready();
 
         while (running_)
         {
@@ -124,13 +223,235 @@ namespace uniconv::core
 
             previous = std::move(current);
         }
+    }
 
-        return true;
+#ifdef __linux__
+    bool Watcher::watch_inotify(const std::filesystem::path &directory, bool recursive,
+                                std::optional<FileTimes> &seen)
+    {
+        if (is_network_filesystem(directory))
+        {
+            return false;
+        }
+
+        int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        std::unordered_map<int, std::filesystem::path> dirs; // Watch descriptor -> directory
+        std::set<std::filesystem::path> created;             // Created, not yet closed after writing
+
+        // Report a file and remember its time for a fallback to polling
+        auto report = [&](const std::filesystem::path &path, FileEvent event)
+        {
+            std::error_code ec;
+            auto mtime = std::filesystem::last_write_time(path, ec);
+            if (!ec && seen)
+            {
+                (*seen)[path] = mtime;
+            }
+            if (callback_)
+            {
+                callback_(path, event);
+            }
+        };
+
+        // Watch dir and, when recursive, every directory below it. A directory
+        // that appears while watching may already hold files; report those.
+        auto add_watches = [&](const std::filesystem::path &dir, bool report_existing)
+        {
+            int wd = inotify_add_watch(fd, dir.c_str(), kWatchMask);
+            if (wd < 0)
+            {
+                return false;
+            }
+            dirs[wd] = dir;
+
+            if (!recursive)
+            {
+                return true;
+            }
+
+            std::error_code ec;
+            auto options = std::filesystem::directory_options::skip_permission_denied;
+            for (std::filesystem::recursive_directory_iterator it(dir, options, ec), end;
+                 !ec && it != end; it.increment(ec))
+            {
+                if (it->is_directory(ec) && !it->is_symlink(ec))
+                {
+                    wd = inotify_add_watch(fd, it->path().c_str(), kWatchMask);
+                    if (wd < 0)
+                    {
+                        return false;
+                    }
+                    dirs[wd] = it->path();
+                }
+                else if (report_existing && it->is_regular_file(ec) && matches_filter(it->path()))
+                {
+                    report(it->path(), FileEvent::Created);
+                }
+            }
+            return true;
+        };
+
+        // Stop watching a directory moved out of the tree, and everything below it
+        auto drop_watches = [&](const std::filesystem::path &dir)
+        {
+            for (auto it = dirs.begin(); it != dirs.end();)
+            {
+                auto rel = it->second.lexically_relative(dir);
+                if (!rel.empty() && *rel.begin() != "..")
+                {
+                    inotify_rm_watch(fd, it->first);
+                    it = dirs.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        };
+
+        if (!add_watches(directory, false))
+        {
+            // Typically the per-user watch limit
+            close(fd);
+            return false;
+        }
+
+        // Kept open for the Watcher's lifetime so stop() never writes to a
+        // descriptor that was closed and reused
+        if (wake_fd_ < 0)
+        {
+            wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        }
+        int wake = wake_fd_;
+
+        // Baseline for a fallback: files created before the watches were
+        // added are not reported by either backend
+        seen = scan_directory(directory, recursive);
+        backend_ = WatchBackend::Inotify;
+        notify_ready();
+
+        bool abandoned = false;
+        alignas(inotify_event) char buffer[64 * 1024];
+        pollfd fds[2] = {{fd, POLLIN, 0}, {wake, POLLIN, 0}};
+
+        while (running_ && !abandoned)
+        {
+            // The timeout only matters if the eventfd could not be created
+            int ready = ::poll(fds, wake >= 0 ? 2 : 1, static_cast<int>(poll_interval_.count()));
+            if (ready < 0 && errno != EINTR)
+            {
+                abandoned = true;
+                break;
+            }
+            if (ready > 0 && wake >= 0 && (fds[1].revents & POLLIN))
+            {
+                uint64_t count;
+                [[maybe_unused]] auto drained = read(wake, &count, sizeof(count));
+            }
+            if (ready <= 0 || !running_ || !(fds[0].revents & POLLIN))
+            {
+                continue;
+            }
+
+            ssize_t len = read(fd, buffer, sizeof(buffer));
+            if (len <= 0)
+            {
+                continue;
+            }
+
+            for (char *p = buffer; p < buffer + len && !abandoned;)
+            {
+                auto *event = reinterpret_cast<inotify_event *>(p);
+                p += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    // Events were lost; polling catches up against seen
+                    abandoned = true;
+                    break;
+                }
+
+                auto dir_it = dirs.find(event->wd);
+                if (dir_it == dirs.end())
+                {
+                    continue;
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    dirs.erase(dir_it);
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                {
+                    if (dir_it->second == directory)
+                    {
+                        abandoned = true;
+                    }
+                    else if (!std::filesystem::is_directory(dir_it->second))
+                    {
+                        // Moved out of the tree; moves within it re-add the
+                        // watch under the new name before this event
+                        drop_watches(dir_it->second);
+                    }
+                    continue;
+                }
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                auto path = dir_it->second / event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)) &&
+                        !add_watches(path, true))
+                    {
+                        abandoned = true;
+                    }
+                    continue;
+                }
+
+                // Wait for the writer to close a newly created file
+                if (event->mask & IN_CREATE)
+                {
+                    // Until it is reported, polling treats it as new
+                    created.insert(path);
+                    seen->erase(path);
+                    continue;
+                }
+
+                bool is_new = created.erase(path) > 0 || (event->mask & IN_MOVED_TO);
+                if (matches_filter(path))
+                {
+                    report(path, is_new ? FileEvent::Created : FileEvent::Modified);
+                }
+            }
+        }
+
+        close(fd);
+
+        return !abandoned;
     }
+#endif
 
     void Watcher::stop()
     {
         running_ = false;
+
+#ifdef __linux__
+        // Async-signal-safe: stop() is called from signal handlers
+        int wake = wake_fd_;
+        if (wake >= 0)
+        {
+            uint64_t one = 1;
+            [[maybe_unused]] auto written = write(wake, &one, sizeof(one));
+        }
+#endif
     }
 
     bool Watcher::is_running() const
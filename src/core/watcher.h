@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -22,7 +23,17 @@ namespace uniconv::core
     // Callback signature: (path, event) -> void
     using WatchCallback = std::function<void(const std::filesystem::path &, FileEvent)>;
 
-    // Simple polling-based directory watcher
+    // How a Watcher observes the directory
+    enum class WatchBackend
+    {
+        Polling, // Rescan every poll interval
+        Inotify  // Kernel events (Linux); files are reported once fully written
+    };
+
+    // Directory watcher: inotify on Linux, polling elsewhere. Falls back to
+    // polling on event queue overflow, watch limits, or network filesystems.
+    // A fallback after watching started compares against what inotify had
+    // seen, so changes whose events were lost are still reported.
     class Watcher
     {
     public:
@@ -32,6 +43,10 @@ namespace uniconv::core
         // Set the callback for file events
         void set_callback(WatchCallback callback);
 
+        // Called once per watch() when the directory is being observed;
+        // every change from then on is reported
+        void set_ready_callback(std::function<void()> callback);
+
         // Start watching a directory (blocking until stop() is called)
         // Returns false if directory doesn't exist or isn't a directory
         bool watch(const std::filesystem::path &directory, bool recursive = false);
@@ -45,17 +60,43 @@ namespace uniconv::core
         // Get list of supported extensions to filter (empty = all files)
         void set_extensions(const std::set<std::string> &extensions);
 
+        // Preferred backend (default Inotify; Polling where unavailable)
+        void set_backend(WatchBackend backend);
+
+        // Backend currently in use
+        WatchBackend backend() const;
+
     private:
+        using FileTimes = std::map<std::filesystem::path, std::filesystem::file_time_type>;
+
+        // Poll until stop(). With a baseline, the first poll reports every
+        // file that is new or changed relative to it.
+        void watch_polling(const std::filesystem::path &directory, bool recursive,
+                           std::optional<FileTimes> baseline = std::nullopt);
+
+        // Follow inotify events until stop(). Returns false if inotify
+        // cannot be used or had to be abandoned. Once watching starts, seen
+        // holds the files as of the start plus every file reported since.
+        bool watch_inotify(const std::filesystem::path &directory, bool recursive,
+                           std::optional<FileTimes> &seen);
+
         // Scan directory and return files with their modification times
-        std::map<std::filesystem::path, std::filesystem::file_time_type>
-        scan_directory(const std::filesystem::path &directory, bool recursive);
+        FileTimes scan_directory(const std::filesystem::path &directory, bool recursive);
+
+        // Invoke the ready callback once per watch()
+        void notify_ready();
 
         // Check if file matches extension filter
         bool matches_filter(const std::filesystem::path &path) const;
 
         std::chrono::milliseconds poll_interval_;
         std::atomic<bool> running_{false};
+        WatchBackend preferred_backend_ = WatchBackend::Inotify;
+        std::atomic<WatchBackend> backend_{WatchBackend::Polling};
+        std::atomic<int> wake_fd_{-1}; // Wakes the inotify loop on stop()
         WatchCallback callback_;
+        std::function<void()> ready_callback_;
+        bool ready_notified_ = false;
         std::set<std::string> extensions_;
     };
 
@@ -6,22 +6,36 @@
 #include "cli/commands/config_command.h"
 #include "cli/commands/update_command.h"
 #include "cli/commands/detect_command.h"
+#include "cli/commands/cache_command.h"
+#include "cli/commands/stats_command.h"
 #include "cli/pipeline_parser.h"
+#include "core/batch_runner.h"
 #include "core/engine.h"
 #include "core/preset_manager.h"
 #include "core/config_manager.h"
+#include "core/perf_stats.h"
 #include "core/pipeline_executor.h"
+#include "core/trace.h"
 #include "core/watcher.h"
+#include "core/watch_queue.h"
+#include "core/watch_journal.h"
 #include "core/output/output.h"
 #include "core/output/console_output.h"
 #include "core/output/json_output.h"
 #include "builtins/clipboard.h"
+#include "utils/file_utils.h"
 #include "utils/mime_detector.h"
+#include "utils/string_utils.h"
 #include <uniconv/version.h>
 #include <csignal>
 #include <fstream>
+#include <future>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #ifdef _WIN32
 #include <io.h>
@@ -38,8 +52,13 @@ using namespace uniconv;
 // Global watcher pointer for signal handling
 static core::Watcher *g_watcher = nullptr;
 
+// Signals received in watch mode: the first stops watching and drains
+// queued files, the second drops whatever has not started yet
+static volatile std::sig_atomic_t g_watch_signals = 0;
+
 void signal_handler(int)
 {
+    g_watch_signals = g_watch_signals + 1;
     if (g_watcher)
     {
         g_watcher->stop();
@@ -49,12 +68,83 @@ void signal_handler(int)
 std::shared_ptr<core::output::IOutput> create_output(const cli::ParsedArgs& args) {
     if (args.core_options.json_output) {
         return std::make_shared<core::output::JsonOutput>(
-            std::cout, std::cerr, args.core_options.verbose, args.core_options.quiet);
+            std::cout, std::cerr, args.core_options.verbose, args.core_options.quiet,
+            args.core_options.json_stream);
     }
     return std::make_shared<core::output::ConsoleOutput>(
         std::cout, std::cerr, args.core_options.verbose, args.core_options.quiet);
 }
 
+// Write the --trace file, if one was requested
+void finish_trace(const cli::ParsedArgs& args,
+                  const std::shared_ptr<core::output::IOutput>& output) {
+    if (args.trace_file && !core::Trace::finish()) {
+        output->warning("Cannot write trace file: " + *args.trace_file);
+    }
+}
+
+// Record this run's plugin timings in the performance history
+void save_stats(const std::shared_ptr<core::PerfStats>& stats,
+                const std::shared_ptr<core::output::IOutput>& output) {
+    if (stats && !stats->save()) {
+        output->debug("Cannot write performance stats: " + stats->path().string());
+    }
+}
+
+// Text table for --explain
+std::string format_estimate(const core::PipelineEstimate& estimate) {
+    auto seconds = [](int64_t ms) {
+        std::ostringstream s;
+        s << std::fixed << std::setprecision(1) << static_cast<double>(ms) / 1000.0 << "s";
+        return s.str();
+    };
+
+    std::ostringstream text;
+    text << std::left << std::setw(8) << "STAGE" << std::setw(14) << "TARGET"
+         << std::setw(22) << "PLUGIN" << std::setw(12) << "INPUT"
+         << std::setw(10) << "TIME" << std::setw(12) << "OUTPUT" << "SAMPLES\n";
+    for (const auto& stage : estimate.stages) {
+        text << std::setw(8) << stage.stage_index << std::setw(14) << stage.target
+             << std::setw(22) << (stage.plugin.empty() ? "?" : stage.plugin)
+             << std::setw(12) << utils::format_size(static_cast<size_t>(stage.input_size));
+        if (stage.duration_ms) {
+            text << std::setw(10) << ((stage.exact ? "" : "~") + seconds(*stage.duration_ms))
+                 << std::setw(12) << utils::format_size(static_cast<size_t>(stage.output_size.value_or(0)))
+                 << stage.samples;
+        } else {
+            text << std::setw(10) << "-" << std::setw(12) << "-" << "no history";
+        }
+        text << "\n";
+    }
+    text << "Estimated total: " << seconds(estimate.total_duration_ms);
+    if (estimate.unknown_stages > 0) {
+        text << " + " << estimate.unknown_stages << " stage(s) without history";
+    }
+    return text.str();
+}
+
+// Plugin choice per stage for --why
+std::string format_why(const core::PipelineEstimate& estimate) {
+    std::ostringstream text;
+    text << "Plugin choice:";
+    for (const auto& stage : estimate.stages) {
+        text << "\n  [" << stage.stage_index << "] " << stage.target << " <- "
+             << (stage.plugin.empty() ? "no plugin" : stage.plugin)
+             << " (" << stage.matched_by << ")";
+        for (const auto& c : stage.candidates) {
+            text << "\n        " << std::left << std::setw(24) << c.plugin;
+            if (c.estimated_ms) {
+                text << std::fixed << std::setprecision(2)
+                     << static_cast<double>(*c.estimated_ms) / 1000.0 << "s over "
+                     << c.samples << " run(s)";
+            } else {
+                text << "no history";
+            }
+        }
+    }
+    return text.str();
+}
+
 int main(int argc, char **argv)
 {
     try
@@ -87,6 +177,57 @@ int main(int argc, char **argv)
         // Create output based on args
         auto output = create_output(args);
 
+        // Opt-in conversion cache
+        if (args.core_options.cache)
+        {
+            engine->set_cache(core::ConversionCache::from_config(*config_manager));
+        }
+
+        // Where pipelines keep intermediates (scratch.* settings)
+        auto scratch = core::ScratchPolicy::from_config(*config_manager);
+
+        // One memory / CPU budget (scheduler.* settings) for every pipeline
+        // run by this process, including concurrent watch workers. Without
+        // scheduler.cpus, explicitly requested parallelism is honoured.
+        int requested_jobs = std::max(args.core_options.jobs, args.core_options.scatter_jobs);
+        if (args.command == cli::Command::Watch)
+            requested_jobs *= static_cast<int>(std::max(args.watch_workers, size_t{1}));
+        auto scheduler = std::make_shared<core::ResourceScheduler>(
+            core::ResourceBudget::from_config(*config_manager),
+            static_cast<unsigned>(std::max(requested_jobs, 0)));
+
+        // Performance history (stats.* settings): conversions record their
+        // timings; progress ETAs and --explain read them back
+        std::shared_ptr<core::PerfStats> stats;
+        if (args.command == cli::Command::Pipeline || args.command == cli::Command::Watch)
+        {
+            stats = core::PerfStats::from_config(*config_manager);
+            if (stats)
+            {
+                stats->load();
+                engine->set_stats(stats);
+            }
+        }
+
+        // Plugin resolution policy: --resolve-policy, else resolve.policy
+        {
+            auto policy_name = args.resolve_policy;
+            if (!policy_name)
+                policy_name = config_manager->get("resolve.policy");
+            if (policy_name)
+            {
+                if (auto policy = core::resolution_policy_from_string(*policy_name))
+                    engine->plugin_manager().set_policy(*policy);
+                else
+                    output->warning("Unknown resolution policy: " + *policy_name);
+            }
+        }
+
+        if (args.trace_file)
+        {
+            core::Trace::start(*args.trace_file);
+        }
+
         // Route to appropriate command handler
         switch (args.command)
         {
@@ -153,9 +294,20 @@ int main(int argc, char **argv)
             return cmd.execute(args);
         }
 
+        case cli::Command::Cache:
+        {
+            cli::commands::CacheCommand cmd(config_manager, output);
+            return cmd.execute(args);
+        }
+
+        case cli::Command::Stats:
+        {
+            cli::commands::StatsCommand cmd(config_manager, output);
+            return cmd.execute(args);
+        }
+
         case cli::Command::Watch:
         {
-            cli::PipelineParser pipeline_parser;
             std::filesystem::path watch_dir = args.watch_dir;
             std::string pipeline_str = args.pipeline;
 
@@ -165,36 +317,83 @@ int main(int argc, char **argv)
                 return 1;
             }
 
+            // Resolve the pipeline once; each event only binds the new file
+            cli::PipelineParser watch_parser;
+            auto watch_parse = watch_parser.parse(pipeline_str, watch_dir, args.core_options);
+            if (!watch_parse.success)
+            {
+                output->error("Pipeline error: " + watch_parse.error);
+                return 1;
+            }
+            auto prepared = core::PipelineExecutor(engine, scratch).prepare(watch_parse.pipeline);
+            if (!prepared.success)
+            {
+                output->error("Pipeline error: " + prepared.error);
+                return 1;
+            }
+
             output->info("Watching directory: " + watch_dir.string());
             output->info("Pipeline: " + pipeline_str);
             output->info("Press Ctrl+C to stop");
 
-            core::Watcher watcher;
-            g_watcher = &watcher;
-
-            // Set up signal handlers
-            std::signal(SIGINT, signal_handler);
-            std::signal(SIGTERM, signal_handler);
+            // Journal of converted files, so a restart only catches up on
+            // files that are new or changed since they were last converted
+            std::unique_ptr<core::WatchJournal> journal;
+            if (!args.watch_no_journal)
+            {
+                journal = std::make_unique<core::WatchJournal>(
+                    core::WatchJournal::get_default_journal_dir(), watch_dir,
+                    core::WatchJournal::fingerprint(pipeline_str, args.core_options.output));
+                if (!journal->open())
+                {
+                    output->warning("Cannot write watch journal " + journal->path().string() +
+                                    "; changes made while not watching will be missed");
+                    journal.reset();
+                }
+            }
 
-            watcher.set_callback([&](const std::filesystem::path &file_path, core::FileEvent event)
-                                 {
-                std::string event_str = (event == core::FileEvent::Created) ? "New" : "Modified";
-                output->info(event_str + " file: " + file_path.filename().string());
+            // Conversions run on queue workers so a slow file never delays
+            // detection of the next one. Stage progress is only shown when
+            // files are converted one at a time.
+            std::mutex watch_output_mutex;
+            bool show_stages = args.watch_workers == 1;
+            core::WatchQueue queue(args.watch_workers, args.watch_queue_size,
+                                   [&](const std::filesystem::path &file_path, core::FileEvent event)
+                                   {
+                std::string name = file_path.filename().string();
+
+                // Skip touched files whose contents were already converted
+                std::optional<core::JournalEntry> snapshot;
+                if (journal)
+                {
+                    if (journal->check(file_path) == core::JournalCheck::Unchanged)
+                    {
+                        std::lock_guard<std::mutex> lock(watch_output_mutex);
+                        output->debug("Unchanged file: " + name);
+                        return;
+                    }
+                    snapshot = core::WatchJournal::snapshot(file_path);
+                }
 
-                // Parse and execute pipeline for this file
-                auto file_parse_result = pipeline_parser.parse(pipeline_str, file_path, args.core_options);
-                if (!file_parse_result.success)
                 {
-                    output->error("  Pipeline error: " + file_parse_result.error);
-                    return;
+                    std::lock_guard<std::mutex> lock(watch_output_mutex);
+                    std::string event_str = (event == core::FileEvent::Created) ? "New" : "Modified";
+                    output->info(event_str + " file: " + name);
                 }
 
-                core::PipelineExecutor executor(engine);
-                auto result = executor.execute(file_parse_result.pipeline, output);
+                core::PipelineExecutor executor(engine, scratch);
+                executor.set_scheduler(scheduler);
+                auto result = executor.execute(*prepared.prepared, file_path, show_stages ? output : nullptr);
+
+                if (result.success && journal && snapshot)
+                {
+                    journal->record(file_path, *snapshot);
+                }
 
+                std::lock_guard<std::mutex> lock(watch_output_mutex);
                 if (result.success)
                 {
-                    output->success("  Completed");
+                    output->success("  Completed: " + name);
                     for (const auto &out : result.final_outputs)
                     {
                         output->info("    -> " + out.string());
@@ -202,12 +401,110 @@ int main(int argc, char **argv)
                 }
                 else if (result.error)
                 {
-                    output->error("  Failed: " + *result.error);
+                    output->error("  Failed: " + name + ": " + *result.error);
                 } });
 
+            core::Watcher watcher;
+            g_watcher = &watcher;
+
+            // Set up signal handlers
+            g_watch_signals = 0;
+            std::signal(SIGINT, signal_handler);
+            std::signal(SIGTERM, signal_handler);
+
+            // A full queue holds the watcher back until a worker frees a slot
+            auto enqueue = [&](const std::filesystem::path &file_path, core::FileEvent event)
+            {
+                while (!queue.push(file_path, event, std::chrono::milliseconds(200)))
+                {
+                    if (!watcher.is_running())
+                    {
+                        return;
+                    }
+                }
+            };
+            watcher.set_callback(enqueue);
+
+            // Catch up on files changed while not watching. The scan starts
+            // once the watcher is observing, so nothing falls in between;
+            // files seen by both are coalesced or skipped by the journal.
+            std::promise<void> watching;
+            std::once_flag watching_once;
+            auto mark_watching = [&]()
+            {
+                std::call_once(watching_once, [&]()
+                               { watching.set_value(); });
+            };
+            std::thread catch_up;
+            if (journal)
+            {
+                watcher.set_ready_callback(mark_watching);
+                catch_up = std::thread([&, started = watching.get_future()]()
+                                       {
+                    started.wait();
+                    std::vector<std::filesystem::path> files;
+                    try
+                    {
+                        files = utils::get_files_in_directory(watch_dir, args.core_options.recursive);
+                    }
+                    catch (const std::filesystem::filesystem_error &e)
+                    {
+                        std::lock_guard<std::mutex> lock(watch_output_mutex);
+                        output->warning(std::string("Catch-up scan failed: ") + e.what());
+                    }
+
+                    size_t queued = 0;
+                    for (const auto &file : files)
+                    {
+                        if (!watcher.is_running())
+                        {
+                            break;
+                        }
+                        auto state = journal->check(file);
+                        if (state != core::JournalCheck::Unchanged)
+                        {
+                            enqueue(file, state == core::JournalCheck::New ? core::FileEvent::Created
+                                                                           : core::FileEvent::Modified);
+                            ++queued;
+                        }
+                    }
+                    if (queued > 0)
+                    {
+                        std::lock_guard<std::mutex> lock(watch_output_mutex);
+                        output->info("Catching up on " + std::to_string(queued) + " new or changed file(s)");
+                    } });
+            }
+
             watcher.watch(watch_dir, args.core_options.recursive);
 
+            mark_watching();
+            if (catch_up.joinable())
+            {
+                catch_up.join();
+            }
+
+            // Drain: finish queued files unless interrupted again
+            queue.close();
+            if (!queue.wait_idle(std::chrono::milliseconds(0)))
+            {
+                std::lock_guard<std::mutex> lock(watch_output_mutex);
+                output->info("Finishing queued files (press Ctrl+C again to skip them)");
+            }
+            bool discarded = false;
+            while (!queue.wait_idle(std::chrono::milliseconds(200)))
+            {
+                if (!discarded && g_watch_signals > 1)
+                {
+                    size_t dropped = queue.discard_pending();
+                    discarded = true;
+                    std::lock_guard<std::mutex> lock(watch_output_mutex);
+                    output->warning("Skipped " + std::to_string(dropped) + " queued file(s)");
+                }
+            }
+
             g_watcher = nullptr;
+            save_stats(stats, output);
+            finish_trace(args, output);
             output->info("Watch mode stopped");
             return 0;
         }
@@ -306,8 +603,92 @@ int main(int argc, char **argv)
             if (args.input_format.has_value())
                 parse_result.pipeline.input_format = *args.input_format;
 
-            core::PipelineExecutor executor(engine);
+            // --batch: the same pipeline on every file of a directory source,
+            // parsed once, with files converted in parallel
+            if (args.batch)
+            {
+                if (!std::filesystem::is_directory(source))
+                {
+                    output->error("--batch requires a directory source");
+                    return 1;
+                }
+                if (auto problem = core::BatchRunner::check(parse_result.pipeline))
+                {
+                    output->error("Pipeline error: " + *problem);
+                    return 1;
+                }
+
+                core::BatchRunner runner(engine, scratch);
+                runner.set_scheduler(scheduler);
+                auto batch = runner.run(
+                    source, parse_result.pipeline,
+                    static_cast<size_t>(std::max(args.core_options.jobs, 0)),
+                    [&](const core::BatchFileResult &file, size_t)
+                    {
+                        if (args.core_options.json_output)
+                            return;
+                        auto name = file.source.lexically_relative(source).string();
+                        if (!file.success)
+                            output->error("Failed: " + name + ": " + file.error.value_or("unknown error"));
+                        else
+                            output->debug(name + ": " + std::to_string(file.outputs.size()) + " output(s)");
+                    });
+                if (batch.error)
+                {
+                    output->error("Pipeline error: " + *batch.error);
+                    return 1;
+                }
+                save_stats(stats, output);
+                finish_trace(args, output);
+
+                if (args.core_options.json_output)
+                {
+                    output->data(batch.to_json());
+                }
+                else
+                {
+                    std::string summary = "Converted " + std::to_string(batch.succeeded) + " of " +
+                                          std::to_string(batch.files.size()) + " file(s) in " +
+                                          std::to_string(batch.total_duration_ms) + "ms";
+                    if (batch.success())
+                        output->success(summary);
+                    else
+                        output->error(summary + " (" + std::to_string(batch.failed) + " failed)");
+                }
+                return batch.success() ? 0 : 1;
+            }
+
+            core::PipelineExecutor executor(engine, scratch);
+            executor.set_scheduler(scheduler);
+
+            // --explain: show the expected cost instead of running
+            if (args.explain)
+            {
+                auto estimate = executor.explain(parse_result.pipeline);
+                if (!stdin_temp_file.empty())
+                {
+                    std::error_code ec;
+                    std::filesystem::remove(stdin_temp_file, ec);
+                }
+                auto text = format_estimate(estimate);
+                if (args.why)
+                    text += "\n" + format_why(estimate);
+                output->data(estimate.to_json(), text);
+                return 0;
+            }
+
+            // --why: report plugin choices up front (text) or with the result (JSON)
+            std::optional<core::PipelineEstimate> why;
+            if (args.why)
+            {
+                why = executor.explain(parse_result.pipeline);
+                if (!args.core_options.json_output)
+                    output->info(format_why(*why));
+            }
+
             auto result = executor.execute(parse_result.pipeline, output);
+            save_stats(stats, output);
+            finish_trace(args, output);
 
             // Cleanup stdin temp file
             if (!stdin_temp_file.empty())
@@ -318,7 +699,14 @@ int main(int argc, char **argv)
 
             if (args.core_options.json_output)
             {
-                output->data(result.to_json());
+                auto j = result.to_json();
+                if (why)
+                {
+                    j["why"] = nlohmann::json::array();
+                    for (const auto &stage : why->stages)
+                        j["why"].push_back(stage.to_json());
+                }
+                output->data(j);
             }
             else
             {
@@ -23,6 +23,9 @@ public:
 
     // Execute the ETL operation
     virtual core::Result execute(const core::Request& request) = 0;
+
+    // Whether execute() honours Request::input_data and output_in_memory
+    virtual bool supports_buffers() const { return false; }
 };
 
 using PluginPtr = std::unique_ptr<IPlugin>;
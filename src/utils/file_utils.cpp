@@ -1,9 +1,23 @@
 #include "file_utils.h"
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
 #include <regex>
 #include <unordered_map>
 
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
 namespace uniconv::utils {
 
 namespace {
@@ -150,9 +164,7 @@ core::FileInfo get_file_info(const std::filesystem::path& path) {
     info.mime_type = get_mime_type(info.format);
     info.category = detect_category(info.format);
 
-    if (std::filesystem::exists(path)) {
-        info.size = std::filesystem::file_size(path);
-    }
+    info.size = regular_file_size(path);
 
     // Note: dimensions and duration would require format-specific libraries
     // (libvips for images, ffmpeg for video/audio)
@@ -264,6 +276,161 @@ std::vector<std::filesystem::path> get_files_in_directory(
     return results;
 }
 
+namespace {
+
+// Copy-on-write clone of src at dst (dst must not exist)
+bool try_reflink(const std::filesystem::path& src, const std::filesystem::path& dst) {
+#if defined(__linux__) && defined(FICLONE)
+    int in = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    int out = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+    bool ok = ::ioctl(out, FICLONE, in) == 0;
+    ::close(in);
+    ::close(out);
+    if (!ok) {
+        std::error_code ec;
+        std::filesystem::remove(dst, ec);
+    }
+    return ok;
+#elif defined(__APPLE__)
+    return ::clonefile(src.c_str(), dst.c_str(), 0) == 0;
+#else
+    (void)src;
+    (void)dst;
+    return false;
+#endif
+}
+
+// Copy src to dst inside the kernel (dst must not exist). Fails without
+// side effects where copy_file_range is unsupported, e.g. on old kernels.
+bool try_kernel_copy(const std::filesystem::path& src, const std::filesystem::path& dst) {
+#if defined(__linux__)
+    int in = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(in, &st) != 0) {
+        ::close(in);
+        return false;
+    }
+    int out = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 07777);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool ok = true;
+    off_t remaining = st.st_size;
+    while (remaining > 0) {
+        ssize_t copied = ::copy_file_range(in, nullptr, out, nullptr, static_cast<size_t>(remaining), 0);
+        if (copied < 0 && errno == EINTR) {
+            continue;
+        }
+        if (copied <= 0) {
+            ok = false;
+            break;
+        }
+        remaining -= copied;
+    }
+    ::close(in);
+    ::close(out);
+    if (!ok) {
+        std::error_code ec;
+        std::filesystem::remove(dst, ec);
+    }
+    return ok;
+#else
+    (void)src;
+    (void)dst;
+    return false;
+#endif
+}
+
+// Last tiers shared by link_or_copy_file and transfer_file
+std::optional<TransferMethod> copy_file_contents(const std::filesystem::path& src,
+                                                 const std::filesystem::path& dst) {
+    if (try_kernel_copy(src, dst)) {
+        return TransferMethod::KernelCopy;
+    }
+
+    std::error_code ec;
+    std::filesystem::copy_file(src, dst, std::filesystem::copy_options::overwrite_existing, ec);
+    if (!ec) {
+        return TransferMethod::Copy;
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+std::optional<TransferMethod> link_or_copy_file(const std::filesystem::path& src,
+                                                const std::filesystem::path& dst,
+                                                bool allow_hardlink) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(src, ec)) {
+        return std::nullopt;
+    }
+    std::filesystem::remove(dst, ec);
+
+    if (try_reflink(src, dst)) {
+        return TransferMethod::Reflink;
+    }
+
+    if (allow_hardlink) {
+        std::filesystem::create_hard_link(src, dst, ec);
+        if (!ec) {
+            return TransferMethod::Hardlink;
+        }
+    }
+
+    return copy_file_contents(src, dst);
+}
+
+std::optional<TransferMethod> transfer_file(const std::filesystem::path& src,
+                                            const std::filesystem::path& dst) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(src, ec)) {
+        return std::nullopt;
+    }
+    std::filesystem::remove(dst, ec);
+
+    std::filesystem::create_hard_link(src, dst, ec);
+    if (!ec) {
+        return TransferMethod::Hardlink;
+    }
+
+    if (try_reflink(src, dst)) {
+        return TransferMethod::Reflink;
+    }
+
+    return copy_file_contents(src, dst);
+}
+
+uintmax_t regular_file_size(const std::filesystem::path& path) {
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        return 0;
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : size;
+}
+
+bool create_fifo(const std::filesystem::path& path) {
+#ifndef _WIN32
+    return ::mkfifo(path.c_str(), 0600) == 0;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
 std::filesystem::path unique_path(const std::filesystem::path& path) {
     if (!std::filesystem::exists(path)) {
         return path;
@@ -39,6 +39,34 @@ std::vector<std::filesystem::path> get_files_in_directory(
     const std::vector<std::string>& extensions = {}
 );
 
+// How link_or_copy_file / transfer_file materialized a file
+enum class TransferMethod {
+    Reflink,    // Copy-on-write clone sharing the same data blocks
+    Hardlink,   // Second name for the same inode
+    KernelCopy, // In-kernel copy (copy_file_range), no user-space buffers
+    Copy        // Full byte copy
+};
+
+// Materialize src at dst without duplicating data when the filesystem allows:
+// reflink, then hardlink (if allow_hardlink), then an in-kernel copy, then a
+// plain copy. An existing dst is replaced. Returns nullopt if every method failed.
+std::optional<TransferMethod> link_or_copy_file(const std::filesystem::path& src,
+                                                const std::filesystem::path& dst,
+                                                bool allow_hardlink = true);
+
+// Cheapest way to give a pipeline-owned file a second name: hardlink, then
+// reflink, then an in-kernel copy, then a plain copy. Only for files nobody
+// modifies in place afterwards, since a hardlink shares the inode.
+// An existing dst is replaced. Returns nullopt if every method failed.
+std::optional<TransferMethod> transfer_file(const std::filesystem::path& src,
+                                            const std::filesystem::path& dst);
+
+// Size of a regular file; 0 for directories, pipes and missing paths
+uintmax_t regular_file_size(const std::filesystem::path& path);
+
+// Create a named pipe (FIFO) at path. Always fails on Windows.
+bool create_fifo(const std::filesystem::path& path);
+
 // Generate unique output filename if exists
 std::filesystem::path unique_path(const std::filesystem::path& path);
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace uniconv::utils {
+
+// Incremental SHA-256 (FIPS 180-4), computed in-process so hashing many
+// small files does not spawn a sha256sum per file
+class Sha256 {
+public:
+    Sha256();
+
+    // Feed more data
+    void update(const void* data, size_t size);
+    void update(std::string_view data) { update(data.data(), data.size()); }
+
+    // Finish and return the lowercase hex digest; the object must not be
+    // updated afterwards
+    std::string hex_digest();
+
+private:
+    void process_block(const uint8_t* block);
+
+    std::array<uint32_t, 8> state_;
+    std::array<uint8_t, 64> buffer_;
+    size_t buffer_size_ = 0;
+    uint64_t total_size_ = 0;
+};
+
+// SHA-256 hex digest of a string
+std::string sha256_hex(std::string_view data);
+
+// SHA-256 hex digest of a file's contents (nullopt if unreadable)
+std::optional<std::string> sha256_hex_file(const std::filesystem::path& path);
+
+} // namespace uniconv::utils
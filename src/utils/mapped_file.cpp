@@ -0,0 +1,78 @@
+#include "mapped_file.h"
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace uniconv::utils {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::filesystem::path& path) {
+    close();
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec)) {
+        return false;
+    }
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap rejects zero-length mappings; an empty file is just empty
+    if (st.st_size > 0) {
+        void* addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            ::madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t*>(addr);
+            size_ = static_cast<size_t>(st.st_size);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (mapped_ || st.st_size == 0) {
+        return true;
+    }
+#endif
+
+    // No mapping available: read the file instead
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    fallback_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    mapped_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+}
+
+} // namespace uniconv::utils
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace uniconv::utils {
+
+// Read-only view of a whole file, memory-mapped where the platform allows
+// (Windows reads the file into memory instead)
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map path; false if it is not a readable regular file
+    bool open(const std::filesystem::path& path);
+
+    // Release the mapping
+    void close();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::vector<uint8_t> fallback_;
+};
+
+} // namespace uniconv::utils
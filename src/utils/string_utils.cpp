@@ -22,6 +22,13 @@ std::string to_upper(const std::string& s) {
     return result;
 }
 
+bool iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return std::tolower(x) == std::tolower(y);
+           });
+}
+
 std::string trim(const std::string& s) {
     auto start = std::find_if_not(s.begin(), s.end(),
                                    [](unsigned char c) { return std::isspace(c); });
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 
@@ -12,6 +13,9 @@ std::string to_lower(const std::string& s);
 // Convert string to uppercase
 std::string to_upper(const std::string& s);
 
+// ASCII case-insensitive comparison, without allocating
+bool iequals(std::string_view a, std::string_view b);
+
 // Trim whitespace from both ends
 std::string trim(const std::string& s);
 
@@ -0,0 +1,35 @@
+#include "symbol_table.h"
+#include "string_utils.h"
+#include <cctype>
+
+namespace uniconv::utils {
+
+size_t SymbolTable::FoldedHash::operator()(std::string_view s) const {
+    // FNV-1a over the lower-cased bytes
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : s) {
+        hash ^= static_cast<uint64_t>(std::tolower(static_cast<unsigned char>(c)));
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool SymbolTable::FoldedEqual::operator()(std::string_view a, std::string_view b) const {
+    return iequals(a, b);
+}
+
+SymbolTable::Id SymbolTable::intern(std::string_view name) {
+    if (auto it = ids_.find(name); it != ids_.end()) {
+        return it->second;
+    }
+    auto id = static_cast<Id>(ids_.size());
+    ids_.emplace(std::string(name), id);
+    return id;
+}
+
+SymbolTable::Id SymbolTable::find(std::string_view name) const {
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : kNone;
+}
+
+} // namespace uniconv::utils
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace uniconv::utils {
+
+// Interns names (targets, formats, plugin names) as dense ids, ignoring
+// ASCII case, so they can be compared and hashed as integers. Lookups take
+// a string_view and fold case while hashing, so they never allocate; only
+// interning a new name does.
+class SymbolTable {
+public:
+    using Id = uint32_t;
+    static constexpr Id kNone = std::numeric_limits<Id>::max();
+
+    // Id of name, adding it if it is new
+    Id intern(std::string_view name);
+
+    // Id of name, or kNone if it was never interned
+    Id find(std::string_view name) const;
+
+    size_t size() const { return ids_.size(); }
+
+private:
+    struct FoldedHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const;
+    };
+    struct FoldedEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view a, std::string_view b) const;
+    };
+
+    std::unordered_map<std::string, Id, FoldedHash, FoldedEqual> ids_;
+};
+
+} // namespace uniconv::utils
@@ -0,0 +1,161 @@
+// Minimal native plugin used by test_native_plugin.cpp.
+// Uppercases text through both entry points and records how calls overlap.
+// UNICONV_TEST_THREADING (serial, safe, context) selects the declared contract.
+
+#include <uniconv/plugin_api.h>
+
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+    struct Context
+    {
+        std::atomic<bool> in_use{false};
+    };
+
+    std::atomic<int> in_flight{0};
+    std::atomic<int> max_in_flight{0};
+    std::atomic<int> contexts_created{0};
+    std::atomic<int> contexts_destroyed{0};
+    std::atomic<int> context_misuse{0};
+
+    const char *targets[] = {"upper", nullptr};
+    const char *input_formats[] = {"txt", nullptr};
+    UniconvPluginInfo plugin_info = {
+        "native-test", "native-test", "1.0.0", "Test fixture",
+        targets, input_formats, nullptr, nullptr};
+
+    bool uses_contexts()
+    {
+        const char *mode = std::getenv("UNICONV_TEST_THREADING");
+        return mode && std::strcmp(mode, "context") == 0;
+    }
+
+    // Track concurrency around the work; checks the context is exclusive
+    std::string upper(const UniconvRequest *req, std::string text)
+    {
+        auto *context = static_cast<Context *>(req->context);
+        if (uses_contexts() && (!context || context->in_use.exchange(true)))
+        {
+            ++context_misuse;
+        }
+
+        int now = ++in_flight;
+        int seen = max_in_flight.load();
+        while (now > seen && !max_in_flight.compare_exchange_weak(seen, now))
+        {
+        }
+
+        for (auto &c : text)
+        {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        --in_flight;
+        if (context)
+        {
+            context->in_use = false;
+        }
+        return text;
+    }
+
+    UniconvResult *success(const char *output, size_t size)
+    {
+        UniconvResult *r = UNICONV_RESULT_ALLOC();
+        r->status = UNICONV_SUCCESS;
+        r->output = output ? strdup(output) : nullptr;
+        r->output_size = size;
+        return r;
+    }
+
+} // namespace
+
+extern "C"
+{
+
+    UNICONV_EXPORT UniconvPluginInfo *uniconv_plugin_info(void)
+    {
+        return &plugin_info;
+    }
+
+    UNICONV_EXPORT UniconvResult *uniconv_plugin_execute(const UniconvRequest *req)
+    {
+        std::ifstream in(req->source, std::ios::binary);
+        std::string text = upper(req, std::string(std::istreambuf_iterator<char>(in),
+                                                  std::istreambuf_iterator<char>()));
+        std::ofstream(req->output, std::ios::binary) << text;
+        return success(req->output, text.size());
+    }
+
+    UNICONV_EXPORT UniconvResult *uniconv_plugin_execute_buffer(const UniconvBufferRequest *req)
+    {
+        std::string text = upper(&req->base, std::string(static_cast<const char *>(req->input.data),
+                                                         req->input.size));
+        if (req->output->write(req->output, text.data(), text.size()) != 0)
+        {
+            UNICONV_RESULT_ERROR("sink write failed");
+        }
+        return success(nullptr, text.size());
+    }
+
+    UNICONV_EXPORT void uniconv_plugin_free_result(UniconvResult *result)
+    {
+        UNICONV_DEFAULT_FREE_RESULT(result);
+    }
+
+    UNICONV_EXPORT UniconvThreading uniconv_plugin_threading(void)
+    {
+        const char *mode = std::getenv("UNICONV_TEST_THREADING");
+        if (mode && std::strcmp(mode, "safe") == 0)
+            return UNICONV_THREADING_THREAD_SAFE;
+        if (uses_contexts())
+            return UNICONV_THREADING_CONTEXT;
+        return UNICONV_THREADING_SERIAL;
+    }
+
+    UNICONV_EXPORT void *uniconv_plugin_create_context(void)
+    {
+        ++contexts_created;
+        return new Context;
+    }
+
+    UNICONV_EXPORT void uniconv_plugin_destroy_context(void *context)
+    {
+        ++contexts_destroyed;
+        delete static_cast<Context *>(context);
+    }
+
+    // Test-only introspection, looked up by the test with dlsym
+    UNICONV_EXPORT void native_test_reset(void)
+    {
+        in_flight = 0;
+        max_in_flight = 0;
+        contexts_created = 0;
+        contexts_destroyed = 0;
+        context_misuse = 0;
+    }
+
+    UNICONV_EXPORT int native_test_stat(const char *name)
+    {
+        if (std::strcmp(name, "max_in_flight") == 0)
+            return max_in_flight;
+        if (std::strcmp(name, "contexts_created") == 0)
+            return contexts_created;
+        if (std::strcmp(name, "contexts_destroyed") == 0)
+            return contexts_destroyed;
+        if (std::strcmp(name, "context_misuse") == 0)
+            return context_misuse;
+        return -1;
+    }
+
+} // extern "C"
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/batch_runner.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+namespace
+{
+
+    // Upper-cases text; fails on inputs containing "bad"
+    std::optional<std::string> upper_case(const std::string &content)
+    {
+        if (content.find("bad") != std::string::npos)
+        {
+            return std::nullopt;
+        }
+        std::string upper = content;
+        for (auto &c : upper)
+        {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return upper;
+    }
+
+} // namespace
+
+class BatchRunnerTest : public test::ScratchTest
+{
+protected:
+    std::filesystem::path input_dir;
+    test::FakePlugin *plugin = nullptr;
+
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        input_dir = temp_dir / "in";
+        std::filesystem::create_directories(input_dir / "sub");
+
+        plugin = add("upper", {.extensions = {"txt"}, .convert = upper_case});
+        plugin->delay = std::chrono::milliseconds(10);
+    }
+
+    void write_input(const std::filesystem::path &relative, const std::string &content)
+    {
+        write(std::filesystem::path("in") / relative, content);
+    }
+
+    core::PipelineBatchResult run(core::CoreOptions options, size_t workers,
+                                  std::optional<std::string> input_format = std::nullopt)
+    {
+        options.output = temp_dir / "out";
+        cli::PipelineParser parser;
+        auto parsed = parser.parse("upper", input_dir, options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+        parsed.pipeline.input_format = input_format;
+
+        core::BatchRunner runner(std::make_shared<core::Engine>(manager));
+        return runner.run(input_dir, parsed.pipeline, workers);
+    }
+};
+
+TEST_F(BatchRunnerTest, ConvertsEveryFileInParallel)
+{
+    for (int i = 0; i < 12; ++i)
+    {
+        write_input("f" + std::to_string(i) + ".txt", "file" + std::to_string(i));
+    }
+    write_input(".hidden.txt", "skip me");
+
+    auto batch = run(core::CoreOptions{}, 4);
+
+    EXPECT_TRUE(batch.success());
+    EXPECT_EQ(batch.files.size(), 12u);
+    EXPECT_EQ(batch.succeeded, 12u);
+    EXPECT_EQ(batch.output_count, 12u);
+    EXPECT_GT(plugin->peak.load(), 1);
+    EXPECT_EQ(read(temp_dir / "out" / "f3_upper.txt"), "FILE3");
+}
+
+TEST_F(BatchRunnerTest, RecursiveMirrorsLayoutAndCountsFailures)
+{
+    write_input("a.txt", "a");
+    write_input("sub/b.txt", "b");
+    write_input("sub/c.txt", "bad");
+
+    core::CoreOptions flat;
+    auto top_only = run(flat, 2);
+    EXPECT_EQ(top_only.files.size(), 1u);
+
+    core::CoreOptions options;
+    options.recursive = true;
+    options.force = true;
+    auto batch = run(options, 2);
+
+    EXPECT_FALSE(batch.success());
+    EXPECT_EQ(batch.files.size(), 3u);
+    EXPECT_EQ(batch.succeeded, 2u);
+    EXPECT_EQ(batch.failed, 1u);
+    EXPECT_EQ(read(temp_dir / "out" / "sub" / "b_upper.txt"), "B");
+
+    auto json = batch.to_json();
+    EXPECT_EQ(json["failed"], 1);
+    EXPECT_EQ(json["files"].size(), 3u);
+}
+
+TEST_F(BatchRunnerTest, InputFormatFiltersFiles)
+{
+    write_input("a.txt", "a");
+    write_input("b.md", "b");
+
+    auto batch = run(core::CoreOptions{}, 1, "md");
+    ASSERT_EQ(batch.files.size(), 1u);
+    EXPECT_EQ(batch.files[0].source.filename(), "b.md");
+}
+
+TEST_F(BatchRunnerTest, OutputsInsideSourceAreNotReconverted)
+{
+    write_input("a.txt", "a");
+    write_input("b.txt", "b");
+
+    core::CoreOptions options;
+    options.recursive = true;
+    options.output = input_dir / "converted";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("upper", input_dir, options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    core::BatchRunner runner(std::make_shared<core::Engine>(manager));
+    auto batch = runner.run(input_dir, parsed.pipeline, 1);
+    EXPECT_EQ(batch.files.size(), 2u);
+    EXPECT_TRUE(batch.success());
+}
+
+TEST_F(BatchRunnerTest, OutputsBesideSourcesAreNotReconvertedByOtherWorkers)
+{
+    // Enough files that the walk reads the directory in several batches
+    // and can meet outputs created while it runs
+    constexpr int kFiles = 2500;
+    plugin->delay = std::chrono::milliseconds(0);
+    for (int i = 0; i < kFiles; ++i)
+    {
+        write_input("f" + std::to_string(i) + ".txt", "file" + std::to_string(i));
+    }
+
+    // `uniconv --batch .`: the walked directory is the default output root
+    auto previous = std::filesystem::current_path();
+    std::filesystem::current_path(input_dir);
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("upper", ".", core::CoreOptions{});
+    core::PipelineBatchResult batch;
+    if (parsed.success)
+    {
+        core::BatchRunner runner(std::make_shared<core::Engine>(manager));
+        batch = runner.run(".", parsed.pipeline, 4);
+    }
+    std::filesystem::current_path(previous);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    EXPECT_TRUE(batch.success());
+    EXPECT_EQ(batch.files.size(), static_cast<size_t>(kFiles));
+    for (const auto &file : batch.files)
+    {
+        EXPECT_EQ(file.source.filename().string().find("_upper"), std::string::npos) << file.source;
+    }
+    EXPECT_FALSE(std::filesystem::exists(input_dir / "f0_upper_upper.txt"));
+    EXPECT_EQ(read(input_dir / "f0_upper.txt"), "FILE0");
+}
+
+TEST_F(BatchRunnerTest, RejectsCollectFirstStage)
+{
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("collect | upper", input_dir, core::CoreOptions{});
+    ASSERT_TRUE(parsed.success) << parsed.error;
+    EXPECT_TRUE(core::BatchRunner::check(parsed.pipeline).has_value());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include "utils/mapped_file.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+// ============================================================================
+// MappedFile
+// ============================================================================
+
+using MappedFileTest = test::ScratchTest;
+
+TEST_F(MappedFileTest, MapsWholeFile)
+{
+    auto path = temp_dir / "data.bin";
+    std::ofstream(path, std::ios::binary) << "mapped contents";
+
+    utils::MappedFile file;
+    ASSERT_TRUE(file.open(path));
+    ASSERT_EQ(file.size(), 15u);
+    EXPECT_EQ(std::string(reinterpret_cast<const char *>(file.data()), file.size()), "mapped contents");
+
+    file.close();
+    EXPECT_EQ(file.size(), 0u);
+}
+
+TEST_F(MappedFileTest, EmptyAndMissingFiles)
+{
+    auto empty = temp_dir / "empty.bin";
+    std::ofstream(empty).close();
+
+    utils::MappedFile file;
+    EXPECT_TRUE(file.open(empty));
+    EXPECT_EQ(file.size(), 0u);
+
+    EXPECT_FALSE(file.open(temp_dir / "missing.bin"));
+    EXPECT_FALSE(file.open(temp_dir));
+}
+
+// ============================================================================
+// In-memory intermediates between buffer-capable plugins
+// ============================================================================
+
+class BufferPipelineTest : public test::ScratchTest
+{
+protected:
+    test::FakePlugin *first = nullptr;
+    test::FakePlugin *second = nullptr;
+
+    // Appends suffix to its input, in memory if it supports buffers
+    test::FakePlugin *add_suffix(const std::string &target, const std::string &suffix, bool buffers)
+    {
+        auto append = [suffix](const std::string &content)
+        { return std::optional<std::string>(content + suffix); };
+        return add(target, {.extensions = {"txt"}, .buffers = buffers, .convert = append});
+    }
+
+    void register_plugins(bool first_buffers, bool second_buffers)
+    {
+        first = add_suffix("bufa", "-a", first_buffers);
+        second = add_suffix("bufb", "-b", second_buffers);
+    }
+
+    core::PipelineResult run()
+    {
+        auto source = write("in.txt", "x");
+
+        core::CoreOptions options;
+        options.output = temp_dir / "out.txt";
+        cli::PipelineParser parser;
+        auto parsed = parser.parse("bufa | bufb", source, options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+
+        core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+        return executor.execute(parsed.pipeline);
+    }
+
+    std::string read_output() { return read(temp_dir / "out.txt"); }
+};
+
+TEST_F(BufferPipelineTest, IntermediateStaysInMemory)
+{
+    register_plugins(true, true);
+
+    auto result = run();
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(read_output(), "x-a-b");
+    EXPECT_TRUE(first->made_memory_output);
+    EXPECT_TRUE(second->got_memory_input);
+    EXPECT_FALSE(second->source_existed);
+    EXPECT_FALSE(second->made_memory_output);
+}
+
+TEST_F(BufferPipelineTest, PathConsumerGetsTempFile)
+{
+    register_plugins(true, false);
+
+    auto result = run();
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(read_output(), "x-a-b");
+    EXPECT_FALSE(first->made_memory_output);
+    EXPECT_FALSE(second->got_memory_input);
+    EXPECT_TRUE(second->source_existed);
+}
+
+TEST_F(BufferPipelineTest, EngineWritesMemoryInputForPathPlugin)
+{
+    register_plugins(false, false);
+    core::Engine engine(manager);
+
+    core::Request request;
+    request.source = temp_dir / "virtual.txt";
+    request.target = "bufa";
+    request.input_data = std::make_shared<const core::Buffer>(core::Buffer{'m', 'e', 'm'});
+    request.output_in_memory = true;
+    request.core_options.output = temp_dir / "engine_out.txt";
+
+    auto result = engine.execute(request);
+
+    ASSERT_EQ(result.status, core::ResultStatus::Success) << result.error.value_or("");
+    EXPECT_FALSE(first->got_memory_input);
+    EXPECT_TRUE(first->source_existed);
+    EXPECT_FALSE(first->made_memory_output);
+    EXPECT_FALSE(result.output_data);
+    EXPECT_EQ(read(temp_dir / "engine_out.txt"), "mem-a");
+}
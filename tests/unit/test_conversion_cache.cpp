@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include "core/conversion_cache.h"
+#include "core/engine.h"
+#include "test_support.h"
+#include "utils/hash_utils.h"
+#include <fstream>
+#include <thread>
+
+using namespace uniconv::core;
+using namespace uniconv::utils;
+
+// ============================================================================
+// SHA-256
+// ============================================================================
+
+TEST(Sha256Test, KnownVectors)
+{
+    EXPECT_EQ(sha256_hex(""),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(sha256_hex("abc"),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(Sha256Test, IncrementalMatchesOneShot)
+{
+    std::string data(1000, 'x');
+    Sha256 hasher;
+    for (size_t i = 0; i < data.size(); i += 7)
+    {
+        hasher.update(std::string_view(data).substr(i, 7));
+    }
+    EXPECT_EQ(hasher.hex_digest(), sha256_hex(data));
+}
+
+// ============================================================================
+// ConversionCache
+// ============================================================================
+
+class ConversionCacheTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_cache";
+        std::filesystem::remove_all(temp_dir);
+        std::filesystem::create_directories(temp_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    std::filesystem::path create_temp_file(const std::string &name, const std::string &content)
+    {
+        auto path = temp_dir / name;
+        std::ofstream f(path, std::ios::binary);
+        f << content;
+        return path;
+    }
+
+    static std::string read_file(const std::filesystem::path &path)
+    {
+        std::ifstream f(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    }
+
+    static PluginInfo make_plugin(const std::string &version = "1.0.0")
+    {
+        PluginInfo info;
+        info.id = "image-convert";
+        info.scope = "image-convert";
+        info.version = version;
+        return info;
+    }
+};
+
+TEST_F(ConversionCacheTest, KeyDependsOnContentOptionsAndPluginVersion)
+{
+    ConversionCache cache(temp_dir / "cache");
+    auto input = create_temp_file("in.png", "pixels");
+
+    Request request;
+    request.source = input;
+    request.target = "jpg";
+
+    auto key = cache.make_key(request, make_plugin(), "png", temp_dir / "out.jpg");
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key, cache.make_key(request, make_plugin(), "png", temp_dir / "other.jpg"));
+
+    EXPECT_NE(key, cache.make_key(request, make_plugin("1.1.0"), "png", temp_dir / "out.jpg"));
+
+    auto with_options = request;
+    with_options.plugin_options = {"--quality", "80"};
+    EXPECT_NE(key, cache.make_key(with_options, make_plugin(), "png", temp_dir / "out.jpg"));
+
+    create_temp_file("in.png", "different pixels");
+    EXPECT_NE(key, cache.make_key(request, make_plugin(), "png", temp_dir / "out.jpg"));
+}
+
+TEST_F(ConversionCacheTest, StoreThenFetchMaterializesOutput)
+{
+    ConversionCache cache(temp_dir / "cache");
+    auto output = create_temp_file("out.jpg", "converted");
+
+    EXPECT_FALSE(cache.fetch("abcdef", temp_dir / "restored.jpg"));
+    ASSERT_TRUE(cache.store("abcdef", output));
+
+    std::filesystem::remove(output);
+    ASSERT_TRUE(cache.fetch("abcdef", temp_dir / "restored.jpg"));
+    EXPECT_EQ(read_file(temp_dir / "restored.jpg"), "converted");
+
+    auto s = cache.stats();
+    EXPECT_EQ(s.entries, 1u);
+    EXPECT_EQ(s.total_bytes, 9u);
+}
+
+TEST_F(ConversionCacheTest, ModifiedObjectIsDropped)
+{
+    ConversionCache cache(temp_dir / "cache");
+    auto output = create_temp_file("out.jpg", "converted");
+    ASSERT_TRUE(cache.store("abcdef", output));
+
+    // Edit the stored object in place (as an edit through a hardlink would)
+    {
+        std::ofstream f(temp_dir / "cache" / "objects" / "ab" / "abcdef",
+                        std::ios::binary | std::ios::app);
+        f << "tampered";
+    }
+
+    EXPECT_FALSE(cache.fetch("abcdef", temp_dir / "restored.jpg"));
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+TEST_F(ConversionCacheTest, PruneEvictsLeastRecentlyUsed)
+{
+    ConversionCache cache(temp_dir / "cache");
+    ASSERT_TRUE(cache.store("aa1111", create_temp_file("a", "0123456789")));
+    ASSERT_TRUE(cache.store("bb2222", create_temp_file("b", "0123456789")));
+
+    // Make "aa1111" the most recently used entry
+    auto now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(temp_dir / "cache" / "objects" / "bb" / "bb2222.json",
+                                     now - std::chrono::hours(1));
+    std::filesystem::last_write_time(temp_dir / "cache" / "objects" / "aa" / "aa1111.json", now);
+
+    auto result = cache.prune(10);
+    EXPECT_EQ(result.removed, 1u);
+    EXPECT_EQ(result.freed_bytes, 10u);
+    EXPECT_TRUE(cache.fetch("aa1111", temp_dir / "restored"));
+    EXPECT_FALSE(cache.fetch("bb2222", temp_dir / "restored2"));
+}
+
+TEST_F(ConversionCacheTest, StoreKeepsCacheWithinBudget)
+{
+    ConversionCache cache(temp_dir / "cache", 25);
+    ASSERT_TRUE(cache.store("aa1111", create_temp_file("a", "0123456789")));
+    ASSERT_TRUE(cache.store("bb2222", create_temp_file("b", "0123456789")));
+    ASSERT_TRUE(cache.store("cc3333", create_temp_file("c", "0123456789")));
+
+    EXPECT_LE(cache.stats().total_bytes, 25u);
+    EXPECT_FALSE(cache.store("dd4444", create_temp_file("d", std::string(30, 'x'))));
+}
+
+TEST_F(ConversionCacheTest, ClearRemovesEverything)
+{
+    ConversionCache cache(temp_dir / "cache");
+    ASSERT_TRUE(cache.store("aa1111", create_temp_file("a", "x")));
+    ASSERT_TRUE(cache.store("bb2222", create_temp_file("b", "y")));
+
+    auto result = cache.clear();
+    EXPECT_EQ(result.removed, 2u);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// ============================================================================
+// Engine: conversions consult the cache
+// ============================================================================
+
+class EngineCacheTest : public uniconv::test::ScratchTest
+{
+protected:
+    Engine engine{manager};
+    std::shared_ptr<ConversionCache> cache;
+
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        cache = std::make_shared<ConversionCache>(temp_dir / "cache");
+        engine.set_cache(cache);
+    }
+
+    Result convert(const std::filesystem::path &source, const std::string &output)
+    {
+        Request request;
+        request.source = source;
+        request.target = "upper";
+        request.core_options.cache = true;
+        request.core_options.output = temp_dir / output;
+        return engine.execute(request);
+    }
+};
+
+TEST_F(EngineCacheTest, RepeatedConversionIsServedFromCache)
+{
+    auto *plugin = add("upper", {.extensions = {"txt"}});
+    auto input = write("in.txt", "x");
+
+    auto first = convert(input, "first.txt");
+    ASSERT_EQ(first.status, ResultStatus::Success) << first.error.value_or("");
+    EXPECT_FALSE(first.extra.contains("cached"));
+
+    auto second = convert(input, "second.txt");
+    ASSERT_EQ(second.status, ResultStatus::Success) << second.error.value_or("");
+    EXPECT_EQ(second.extra.value("cached", false), true);
+    EXPECT_EQ(plugin->executions.load(), 1);
+    EXPECT_EQ(read(temp_dir / "second.txt"), "x>upper");
+    EXPECT_EQ(second.output_size, 7u);
+
+    // Other content misses
+    convert(write("other.txt", "y"), "third.txt");
+    EXPECT_EQ(plugin->executions.load(), 2);
+    EXPECT_EQ(cache->stats().entries, 2u);
+}
+
+TEST_F(EngineCacheTest, NonDeterministicPluginBypassesCache)
+{
+    auto *plugin = add("upper", {.extensions = {"txt"}, .describe = [](PluginInfo &info)
+                                 { info.deterministic = false; }});
+    auto input = write("in.txt", "x");
+
+    convert(input, "first.txt");
+    auto second = convert(input, "second.txt");
+
+    ASSERT_EQ(second.status, ResultStatus::Success) << second.error.value_or("");
+    EXPECT_FALSE(second.extra.contains("cached"));
+    EXPECT_EQ(plugin->executions.load(), 2);
+    EXPECT_EQ(cache->stats().entries, 0u);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "utils/file_utils.h"
+#include <fstream>
 
 using namespace uniconv::utils;
 using namespace uniconv::core;
@@ -69,3 +70,86 @@ TEST(FileUtilsTest, IsDirectory) {
     EXPECT_TRUE(is_directory("/tmp"));
     EXPECT_FALSE(is_directory("/nonexistent/path"));
 }
+
+TEST(FileUtilsTest, LinkOrCopyFile) {
+    auto dir = std::filesystem::temp_directory_path() / "uniconv_test_link_or_copy";
+    std::filesystem::create_directories(dir);
+    auto src = dir / "src.txt";
+    auto dst = dir / "dst.txt";
+    {
+        std::ofstream f(src);
+        f << "payload";
+    }
+    {
+        std::ofstream f(dst);
+        f << "stale";
+    }
+
+    auto method = link_or_copy_file(src, dst);
+    ASSERT_TRUE(method.has_value());
+    std::ifstream in(dst);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, "payload");
+
+    EXPECT_FALSE(link_or_copy_file(dir / "missing.txt", dir / "out.txt").has_value());
+
+    // Without hardlinks the data is cloned or copied, never shared by inode
+    auto copy = dir / "copy.txt";
+    method = link_or_copy_file(src, copy, false);
+    ASSERT_TRUE(method.has_value());
+    EXPECT_NE(*method, TransferMethod::Hardlink);
+    EXPECT_FALSE(std::filesystem::equivalent(src, copy));
+    EXPECT_EQ(std::filesystem::file_size(copy), 7u);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(FileUtilsTest, TransferFilePrefersHardlink) {
+    auto dir = std::filesystem::temp_directory_path() / "uniconv_test_transfer";
+    std::filesystem::create_directories(dir);
+    auto src = dir / "src.txt";
+    auto dst = dir / "dst.txt";
+    {
+        std::ofstream f(src);
+        f << "payload";
+    }
+    {
+        std::ofstream f(dst);
+        f << "stale";
+    }
+
+    auto method = transfer_file(src, dst);
+    ASSERT_TRUE(method.has_value());
+    EXPECT_EQ(*method, TransferMethod::Hardlink);
+    EXPECT_TRUE(std::filesystem::equivalent(src, dst));
+
+    // The source can go away: the data lives on under dst
+    std::filesystem::remove(src);
+    std::ifstream in(dst);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, "payload");
+
+    EXPECT_FALSE(transfer_file(dir / "missing.txt", dir / "out.txt").has_value());
+    EXPECT_FALSE(transfer_file(dir, dir / "out.txt").has_value());
+
+    std::filesystem::remove_all(dir);
+}
+
+#ifndef _WIN32
+TEST(FileUtilsTest, FifoHasNoRegularSize) {
+    auto dir = std::filesystem::temp_directory_path() / "uniconv_test_fifo";
+    std::filesystem::create_directories(dir);
+    auto fifo = dir / "pipe.txt";
+    std::filesystem::remove(fifo);
+
+    ASSERT_TRUE(create_fifo(fifo));
+    EXPECT_TRUE(std::filesystem::is_fifo(fifo));
+    EXPECT_EQ(regular_file_size(fifo), 0u);
+    EXPECT_EQ(get_file_info(fifo).size, 0u);
+    EXPECT_FALSE(create_fifo(fifo));
+
+    EXPECT_EQ(regular_file_size(dir / "missing.txt"), 0u);
+
+    std::filesystem::remove_all(dir);
+}
+#endif
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "core/plugin_loader_native.h"
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+// The fixture library is built alongside the tests (tests/fixtures)
+#ifdef UNICONV_TEST_NATIVE_PLUGIN
+#include <dlfcn.h>
+
+using namespace uniconv;
+
+class NativePluginTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+    void *fixture = nullptr;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_native";
+        std::filesystem::remove_all(temp_dir);
+        std::filesystem::create_directories(temp_dir);
+
+        // Second handle to the same library, for its test counters
+        fixture = dlopen(UNICONV_TEST_NATIVE_PLUGIN, RTLD_NOW | RTLD_LOCAL);
+        ASSERT_NE(fixture, nullptr) << dlerror();
+        reinterpret_cast<void (*)()>(dlsym(fixture, "native_test_reset"))();
+    }
+
+    void TearDown() override
+    {
+        unsetenv("UNICONV_TEST_THREADING");
+        if (fixture)
+            dlclose(fixture);
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    int stat(const char *name)
+    {
+        return reinterpret_cast<int (*)(const char *)>(dlsym(fixture, "native_test_stat"))(name);
+    }
+
+    std::unique_ptr<plugins::IPlugin> load(const char *threading)
+    {
+        setenv("UNICONV_TEST_THREADING", threading, 1);
+        core::PluginManifest manifest;
+        manifest.name = "native-test";
+        manifest.iface = core::PluginInterface::Native;
+        manifest.library = UNICONV_TEST_NATIVE_PLUGIN;
+        return core::NativePluginLoader::load(manifest);
+    }
+
+    core::Request request(int i)
+    {
+        auto source = temp_dir / ("in" + std::to_string(i) + ".txt");
+        std::ofstream(source) << "abc";
+
+        core::Request req;
+        req.source = source;
+        req.target = "upper";
+        req.core_options.output = temp_dir / ("out" + std::to_string(i) + ".txt");
+        return req;
+    }
+
+    // Run several conversions at once; every one must succeed
+    void run_concurrently(plugins::IPlugin &plugin, int count)
+    {
+        std::vector<std::thread> threads;
+        std::vector<core::Result> results(count);
+        for (int i = 0; i < count; ++i)
+        {
+            threads.emplace_back([&, i]
+                                 { results[i] = plugin.execute(request(i)); });
+        }
+        for (auto &t : threads)
+            t.join();
+        for (const auto &result : results)
+            EXPECT_EQ(result.status, core::ResultStatus::Success) << result.error.value_or("");
+    }
+};
+
+TEST_F(NativePluginTest, BufferEntryPointWritesFileAndMemory)
+{
+    auto plugin = load("serial");
+    ASSERT_TRUE(plugin);
+    EXPECT_TRUE(plugin->supports_buffers());
+
+    auto to_file = plugin->execute(request(0));
+    ASSERT_EQ(to_file.status, core::ResultStatus::Success) << to_file.error.value_or("");
+    std::ifstream in(temp_dir / "out0.txt");
+    EXPECT_EQ(std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()), "ABC");
+
+    auto req = request(1);
+    req.output_in_memory = true;
+    auto to_memory = plugin->execute(req);
+    ASSERT_EQ(to_memory.status, core::ResultStatus::Success) << to_memory.error.value_or("");
+    ASSERT_TRUE(to_memory.output_data);
+    EXPECT_EQ(std::string(to_memory.output_data->begin(), to_memory.output_data->end()), "ABC");
+    EXPECT_FALSE(std::filesystem::exists(temp_dir / "out1.txt"));
+}
+
+TEST_F(NativePluginTest, SerialPluginRunsOneCallAtATime)
+{
+    auto plugin = load("serial");
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(static_cast<core::NativePlugin &>(*plugin).threading(), core::NativeThreading::Serial);
+
+    run_concurrently(*plugin, 4);
+
+    EXPECT_EQ(stat("max_in_flight"), 1);
+}
+
+TEST_F(NativePluginTest, ThreadSafePluginRunsConcurrently)
+{
+    auto plugin = load("safe");
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(static_cast<core::NativePlugin &>(*plugin).threading(), core::NativeThreading::ThreadSafe);
+
+    run_concurrently(*plugin, 4);
+
+    EXPECT_GT(stat("max_in_flight"), 1);
+    EXPECT_EQ(stat("contexts_created"), 0);
+}
+
+TEST_F(NativePluginTest, ContextPluginGetsExclusiveContexts)
+{
+    auto plugin = load("context");
+    ASSERT_TRUE(plugin);
+    EXPECT_EQ(static_cast<core::NativePlugin &>(*plugin).threading(), core::NativeThreading::Context);
+
+    run_concurrently(*plugin, 4);
+    run_concurrently(*plugin, 4);
+
+    EXPECT_GT(stat("max_in_flight"), 1);
+    EXPECT_EQ(stat("context_misuse"), 0);
+    EXPECT_GE(stat("contexts_created"), 2);
+    EXPECT_LE(stat("contexts_created"), 4);
+    EXPECT_EQ(stat("contexts_destroyed"), 0);
+
+    int created = stat("contexts_created");
+    plugin.reset();
+    EXPECT_EQ(stat("contexts_destroyed"), created);
+}
+
+#endif
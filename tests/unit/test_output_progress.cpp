@@ -1,8 +1,13 @@
 #include <gtest/gtest.h>
 #include <sstream>
 #include <nlohmann/json.hpp>
+#include "cli/pipeline_parser.h"
 #include "core/output/console_output.h"
 #include "core/output/json_output.h"
+#include "core/pipeline_executor.h"
+#include <filesystem>
+#include <fstream>
+#include <functional>
 
 using namespace uniconv::core::output;
 
@@ -116,3 +121,204 @@ TEST(JsonOutputProgress, QuietModeSuppressesProgress) {
 
     EXPECT_TRUE(err.str().empty());
 }
+
+// JsonOutput streaming (--json-stream)
+
+namespace {
+
+std::vector<nlohmann::json> parse_lines(const std::string& text) {
+    std::vector<nlohmann::json> events;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        events.push_back(nlohmann::json::parse(line));
+    }
+    return events;
+}
+
+// Splits its input into three parts next to its requested output
+class PartsPlugin : public uniconv::plugins::IPlugin {
+public:
+    uniconv::core::PluginInfo info() const override {
+        uniconv::core::PluginInfo info;
+        info.name = "parts-plugin";
+        info.id = info.name;
+        info.scope = info.name;
+        info.targets["parts"] = {"txt"};
+        return info;
+    }
+
+    bool supports_target(const std::string& target) const override { return target == "parts"; }
+    bool supports_input(const std::string&) const override { return true; }
+
+    uniconv::core::Result execute(const uniconv::core::Request& request) override {
+        auto base = *request.core_options.output;
+        auto result = uniconv::core::Result::success(request.target, info().scope, request.source, base, 0, 0);
+        for (int i = 0; i < 3; ++i) {
+            auto part = base.parent_path() / (base.stem().string() + "_" + std::to_string(i) + ".txt");
+            std::ofstream(part) << i;
+            result.outputs.push_back(part);
+        }
+        return result;
+    }
+};
+
+// Copies each input; fails on the one holding "1". Calls on_item first.
+class MarkPlugin : public uniconv::plugins::IPlugin {
+public:
+    std::function<void()> on_item;
+    bool fail_on_one = false;
+
+    uniconv::core::PluginInfo info() const override {
+        uniconv::core::PluginInfo info;
+        info.name = "mark-plugin";
+        info.id = info.name;
+        info.scope = info.name;
+        info.targets["mark"] = {"txt"};
+        return info;
+    }
+
+    bool supports_target(const std::string& target) const override { return target == "mark"; }
+    bool supports_input(const std::string&) const override { return true; }
+
+    uniconv::core::Result execute(const uniconv::core::Request& request) override {
+        if (on_item) on_item();
+        std::ifstream in(request.source);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (fail_on_one && content == "1") {
+            return uniconv::core::Result::failure(request.target, request.source, "item one");
+        }
+        std::ofstream(*request.core_options.output) << content;
+        return uniconv::core::Result::success(request.target, info().scope, request.source,
+                                              *request.core_options.output, 0, 0);
+    }
+};
+
+std::vector<size_t> streamed_item_indices(const std::string& text) {
+    std::vector<size_t> indices;
+    for (const auto& event : parse_lines(text)) {
+        if (event["event"] == "stage_result" && event.contains("item_index")) {
+            indices.push_back(event["item_index"].get<size_t>());
+        }
+    }
+    return indices;
+}
+
+} // namespace
+
+TEST(JsonOutputStream, EventsAreSingleLinesOnStdout) {
+    std::ostringstream out, err;
+    JsonOutput output(out, err, false, false, true);
+
+    EXPECT_TRUE(output.streams_results());
+    output.stage_started(1, 2, "jpg");
+    output.stage_completed(1, 2, "jpg", 10, true);
+    output.stage_result({{"target", "jpg"}, {"success", true}});
+    output.output_ready("/tmp/out.jpg");
+    output.data({{"success", true}, {"nested", {{"a", 1}}}});
+
+    EXPECT_TRUE(err.str().empty());
+    auto events = parse_lines(out.str());
+    ASSERT_EQ(events.size(), 5u);
+    EXPECT_EQ(events[0]["event"], "stage_started");
+    EXPECT_EQ(events[1]["event"], "stage_completed");
+    EXPECT_EQ(events[2]["event"], "stage_result");
+    EXPECT_EQ(events[3]["event"], "output");
+    EXPECT_EQ(events[3]["path"], "/tmp/out.jpg");
+    EXPECT_EQ(events[4]["nested"]["a"], 1);
+}
+
+TEST(JsonOutputStream, ExecutorKeepsOnlyCounters) {
+    namespace fs = std::filesystem;
+    using namespace uniconv;
+
+    auto temp_dir = fs::temp_directory_path() / "uniconv_test_json_stream";
+    fs::remove_all(temp_dir);
+    fs::create_directories(temp_dir);
+    std::ofstream(temp_dir / "in.txt") << "x";
+
+    auto manager = std::make_shared<core::PluginManager>();
+    manager->register_plugin(std::make_unique<PartsPlugin>());
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("parts", temp_dir / "in.txt", options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    std::ostringstream out, err;
+    auto output = std::make_shared<JsonOutput>(out, err, false, false, true);
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+    auto result = executor.execute(parsed.pipeline, output);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_TRUE(result.streamed);
+    EXPECT_TRUE(result.stage_results.empty());
+    EXPECT_TRUE(result.final_outputs.empty());
+    EXPECT_EQ(result.stage_count, 1u);
+    EXPECT_EQ(result.failed_stage_count, 0u);
+    EXPECT_EQ(result.output_count, 3u);
+
+    size_t outputs = 0;
+    for (const auto& event : parse_lines(out.str())) {
+        if (event["event"] == "output") {
+            EXPECT_TRUE(fs::exists(event["path"].get<std::string>()));
+            ++outputs;
+        }
+    }
+    EXPECT_EQ(outputs, 3u);
+    EXPECT_EQ(result.to_json()["event"], "done");
+
+    fs::remove_all(temp_dir);
+}
+
+TEST(JsonOutputStream, ScatteredItemsStreamAsTheyComplete) {
+    namespace fs = std::filesystem;
+    using namespace uniconv;
+
+    auto temp_dir = fs::temp_directory_path() / "uniconv_test_json_stream_items";
+    fs::remove_all(temp_dir);
+    fs::create_directories(temp_dir);
+    std::ofstream(temp_dir / "in.txt") << "x";
+
+    auto manager = std::make_shared<core::PluginManager>();
+    manager->register_plugin(std::make_unique<PartsPlugin>());
+    auto mark = std::make_unique<MarkPlugin>();
+    auto* marker = mark.get();
+    manager->register_plugin(std::move(mark));
+
+    std::ostringstream out, err;
+    std::vector<size_t> before_each; // Item results already streamed when an item starts
+    marker->on_item = [&] { before_each.push_back(streamed_item_indices(out.str()).size()); };
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("parts | mark", temp_dir / "in.txt", options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    auto output = std::make_shared<JsonOutput>(out, err, false, false, true);
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+    auto result = executor.execute(parsed.pipeline, output);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(before_each, (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(streamed_item_indices(out.str()), (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(result.output_count, 3u);
+
+    // A failing item is streamed too, and stops the items after it
+    out.str("");
+    before_each.clear();
+    marker->fail_on_one = true;
+    options.force = true;
+    parsed = parser.parse("parts | mark", temp_dir / "in.txt", options);
+    output = std::make_shared<JsonOutput>(out, err, false, false, true);
+    result = executor.execute(parsed.pipeline, output);
+
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(result.error.value_or(""), "item one");
+    EXPECT_EQ(streamed_item_indices(out.str()), (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(result.failed_stage_count, 1u);
+
+    fs::remove_all(temp_dir);
+}
@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+namespace
+{
+
+    // Holds each execution it hooks until count of them have started, for
+    // at most two seconds; met() tells whether none had to give up
+    class Rendezvous
+    {
+    public:
+        explicit Rendezvous(int count) : count_(count) {}
+
+        std::function<void(const core::Request &)> hook()
+        {
+            return [this](const core::Request &)
+            {
+                ++arrived_;
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+                while (arrived_ < count_ && std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                if (arrived_ < count_)
+                {
+                    gave_up_ = true;
+                }
+            };
+        }
+
+        bool met() const { return arrived_ >= count_ && !gave_up_; }
+
+    private:
+        int count_;
+        std::atomic<int> arrived_{0};
+        std::atomic<bool> gave_up_{false};
+    };
+
+    // Scattered items of target, as reported
+    std::vector<const core::StageResult *> items_of(const core::PipelineResult &result, const std::string &target)
+    {
+        std::vector<const core::StageResult *> items;
+        for (const auto &stage : result.stage_results)
+        {
+            if (stage.target == target)
+            {
+                items.push_back(&stage);
+            }
+        }
+        return items;
+    }
+
+    std::vector<std::string> targets_of(const core::PipelineResult &result)
+    {
+        std::vector<std::string> targets;
+        for (const auto &stage : result.stage_results)
+        {
+            targets.push_back(stage.target);
+        }
+        return targets;
+    }
+
+} // namespace
+
+class ParallelPipelineTest : public test::ScratchTest
+{
+protected:
+    core::CoreOptions options;
+
+    // Conversions finished so far, in completion order
+    std::mutex finished_mutex;
+    std::vector<std::string> finished;
+
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        std::filesystem::create_directories(temp_dir / "out");
+        options.output = temp_dir / "out";
+    }
+
+    // Appends ">target" and records when it finished; fails inputs
+    // starting with fail_on
+    test::FakePlugin *add_stage(const std::string &target, std::chrono::milliseconds delay = {},
+                                std::optional<char> fail_on = std::nullopt)
+    {
+        auto convert = [this, target, fail_on](const std::string &content) -> std::optional<std::string>
+        {
+            if (fail_on && !content.empty() && content.front() == *fail_on)
+            {
+                return std::nullopt;
+            }
+            std::lock_guard<std::mutex> lock(finished_mutex);
+            finished.push_back(target);
+            return content + ">" + target;
+        };
+        auto *plugin = add(target, {.extensions = {"txt"}, .convert = convert});
+        plugin->delay = delay;
+        return plugin;
+    }
+
+    core::PipelineResult run(const std::string &pipeline)
+    {
+        cli::PipelineParser parser;
+        auto parsed = parser.parse(pipeline, write("in.txt", "x"), options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+
+        core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+        return executor.execute(parsed.pipeline);
+    }
+};
+
+// ============================================================================
+// Graph nodes scheduled on --jobs workers
+// ============================================================================
+
+TEST_F(ParallelPipelineTest, TeeBranchesRunConcurrently)
+{
+    add_stage("stepa");
+    Rendezvous branches(2);
+    add_stage("left")->on_execute = branches.hook();
+    add_stage("right")->on_execute = branches.hook();
+
+    options.jobs = 2;
+    auto result = run("stepa | tee | left, right");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_TRUE(branches.met());
+}
+
+TEST_F(ParallelPipelineTest, ResultsKeepTopologicalOrder)
+{
+    add_stage("stepa");
+    add_stage("slow", std::chrono::milliseconds(200));
+    add_stage("fast");
+
+    options.jobs = 2;
+    auto result = run("stepa | tee | slow, fast");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    // The fast branch finished first, yet is reported after the slow one
+    ASSERT_EQ(finished, (std::vector<std::string>{"stepa", "fast", "slow"}));
+    EXPECT_EQ(targets_of(result), (std::vector<std::string>{"stepa", "tee", "slow", "fast"}));
+    ASSERT_EQ(result.final_outputs.size(), 2u);
+    EXPECT_EQ(read(result.final_outputs[0]), "x>stepa>slow");
+    EXPECT_EQ(read(result.final_outputs[1]), "x>stepa>fast");
+}
+
+TEST_F(ParallelPipelineTest, FailingBranchStopsScheduling)
+{
+    add_stage("stepa");
+    add("bad", {.extensions = {"txt"}, .convert = [](const std::string &)
+                { return std::optional<std::string>(); }});
+    add_stage("slow", std::chrono::milliseconds(200));
+    auto *after_bad = add_stage("afterbad");
+    auto *after_slow = add_stage("afterslow");
+
+    options.jobs = 2;
+    auto result = run("stepa | tee | bad, slow | afterbad, afterslow");
+
+    EXPECT_FALSE(result.success);
+    ASSERT_TRUE(result.error.has_value());
+    EXPECT_NE(result.error->find("rejected input"), std::string::npos) << *result.error;
+    // slow was already running and finishes, but nothing new starts
+    EXPECT_EQ(finished, (std::vector<std::string>{"stepa", "slow"}));
+    EXPECT_EQ(after_bad->peak.load(), 0);
+    EXPECT_EQ(after_slow->peak.load(), 0);
+}
+
+// ============================================================================
+// --pipelined: scattered items flow through the chain one by one
+// ============================================================================
+
+TEST_F(ParallelPipelineTest, PipelinedItemsRunDepthFirst)
+{
+    add("split", {.extensions = {"txt"}, .parts = 3});
+    add_stage("stepb");
+    add_stage("stepc");
+
+    options.pipelined = true;
+    options.scatter_jobs = 1;
+    auto result = run("split | stepb | stepc");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(finished, (std::vector<std::string>{"stepb", "stepc", "stepb", "stepc", "stepb", "stepc"}));
+    // Reported stage by stage, in item order
+    EXPECT_EQ(targets_of(result), (std::vector<std::string>{"split", "stepb", "stepb", "stepb",
+                                                            "stepc", "stepc", "stepc"}));
+    EXPECT_EQ(result.final_outputs.size(), 3u);
+}
+
+TEST_F(ParallelPipelineTest, PipelinedIntermediatesGoOnceConsumed)
+{
+    add("split", {.extensions = {"txt"}, .parts = 3});
+    auto *middle = add_stage("stepb");
+    auto *last = add_stage("stepc");
+    size_t most_alive = 0;
+    last->on_execute = [&](const core::Request &)
+    {
+        auto outputs = middle->outputs();
+        auto alive = std::count_if(outputs.begin(), outputs.end(), [](const std::filesystem::path &path)
+                                   { return std::filesystem::exists(path); });
+        most_alive = std::max(most_alive, static_cast<size_t>(alive));
+    };
+
+    options.pipelined = true;
+    options.scatter_jobs = 1;
+    auto result = run("split | stepb | stepc");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_EQ(middle->outputs().size(), 3u);
+    // Only the item stepc is reading; earlier items' files were removed
+    EXPECT_EQ(most_alive, 1u);
+    for (const auto &path : middle->outputs())
+    {
+        EXPECT_FALSE(std::filesystem::exists(path)) << path;
+    }
+}
+
+TEST_F(ParallelPipelineTest, PipelinedChainStopsAtFirstFailure)
+{
+    add("split", {.extensions = {"txt"}, .parts = 3});
+    auto *middle = add_stage("stepb", {}, 'b'); // The second part is all 'b'
+    auto *last = add_stage("stepc");
+
+    options.pipelined = true;
+    options.scatter_jobs = 1;
+    auto result = run("split | stepb | stepc");
+
+    EXPECT_FALSE(result.success);
+    ASSERT_TRUE(result.error.has_value());
+    EXPECT_NE(result.error->find("rejected input"), std::string::npos) << *result.error;
+    // The third item never started
+    EXPECT_EQ(middle->executions.load(), 2);
+    EXPECT_EQ(finished, (std::vector<std::string>{"stepb", "stepc"}));
+    EXPECT_EQ(last->outputs().size(), 1u);
+
+    ASSERT_FALSE(result.stage_results.empty());
+    const auto &failure = result.stage_results.back();
+    EXPECT_EQ(failure.target, "stepb");
+    EXPECT_EQ(failure.status, core::ResultStatus::Error);
+    EXPECT_EQ(failure.item_index, std::optional<size_t>(1));
+}
+
+// ============================================================================
+// --scatter-jobs: scattered items of one stage run concurrently
+// ============================================================================
+
+TEST_F(ParallelPipelineTest, ScatteredItemsKeepIndexOrder)
+{
+    add("split", {.extensions = {"txt"}, .parts = 6});
+    // Part i is all ('a' + i); the first one takes longest
+    auto convert = [this](const std::string &content)
+    {
+        if (content.front() == 'a')
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        std::lock_guard<std::mutex> lock(finished_mutex);
+        finished.push_back(content.substr(0, 1));
+        return std::optional<std::string>(content.substr(0, 1) + ">conv");
+    };
+    auto *conv = add("conv", {.extensions = {"txt"}, .convert = convert});
+
+    options.scatter_jobs = 3;
+    auto result = run("split | conv");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_GT(conv->peak.load(), 1);
+    ASSERT_EQ(finished.size(), 6u);
+    EXPECT_NE(finished.front(), "a");
+
+    auto items = items_of(result, "conv");
+    ASSERT_EQ(items.size(), 6u);
+    ASSERT_EQ(result.final_outputs.size(), 6u);
+    for (size_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(items[i]->item_index, std::optional<size_t>(i));
+        auto expected = std::string(1, static_cast<char>('a' + i)) + ">conv";
+        EXPECT_EQ(result.final_outputs[i].filename(), "in_conv_000" + std::to_string(i) + ".txt");
+        EXPECT_EQ(read(result.final_outputs[i]), expected) << i;
+    }
+}
+
+TEST_F(ParallelPipelineTest, ScatteredItemsReportedUpToFirstFailure)
+{
+    add("split", {.extensions = {"txt"}, .parts = 6});
+    // The third part fails, after the items behind it have finished
+    auto convert = [](const std::string &content) -> std::optional<std::string>
+    {
+        if (content.front() == 'c')
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            return std::nullopt;
+        }
+        return content.substr(0, 1) + ">conv";
+    };
+    auto *conv = add("conv", {.extensions = {"txt"}, .convert = convert});
+
+    options.scatter_jobs = 3;
+    auto result = run("split | conv");
+
+    EXPECT_FALSE(result.success);
+    ASSERT_TRUE(result.error.has_value());
+    EXPECT_NE(result.error->find("rejected input"), std::string::npos) << *result.error;
+    EXPECT_GT(conv->executions.load(), 3);
+
+    auto items = items_of(result, "conv");
+    ASSERT_EQ(items.size(), 3u);
+    for (size_t i = 0; i < 3; ++i)
+    {
+        EXPECT_EQ(items[i]->item_index, std::optional<size_t>(i));
+    }
+    EXPECT_EQ(items[0]->status, core::ResultStatus::Success);
+    EXPECT_EQ(items[1]->status, core::ResultStatus::Success);
+    EXPECT_EQ(items[2]->status, core::ResultStatus::Error);
+    EXPECT_TRUE(result.final_outputs.empty());
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/config_manager.h"
+#include "core/perf_stats.h"
+#include "core/pipeline_executor.h"
+#include "core/output/console_output.h"
+#include "test_support.h"
+#include <sstream>
+#include <thread>
+
+using namespace uniconv;
+
+class PerfStatsTest : public test::ScratchTest
+{
+protected:
+    static core::PerfKey key(uintmax_t bytes, const std::string &plugin = "image-core")
+    {
+        return {plugin, "1.0.0", "jpg", "png", core::PerfStats::size_bucket(bytes)};
+    }
+};
+
+TEST_F(PerfStatsTest, SizeBucketIsLog2)
+{
+    EXPECT_EQ(core::PerfStats::size_bucket(0), 0);
+    EXPECT_EQ(core::PerfStats::size_bucket(1), 0);
+    EXPECT_EQ(core::PerfStats::size_bucket(1024), 10);
+    EXPECT_EQ(core::PerfStats::size_bucket(2047), 10);
+    EXPECT_EQ(core::PerfStats::size_bucket(2048), 11);
+}
+
+TEST_F(PerfStatsTest, SummaryPercentiles)
+{
+    core::PerfStats stats(temp_dir / "stats.json");
+    for (int64_t ms = 1; ms <= 100; ++ms)
+    {
+        stats.record(key(1000), {ms, 1000, 500, static_cast<uintmax_t>(ms) * 10});
+    }
+
+    auto summaries = stats.summaries();
+    ASSERT_EQ(summaries.size(), 1u);
+    EXPECT_EQ(summaries[0].samples, core::PerfStats::kMaxSamples);
+    // Only the newest kMaxSamples (37..100) are kept
+    EXPECT_EQ(summaries[0].p50_ms, 68);
+    EXPECT_EQ(summaries[0].p99_ms, 100);
+    EXPECT_DOUBLE_EQ(summaries[0].size_ratio, 0.5);
+    EXPECT_EQ(summaries[0].max_rss_kb, 1000u);
+}
+
+TEST_F(PerfStatsTest, SaveMergesWithOtherRuns)
+{
+    auto path = temp_dir / "stats.json";
+    core::PerfStats first(path);
+    core::PerfStats second(path);
+    first.load();
+    second.load();
+
+    first.record(key(1000), {10, 1000, 1000, 0});
+    second.record(key(1000, "other"), {20, 1000, 1000, 0});
+    ASSERT_TRUE(first.save());
+    ASSERT_TRUE(second.save());
+
+    core::PerfStats reader(path);
+    ASSERT_TRUE(reader.load());
+    EXPECT_EQ(reader.summaries().size(), 2u);
+}
+
+TEST_F(PerfStatsTest, ConcurrentSavesKeepEverySample)
+{
+    auto path = temp_dir / "stats.json";
+    constexpr int kWriters = 8;
+    constexpr int kRounds = 5;
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w)
+    {
+        writers.emplace_back([&, w]
+                             {
+            core::PerfStats stats(path);
+            for (int round = 0; round < kRounds; ++round)
+            {
+                stats.record(key(1000, "writer" + std::to_string(w)), {round, 1000, 1000, 0});
+                EXPECT_TRUE(stats.save());
+            } });
+    }
+    for (auto &writer : writers)
+        writer.join();
+
+    core::PerfStats reader(path);
+    ASSERT_TRUE(reader.load());
+    auto summaries = reader.summaries();
+    ASSERT_EQ(summaries.size(), static_cast<size_t>(kWriters));
+    for (const auto &summary : summaries)
+        EXPECT_EQ(summary.samples, static_cast<size_t>(kRounds));
+    EXPECT_TRUE(std::filesystem::exists(temp_dir / "stats.json.lock"));
+}
+
+TEST_F(PerfStatsTest, EstimateScalesFromNearestBucket)
+{
+    core::PerfStats stats(temp_dir / "stats.json");
+    stats.record(key(1000), {100, 1000, 2000, 0});
+
+    auto exact = stats.estimate("image-core", "1.0.0", "jpg", "png", 1000);
+    ASSERT_TRUE(exact.has_value());
+    EXPECT_TRUE(exact->exact);
+    EXPECT_EQ(exact->duration_ms, 100);
+    EXPECT_EQ(exact->bytes_out, 2000u);
+
+    auto scaled = stats.estimate("image-core", "1.0.0", "jpg", "png", 4000);
+    ASSERT_TRUE(scaled.has_value());
+    EXPECT_FALSE(scaled->exact);
+    EXPECT_EQ(scaled->duration_ms, 400);
+
+    EXPECT_FALSE(stats.estimate("image-core", "2.0.0", "jpg", "png", 1000).has_value());
+}
+
+TEST_F(PerfStatsTest, DisabledByConfig)
+{
+    core::ConfigManager config(temp_dir / "config");
+    config.set("stats.path", (temp_dir / "custom.json").string());
+    auto stats = core::PerfStats::from_config(config);
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->path(), temp_dir / "custom.json");
+
+    config.set("stats.enabled", "false");
+    EXPECT_EQ(core::PerfStats::from_config(config), nullptr);
+}
+
+TEST_F(PerfStatsTest, EngineRecordsAndExplainEstimates)
+{
+    // Doubles its input
+    auto twice = [](const std::string &content)
+    { return std::optional<std::string>(content + content); };
+    add("dbl", {.scope = "double-plugin", .extensions = {"dbl"}, .convert = twice});
+    auto engine = std::make_shared<core::Engine>(manager);
+    auto stats = std::make_shared<core::PerfStats>(temp_dir / "stats.json");
+    engine->set_stats(stats);
+
+    auto source = write("in.txt", std::string(100, 'x'));
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("dbl | dbl", source, options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    core::PipelineExecutor executor(engine);
+    auto before = executor.explain(parsed.pipeline);
+    EXPECT_EQ(before.stages.size(), 2u);
+    EXPECT_EQ(before.unknown_stages, 2u);
+    EXPECT_EQ(before.stages[0].plugin, "double-plugin");
+
+    auto result = executor.execute(parsed.pipeline);
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    // txt -> dbl (100 bytes) and dbl -> dbl (200 bytes) are separate series
+    EXPECT_EQ(stats->summaries().size(), 2u);
+
+    auto after = executor.explain(parsed.pipeline);
+    ASSERT_EQ(after.stages.size(), 2u);
+    EXPECT_EQ(after.unknown_stages, 0u);
+    EXPECT_EQ(after.stages[0].input_format, "txt");
+    EXPECT_EQ(after.stages[0].output_size, 200u);
+    EXPECT_EQ(after.stages[1].input_format, "dbl");
+    EXPECT_EQ(after.stages[1].input_size, 200u);
+    EXPECT_EQ(after.stages[1].output_size, 400u);
+}
+
+TEST(ConsoleOutputEta, NonTtyShowsEstimate)
+{
+    std::ostringstream out, err;
+    core::output::ConsoleOutput output(out, err);
+    output.stage_started_with_estimate(1, 2, "jpg", 12000);
+    EXPECT_NE(err.str().find("(est. 12s)"), std::string::npos) << err.str();
+
+    err.str("");
+    output.stage_started_with_estimate(1, 2, "jpg", 200); // Sub-second estimates are not worth showing
+    EXPECT_EQ(err.str().find("est."), std::string::npos) << err.str();
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "core/plugin_discovery.h"
+#include "core/plugin_index.h"
+#include <chrono>
+#include <fstream>
+
+using namespace uniconv;
+
+class PluginIndexTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+    std::filesystem::path plugins;
+    std::filesystem::path index_path;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_plugin_index";
+        std::filesystem::remove_all(temp_dir);
+        plugins = temp_dir / "plugins";
+        index_path = temp_dir / "plugins.idx";
+        std::filesystem::create_directories(plugins);
+
+        write_manifest(plugins, "img", "resize", {"PNG", "jpg"});
+        write_manifest(plugins, "img", "blur", {"png"});
+        write_manifest(plugins, "doc", "pdfgen", {"pdf"});
+        age(std::chrono::hours(2));
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    static void write_manifest(const std::filesystem::path &root, const std::string &scope,
+                               const std::string &name, const std::vector<std::string> &targets,
+                               const std::string &description = "")
+    {
+        auto dir = root / scope / name;
+        std::filesystem::create_directories(dir);
+        nlohmann::json j;
+        j["name"] = name;
+        j["scope"] = scope;
+        j["targets"] = targets;
+        j["executable"] = name;
+        j["description"] = description;
+        std::ofstream(dir / core::PluginDiscovery::kManifestFilename) << j.dump();
+    }
+
+    // Backdate what was just written: the index does not trust timestamps
+    // of the last moments, and a change must still move them
+    void age(std::chrono::seconds by)
+    {
+        auto now = std::filesystem::file_time_type::clock::now();
+        auto backdate = [&](const std::filesystem::path &path)
+        {
+            if (now - std::filesystem::last_write_time(path) < std::chrono::minutes(1))
+            {
+                std::filesystem::last_write_time(path, now - by);
+            }
+        };
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(temp_dir))
+        {
+            backdate(entry.path());
+        }
+        backdate(temp_dir);
+    }
+
+    size_t refresh(core::PluginIndex &index, std::vector<std::filesystem::path> dirs = {})
+    {
+        if (dirs.empty())
+        {
+            dirs = {plugins};
+        }
+        core::PluginDiscovery discovery(dirs);
+        index.refresh(dirs, [&](const std::filesystem::path &path)
+                      { return discovery.load_manifest_file(path); });
+        return index.parsed();
+    }
+
+    static std::vector<std::string> names(const std::vector<core::PluginManifest> &manifests)
+    {
+        std::vector<std::string> result;
+        for (const auto &m : manifests)
+        {
+            result.push_back(m.name);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(PluginIndexTest, SecondRunParsesNothing)
+{
+    core::PluginIndex first(index_path);
+    EXPECT_EQ(refresh(first), 3u);
+    EXPECT_TRUE(first.written());
+    EXPECT_EQ(first.size(), 3u);
+
+    core::PluginIndex second(index_path);
+    EXPECT_EQ(refresh(second), 0u);
+    EXPECT_FALSE(second.written());
+    EXPECT_EQ(names(second.manifests()), (std::vector<std::string>{"blur", "pdfgen", "resize"}));
+
+    auto manifests = second.find("pdf");
+    ASSERT_EQ(manifests.size(), 1u);
+    EXPECT_EQ(manifests[0].plugin_dir, plugins / "doc" / "pdfgen");
+    EXPECT_EQ(manifests[0].manifest_path, plugins / "doc" / "pdfgen" / "plugin.json");
+    EXPECT_EQ(manifests[0].executable, "pdfgen");
+}
+
+TEST_F(PluginIndexTest, FindsByTargetAndName)
+{
+    core::PluginIndex index(index_path);
+    refresh(index);
+
+    EXPECT_EQ(names(index.find("png")), (std::vector<std::string>{"blur", "resize"}));
+    EXPECT_EQ(names(index.find("JPG")), (std::vector<std::string>{"resize"}));
+    EXPECT_TRUE(index.find("webp").empty());
+    EXPECT_EQ(names(index.find("webp", "doc/pdfgen")), (std::vector<std::string>{"pdfgen"}));
+    EXPECT_EQ(names(index.find("webp", "blur")), (std::vector<std::string>{"blur"}));
+}
+
+TEST_F(PluginIndexTest, OnlyChangedManifestsAreParsed)
+{
+    {
+        core::PluginIndex index(index_path);
+        refresh(index);
+    }
+
+    write_manifest(plugins, "img", "blur", {"png", "webp"}, "now with webp");
+    write_manifest(plugins, "audio", "mp3enc", {"mp3"});
+    std::filesystem::remove_all(plugins / "doc" / "pdfgen");
+    age(std::chrono::hours(1));
+
+    core::PluginIndex index(index_path);
+    EXPECT_EQ(refresh(index), 2u);
+    EXPECT_TRUE(index.written());
+    EXPECT_EQ(names(index.manifests()), (std::vector<std::string>{"blur", "mp3enc", "resize"}));
+    EXPECT_EQ(names(index.find("webp")), (std::vector<std::string>{"blur"}));
+    EXPECT_TRUE(index.find("pdf").empty());
+}
+
+TEST_F(PluginIndexTest, EarlierDirectoryWins)
+{
+    auto system = temp_dir / "system";
+    write_manifest(system, "img", "resize", {"gif"});
+    age(std::chrono::hours(1));
+
+    core::PluginIndex index(index_path);
+    refresh(index, {plugins, system});
+    EXPECT_EQ(index.size(), 4u);
+    EXPECT_EQ(index.manifests().size(), 3u);
+    EXPECT_TRUE(index.find("gif").empty());
+}
+
+TEST_F(PluginIndexTest, DamagedFileIsRebuilt)
+{
+    std::ofstream(index_path) << "not an index";
+    age(std::chrono::hours(1));
+
+    core::PluginIndex index(index_path);
+    EXPECT_EQ(refresh(index), 3u);
+    EXPECT_TRUE(index.written());
+    EXPECT_EQ(index.manifests().size(), 3u);
+}
+
+TEST_F(PluginIndexTest, DamagedEntryIsSkippedAndReparsed)
+{
+    core::PluginDiscovery indexed({plugins});
+    indexed.set_index_path(index_path);
+    ASSERT_EQ(indexed.discover_matching("pdf", std::nullopt).size(), 1u);
+
+    // Break the stored manifest without touching the header or lengths
+    std::string image;
+    {
+        std::ifstream in(index_path, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto cbor = nlohmann::json::to_cbor(indexed.discover_matching("pdf", std::nullopt)[0].to_json());
+    auto at = image.find(std::string(cbor.begin(), cbor.end()));
+    ASSERT_NE(at, std::string::npos);
+    image[at] = '\xff';
+    std::ofstream(index_path, std::ios::binary | std::ios::trunc) << image;
+    age(std::chrono::hours(1));
+
+    core::PluginIndex index(index_path);
+    EXPECT_EQ(refresh(index), 0u);
+    EXPECT_TRUE(index.find("pdf").empty());
+    EXPECT_EQ(index.manifests().size(), 2u);
+    EXPECT_TRUE(index.damaged());
+
+    EXPECT_EQ(refresh(index), 1u);
+    EXPECT_TRUE(index.written());
+    EXPECT_FALSE(index.damaged());
+    EXPECT_EQ(index.find("pdf").size(), 1u);
+
+    // Discovery recovers within the same lookup
+    std::ofstream(index_path, std::ios::binary | std::ios::trunc) << image;
+    age(std::chrono::hours(1));
+    core::PluginDiscovery fresh({plugins});
+    fresh.set_index_path(index_path);
+    EXPECT_EQ(fresh.discover_matching("pdf", std::nullopt).size(), 1u);
+}
+
+TEST_F(PluginIndexTest, InvalidManifestIsNotParsedAgain)
+{
+    std::filesystem::create_directories(plugins / "bad" / "broken");
+    std::ofstream(plugins / "bad" / "broken" / "plugin.json") << "{ not json";
+    age(std::chrono::hours(1));
+
+    core::PluginIndex first(index_path);
+    EXPECT_EQ(refresh(first), 4u);
+    EXPECT_EQ(first.manifests().size(), 3u);
+
+    core::PluginIndex second(index_path);
+    EXPECT_EQ(refresh(second), 0u);
+}
+
+TEST_F(PluginIndexTest, DiscoveryMatchesWithAndWithoutIndex)
+{
+    core::PluginDiscovery plain({plugins});
+    core::PluginDiscovery indexed({plugins});
+    indexed.set_index_path(index_path);
+
+    EXPECT_EQ(names(plain.discover_all()), names(indexed.discover_all()));
+    EXPECT_EQ(names(plain.discover_matching("png", std::nullopt)),
+              names(indexed.discover_matching("png", std::nullopt)));
+    EXPECT_TRUE(std::filesystem::exists(index_path));
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "core/plugin_discovery.h"
+#include "core/plugin_manager.h"
+#include "test_support.h"
+#include <cstdlib>
+
+using namespace uniconv;
+
+class PluginManagerTest : public test::ScratchTest
+{
+protected:
+    std::filesystem::path plugins;
+    std::optional<std::string> home;
+
+    // The manager keeps its plugin index under $HOME, so tests build their
+    // own once HOME points into the scratch directory
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        plugins = temp_dir / "plugins";
+        std::filesystem::create_directories(plugins);
+        std::filesystem::create_directories(temp_dir / "home");
+
+        if (const char *value = std::getenv("HOME"))
+        {
+            home = value;
+        }
+        setenv("HOME", (temp_dir / "home").c_str(), 1);
+    }
+
+    void TearDown() override
+    {
+        if (home)
+        {
+            setenv("HOME", home->c_str(), 1);
+        }
+        else
+        {
+            unsetenv("HOME");
+        }
+        ScratchTest::TearDown();
+    }
+
+    void write_manifest(const std::string &scope, const std::string &name, const std::string &target)
+    {
+        auto dir = plugins / scope / name;
+        std::filesystem::create_directories(dir);
+        nlohmann::json j;
+        j["name"] = name;
+        j["scope"] = scope;
+        j["targets"] = {target};
+        j["executable"] = name;
+        std::ofstream(dir / core::PluginDiscovery::kManifestFilename) << j.dump();
+    }
+};
+
+TEST_F(PluginManagerTest, ConcurrentLookupsLoadEachPluginOnce)
+{
+    write_manifest("img", "resize", "png");
+    write_manifest("doc", "pdfgen", "pdf");
+    core::PluginManager manager;
+    manager.add_plugin_dir(plugins);
+
+    std::vector<plugins::IPlugin *> found(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        threads.emplace_back([&, i]
+                             { found[i] = manager.find_plugin(i % 2 ? "png" : "PDF"); });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        ASSERT_NE(found[i], nullptr);
+        EXPECT_EQ(found[i], found[i % 2]);
+    }
+    EXPECT_EQ(found[1]->info().name, "resize");
+    EXPECT_EQ(manager.list_plugins().size(), 2u);
+}
+
+TEST_F(PluginManagerTest, LookupsRunWhilePluginsAreRegistered)
+{
+    core::PluginManager manager;
+    manager.register_plugin(std::make_unique<test::FakePlugin>("png"));
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]
+                             {
+            while (!stop)
+            {
+                if (!manager.find_plugin("png"))
+                    ++misses;
+            } });
+    }
+    for (int i = 0; i < 50; ++i)
+    {
+        manager.register_plugin(std::make_unique<test::FakePlugin>("t" + std::to_string(i)));
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(misses.load(), 0);
+    ASSERT_NE(manager.find_plugin("t49"), nullptr);
+    EXPECT_EQ(manager.find_plugin("t49")->info().name, "t49-plugin");
+}
+
+TEST_F(PluginManagerTest, ReplacedSnapshotsAreFreed)
+{
+    core::PluginManager manager;
+    for (int i = 0; i < 50; ++i)
+    {
+        manager.register_plugin(std::make_unique<test::FakePlugin>("t" + std::to_string(i)));
+    }
+    EXPECT_EQ(manager.retained_snapshots(), 1u);
+
+    // Snapshots replaced while lookups read them go once the lookups finish
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]
+                             {
+            while (!stop)
+            {
+                manager.find_plugin("t0");
+            } });
+    }
+    for (int i = 50; i < 100; ++i)
+    {
+        manager.register_plugin(std::make_unique<test::FakePlugin>("t" + std::to_string(i)));
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_NE(manager.find_plugin("t99"), nullptr);
+    EXPECT_EQ(manager.retained_snapshots(), 1u);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "core/perf_stats.h"
+#include "core/plugin_resolver.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+class PluginResolverTest : public ::testing::Test
+{
+protected:
+    std::vector<std::unique_ptr<plugins::IPlugin>> plugins;
+    core::PluginResolver resolver;
+
+    test::FakePlugin *add(const std::string &scope, const std::string &target,
+                          std::vector<std::string> accepts = {})
+    {
+        test::FakePlugin::Options options{.scope = scope, .accepts = std::move(accepts)};
+        auto plugin = std::make_unique<test::FakePlugin>(target, std::move(options));
+        auto *raw = plugin.get();
+        plugins.push_back(std::move(plugin));
+        return raw;
+    }
+
+    core::ResolutionResult resolve(const std::string &target, const std::string &input_format = "",
+                                   std::optional<std::string> explicit_plugin = std::nullopt)
+    {
+        core::ResolutionContext context;
+        context.target = target;
+        context.input_format = input_format;
+        context.explicit_plugin = std::move(explicit_plugin);
+        resolver.index(plugins);
+        return resolver.resolve(context);
+    }
+
+    static std::string scope_of(const core::ResolutionResult &result)
+    {
+        return result.plugin ? result.plugin->info().scope : "";
+    }
+};
+
+TEST_F(PluginResolverTest, KeepsTierOrderAndIgnoresCase)
+{
+    add("jpg-pdf", "pdf", {"jpg"});
+    add("png-pdf", "pdf", {"png"});
+
+    auto by_format = resolve("PDF", "PNG");
+    EXPECT_EQ(scope_of(by_format), "png-pdf");
+    EXPECT_EQ(by_format.matched_by, "type+format");
+
+    auto by_target = resolve("pdf");
+    EXPECT_EQ(scope_of(by_target), "jpg-pdf");
+    EXPECT_EQ(by_target.matched_by, "target");
+
+    EXPECT_EQ(scope_of(resolve("pdf", "", "PNG-PDF")), "png-pdf");
+    EXPECT_EQ(resolve("pdf", "", "nosuch").matched_by, "explicit_not_found");
+    EXPECT_EQ(resolve("webp").matched_by, "none");
+}
+
+TEST_F(PluginResolverTest, OnlyCandidatesForTheTargetAreConsulted)
+{
+    auto *pdf = add("pdfgen", "pdf");
+    auto *png = add("pngenc", "png");
+
+    EXPECT_EQ(scope_of(resolve("png", "jpg")), "pngenc");
+    EXPECT_EQ(pdf->checks.load(), 0);
+    EXPECT_GT(png->checks.load(), 0);
+}
+
+TEST_F(PluginResolverTest, RepeatedContextsAreMemoized)
+{
+    auto *png = add("pngenc", "png");
+    resolve("png", "jpg");
+    int checks = png->checks;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(scope_of(resolve("PNG", "JPG")), "pngenc");
+    }
+    EXPECT_EQ(png->checks.load(), checks);
+}
+
+TEST_F(PluginResolverTest, ChangesDropMemoizedResolutions)
+{
+    EXPECT_EQ(resolve("png").matched_by, "none");
+
+    add("first", "png");
+    EXPECT_EQ(scope_of(resolve("png")), "first");
+
+    add("second", "png");
+    EXPECT_EQ(scope_of(resolve("png")), "first");
+
+    resolver.set_default("PNG", "second");
+    auto result = resolve("png");
+    EXPECT_EQ(scope_of(result), "second");
+    EXPECT_EQ(result.matched_by, "default");
+}
+
+// Auto-fastest ranks the compatible plugins by their recorded history
+class AutoFastestTest : public PluginResolverTest
+{
+protected:
+    std::shared_ptr<core::PerfStats> stats = std::make_shared<core::PerfStats>(
+        std::filesystem::temp_directory_path() / "uniconv_test_auto_fastest" / "stats.json");
+
+    void SetUp() override
+    {
+        add("pillow", "jpg", {"png"});
+        add("vips", "jpg", {"png"});
+        resolver.set_stats(stats);
+    }
+
+    void record(const std::string &plugin, int64_t duration_ms)
+    {
+        stats->record({plugin, "1.0.0", "jpg", "png", core::PerfStats::size_bucket(1000)},
+                      {duration_ms, 1000, 1000, 0});
+    }
+
+    core::ResolutionResult resolve_sized(uintmax_t size = 1000)
+    {
+        core::ResolutionContext context;
+        context.target = "jpg";
+        context.input_format = "png";
+        context.input_size = size;
+        resolver.index(plugins);
+        return resolver.resolve(context);
+    }
+};
+
+TEST_F(AutoFastestTest, OrderedPolicyIgnoresStats)
+{
+    record("pillow", 900);
+    record("vips", 100);
+
+    auto result = resolve_sized();
+    EXPECT_EQ(scope_of(result), "pillow");
+    EXPECT_EQ(result.matched_by, "type+format");
+}
+
+TEST_F(AutoFastestTest, PicksLowestExpectedDuration)
+{
+    record("pillow", 900);
+    record("vips", 100);
+    resolver.set_policy(core::ResolutionPolicy::AutoFastest);
+
+    auto result = resolve_sized();
+    EXPECT_EQ(scope_of(result), "vips");
+    EXPECT_EQ(result.matched_by, "fastest");
+    ASSERT_EQ(result.candidates.size(), 2u);
+    EXPECT_EQ(result.candidates[0].plugin, "vips");
+    EXPECT_EQ(result.candidates[1].estimated_ms, 900);
+}
+
+TEST_F(AutoFastestTest, MeasuredBeatsUnmeasuredAndTiesAreStable)
+{
+    resolver.set_policy(core::ResolutionPolicy::AutoFastest);
+
+    // No history: the ordered choice stands
+    auto result = resolve_sized();
+    EXPECT_EQ(scope_of(result), "pillow");
+    EXPECT_EQ(result.matched_by, "type+format");
+
+    record("vips", 500);
+    EXPECT_EQ(scope_of(resolve_sized()), "vips");
+
+    // Equal estimates: exact size class, then samples, then scope order
+    record("pillow", 500);
+    EXPECT_EQ(scope_of(resolve_sized()), "pillow");
+    record("vips", 500);
+    EXPECT_EQ(scope_of(resolve_sized()), "vips");
+}
+
+TEST(ResolutionPolicyTest, Names)
+{
+    EXPECT_EQ(core::resolution_policy_from_string("auto-fastest"), core::ResolutionPolicy::AutoFastest);
+    EXPECT_EQ(core::resolution_policy_from_string("Ordered"), core::ResolutionPolicy::Ordered);
+    EXPECT_FALSE(core::resolution_policy_from_string("random").has_value());
+}
+
+TEST(SymbolTableTest, InternsIgnoringCase)
+{
+    utils::SymbolTable symbols;
+    auto png = symbols.intern("png");
+    EXPECT_EQ(symbols.intern("PNG"), png);
+    EXPECT_NE(symbols.intern("jpg"), png);
+    EXPECT_EQ(symbols.find("Png"), png);
+    EXPECT_EQ(symbols.find("webp"), utils::SymbolTable::kNone);
+    EXPECT_EQ(symbols.size(), 2u);
+}
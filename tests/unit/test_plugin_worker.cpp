@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "core/plugin_worker.h"
+#include <fstream>
+#include <atomic>
+#include <set>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+
+using namespace uniconv::core;
+
+// Worker plugins are exercised with small POSIX shell scripts that answer
+// each request line with {"id": <id>, ...}
+class PluginWorkerTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_worker";
+        std::filesystem::remove_all(temp_dir);
+        std::filesystem::create_directories(temp_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    // Script body runs once per request line with $id set
+    std::string create_script(const std::string &name, const std::string &per_request)
+    {
+        auto path = temp_dir / name;
+        std::ofstream f(path);
+        f << "#!/bin/sh\n"
+          << "while IFS= read -r line; do\n"
+          << "  id=$(printf '%s' \"$line\" | sed -n 's/.*\"id\":\\([0-9]*\\).*/\\1/p')\n"
+          << per_request << "\n"
+          << "done\n";
+        f.close();
+        chmod(path.c_str(), 0755);
+        return path.string();
+    }
+
+    static PluginWorkerPool::Options options(size_t workers = 1)
+    {
+        PluginWorkerPool::Options o;
+        o.max_workers = workers;
+        return o;
+    }
+};
+
+TEST_F(PluginWorkerTest, ReusesOneProcessForManyRequests)
+{
+    // Each reply carries the worker's PID
+    auto script = create_script("echo.sh",
+                                "  printf '{\"id\":%s,\"success\":true,\"pid\":%s}\\n' \"$id\" \"$$\"");
+    PluginWorkerPool pool(script, {"--worker"}, {}, options());
+
+    std::set<int> pids;
+    for (int i = 0; i < 5; ++i)
+    {
+        auto result = pool.call({{"type", "execute"}}, std::chrono::seconds(10));
+        ASSERT_TRUE(result.ok) << result.error;
+        auto j = nlohmann::json::parse(result.response);
+        EXPECT_TRUE(j.value("success", false));
+        pids.insert(j.at("pid").get<int>());
+    }
+    EXPECT_EQ(pids.size(), 1u);
+    EXPECT_EQ(pool.live_workers(), 1u);
+}
+
+TEST_F(PluginWorkerTest, IgnoresUnrelatedStdoutLines)
+{
+    auto script = create_script("noisy.sh",
+                                "  echo 'loading model...'\n"
+                                "  printf '{\"id\":%s,\"success\":true}\\n' \"$id\"");
+    PluginWorkerPool pool(script, {}, {}, options());
+
+    auto result = pool.call({{"type", "execute"}}, std::chrono::seconds(10));
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_EQ(nlohmann::json::parse(result.response).at("id").get<int>(), 1);
+}
+
+TEST_F(PluginWorkerTest, RestartsCrashedWorker)
+{
+    // Answers one request, then dies
+    auto script = create_script("crash.sh",
+                                "  printf '{\"id\":%s,\"success\":true}\\n' \"$id\"\n"
+                                "  exit 1");
+    PluginWorkerPool pool(script, {}, {}, options());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        auto result = pool.call({{"type", "execute"}}, std::chrono::seconds(10));
+        ASSERT_TRUE(result.ok) << result.error;
+    }
+}
+
+TEST_F(PluginWorkerTest, WorkerThatNeverAnswersFails)
+{
+    auto script = create_script("silent.sh", "  exit 3");
+    PluginWorkerPool pool(script, {}, {}, options());
+
+    auto result = pool.call({{"type", "execute"}}, std::chrono::seconds(10));
+    EXPECT_FALSE(result.ok);
+    EXPECT_FALSE(result.error.empty());
+    EXPECT_EQ(pool.live_workers(), 0u);
+}
+
+TEST_F(PluginWorkerTest, TimeoutKillsWorker)
+{
+    auto script = create_script("slow.sh", "  sleep 5");
+    PluginWorkerPool pool(script, {}, {}, options());
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = pool.call({{"type", "execute"}}, std::chrono::milliseconds(200));
+    EXPECT_FALSE(result.ok);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(4));
+}
+
+TEST_F(PluginWorkerTest, IdleWorkersAreShutDown)
+{
+    auto script = create_script("idle.sh",
+                                "  printf '{\"id\":%s,\"success\":true}\\n' \"$id\"");
+    auto o = options();
+    o.idle_timeout = std::chrono::seconds(1);
+    PluginWorkerPool pool(script, {}, {}, o);
+
+    ASSERT_TRUE(pool.call({{"type", "execute"}}, std::chrono::seconds(10)).ok);
+    EXPECT_EQ(pool.live_workers(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    EXPECT_EQ(pool.live_workers(), 0u);
+
+    // A new request starts a fresh worker
+    EXPECT_TRUE(pool.call({{"type", "execute"}}, std::chrono::seconds(10)).ok);
+}
+
+TEST_F(PluginWorkerTest, RunsUpToMaxWorkersConcurrently)
+{
+    auto script = create_script("parallel.sh",
+                                "  sleep 0.3\n"
+                                "  printf '{\"id\":%s,\"success\":true}\\n' \"$id\"");
+    PluginWorkerPool pool(script, {}, {}, options(2));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    std::atomic<int> ok{0};
+    for (int i = 0; i < 4; ++i)
+    {
+        threads.emplace_back([&]()
+                             {
+            if (pool.call({{"type", "execute"}}, std::chrono::seconds(10)).ok)
+                ++ok; });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    EXPECT_EQ(ok.load(), 4);
+    EXPECT_LE(pool.live_workers(), 2u);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1150));
+}
+
+#endif
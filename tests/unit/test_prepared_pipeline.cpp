@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+class PreparedPipelineTest : public test::ScratchTest
+{
+protected:
+    core::ScratchPolicy scratch;
+
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        std::filesystem::create_directories(temp_dir / "out");
+        scratch.dir = temp_dir / "scratch";
+    }
+
+    // A plugin for target that appends ">target" to its input
+    void add_stage(const std::string &scope, const std::string &target, std::vector<std::string> accepts = {},
+                   std::function<void(core::PluginInfo &)> describe = nullptr)
+    {
+        add(target, {.scope = scope, .accepts = std::move(accepts), .describe = std::move(describe)});
+    }
+
+    core::PrepareResult prepare(core::PipelineExecutor &executor, const std::string &pipeline)
+    {
+        cli::PipelineParser parser;
+        auto parsed = parser.parse(pipeline, temp_dir, core::CoreOptions{});
+        EXPECT_TRUE(parsed.success) << parsed.error;
+        return executor.prepare(parsed.pipeline);
+    }
+};
+
+TEST_F(PreparedPipelineTest, OneExecutorRunsManyInputs)
+{
+    add_stage("marker", "mark");
+    add_stage("stamper", "stamp");
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager), scratch);
+    auto prepared = prepare(executor, "mark | stamp");
+    ASSERT_TRUE(prepared.success) << prepared.error;
+
+    for (const std::string name : {"a", "b", "c"})
+    {
+        auto source = write(name + ".txt", name);
+        auto result = executor.execute(*prepared.prepared, source, nullptr, temp_dir / "out" / (name + ".txt"));
+        ASSERT_TRUE(result.success) << result.error.value_or("");
+        EXPECT_EQ(read(temp_dir / "out" / (name + ".txt")), name + ">mark>stamp");
+        // Each run removes its scratch directory
+        EXPECT_TRUE(std::filesystem::is_empty(scratch.dir));
+    }
+}
+
+TEST_F(PreparedPipelineTest, UnknownTargetFailsFast)
+{
+    add_stage("marker", "mark");
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager), scratch);
+    auto prepared = prepare(executor, "mark | nosuch");
+    EXPECT_FALSE(prepared.success);
+    EXPECT_NE(prepared.error.find("Stage 2"), std::string::npos) << prepared.error;
+    EXPECT_FALSE(std::filesystem::exists(scratch.dir));
+}
+
+TEST_F(PreparedPipelineTest, MissingRequiredOptionFailsFast)
+{
+    add_stage("tagger", "tag", {}, [](core::PluginInfo &info)
+              {
+        core::PluginOptionDef label;
+        label.name = "--label";
+        label.required = true;
+        info.options.push_back(label); });
+
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager), scratch);
+    EXPECT_FALSE(prepare(executor, "tag").success);
+    EXPECT_TRUE(prepare(executor, "tag --label x").success);
+}
+
+TEST_F(PreparedPipelineTest, IncompatibleTypesFailFast)
+{
+    add_stage("texter", "text", {}, [](core::PluginInfo &info)
+              { info.output_types = {core::DataType::Text}; });
+    add_stage("imager", "image", {}, [](core::PluginInfo &info)
+              { info.input_types = {core::DataType::Image}; });
+
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager), scratch);
+    auto prepared = prepare(executor, "text | image");
+    EXPECT_FALSE(prepared.success);
+    EXPECT_NE(prepared.error.find("cannot read"), std::string::npos) << prepared.error;
+}
+
+TEST_F(PreparedPipelineTest, RoutesArePlannedPerInputFormat)
+{
+    add_stage("heif", "png", {"heic"});
+    add_stage("pdfgen", "pdf", {"png"});
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager), scratch);
+    auto prepared = prepare(executor, "pdf");
+    ASSERT_TRUE(prepared.success) << prepared.error;
+
+    auto routed = executor.execute(*prepared.prepared, write("a.heic", "a"), nullptr, temp_dir / "out" / "a.pdf");
+    ASSERT_TRUE(routed.success) << routed.error.value_or("");
+    EXPECT_EQ(routed.stage_results.size(), 2u);
+
+    auto direct = executor.execute(*prepared.prepared, write("b.png", "b"), nullptr, temp_dir / "out" / "b.pdf");
+    ASSERT_TRUE(direct.success) << direct.error.value_or("");
+    EXPECT_EQ(direct.stage_results.size(), 1u);
+    EXPECT_EQ(read(temp_dir / "out" / "b.pdf"), "b>pdf");
+
+    // The routed graph is reused for the next input of the same format
+    auto again = executor.execute(*prepared.prepared, write("c.heic", "c"), nullptr, temp_dir / "out" / "c.pdf");
+    ASSERT_TRUE(again.success) << again.error.value_or("");
+    EXPECT_EQ(read(temp_dir / "out" / "c.pdf"), "c>png>pdf");
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/config_manager.h"
+#include "core/pipeline_executor.h"
+#include "core/plugin_manifest.h"
+#include "core/resource_scheduler.h"
+#include "test_support.h"
+#include <future>
+
+using namespace uniconv;
+
+namespace
+{
+
+    constexpr uintmax_t kMB = 1024 * 1024;
+
+    core::ResourceClaim claim(const std::string &plugin, uintmax_t memory = 0,
+                              unsigned threads = 1, bool exclusive = false)
+    {
+        return {plugin, memory, threads, exclusive};
+    }
+
+    // Acquire c on another thread and release it straight away. The future
+    // blocks on destruction, so release what holds it back first.
+    std::future<void> acquire_async(core::ResourceScheduler &scheduler, const core::ResourceClaim &c)
+    {
+        return std::async(std::launch::async, [&scheduler, c]()
+                          { auto lease = scheduler.acquire(c); });
+    }
+
+    bool admitted(std::future<void> &waiter,
+                  std::chrono::milliseconds wait = std::chrono::milliseconds(100))
+    {
+        return waiter.wait_for(wait) == std::future_status::ready;
+    }
+
+} // namespace
+
+// ============================================================================
+// ResourceScheduler
+// ============================================================================
+
+TEST(ResourceSchedulerTest, MemoryBudgetHoldsBackSecondClaim)
+{
+    core::ResourceBudget budget;
+    budget.memory = 1000 * kMB;
+    core::ResourceScheduler scheduler(budget, 8);
+
+    auto lease = scheduler.acquire(claim("ml", 600 * kMB));
+    auto small = acquire_async(scheduler, claim("ml", 300 * kMB));
+    EXPECT_TRUE(admitted(small));
+    auto large = acquire_async(scheduler, claim("ml", 600 * kMB));
+    EXPECT_FALSE(admitted(large));
+    lease.release();
+    EXPECT_TRUE(admitted(large, std::chrono::seconds(5)));
+    EXPECT_EQ(scheduler.running(), 0u);
+}
+
+TEST(ResourceSchedulerTest, OversizedClaimRunsAlone)
+{
+    core::ResourceBudget budget;
+    budget.memory = 100 * kMB;
+    core::ResourceScheduler scheduler(budget, 8);
+
+    auto lease = scheduler.acquire(claim("video", 500 * kMB));
+    EXPECT_EQ(scheduler.running(), 1u);
+    auto other = acquire_async(scheduler, claim("video", 1 * kMB));
+    EXPECT_FALSE(admitted(other));
+    lease.release();
+    EXPECT_TRUE(admitted(other, std::chrono::seconds(5)));
+}
+
+TEST(ResourceSchedulerTest, CpuBudgetCountsThreads)
+{
+    core::ResourceBudget budget;
+    budget.cpus = 4;
+    core::ResourceScheduler scheduler(budget);
+
+    auto lease = scheduler.acquire(claim("encoder", 0, 3));
+    auto small = acquire_async(scheduler, claim("small"));
+    EXPECT_TRUE(admitted(small));
+    auto wide = acquire_async(scheduler, claim("encoder", 0, 2));
+    EXPECT_FALSE(admitted(wide));
+    lease.release();
+    EXPECT_TRUE(admitted(wide, std::chrono::seconds(5)));
+}
+
+TEST(ResourceSchedulerTest, ExclusiveClaimRunsAlone)
+{
+    core::ResourceScheduler scheduler(core::ResourceBudget{}, 8);
+
+    auto lease = scheduler.acquire(claim("a"));
+    auto gpu = acquire_async(scheduler, claim("gpu", 0, 1, true));
+    EXPECT_FALSE(admitted(gpu));
+    lease.release();
+    EXPECT_TRUE(admitted(gpu, std::chrono::seconds(5)));
+
+    lease = scheduler.acquire(claim("gpu", 0, 1, true));
+    auto other = acquire_async(scheduler, claim("a"));
+    EXPECT_FALSE(admitted(other));
+    lease.release();
+    EXPECT_TRUE(admitted(other, std::chrono::seconds(5)));
+}
+
+TEST(ResourceSchedulerTest, PluginLimitDoesNotBlockOtherPlugins)
+{
+    core::ResourceBudget budget;
+    budget.plugin_limits["ml"] = 1;
+    core::ResourceScheduler scheduler(budget, 8);
+
+    auto lease = scheduler.acquire(claim("ml"));
+    auto limited = acquire_async(scheduler, claim("ml"));
+    EXPECT_FALSE(admitted(limited, std::chrono::milliseconds(50)));
+    // Queued behind the limit, yet another plugin still gets in
+    auto other = acquire_async(scheduler, claim("other"));
+    EXPECT_TRUE(admitted(other));
+    lease.release();
+    EXPECT_TRUE(admitted(limited, std::chrono::seconds(5)));
+}
+
+TEST(ResourceSchedulerTest, BudgetFromConfig)
+{
+    auto dir = std::filesystem::temp_directory_path() / "uniconv_test_resource_config";
+    std::filesystem::remove_all(dir);
+    {
+        core::ConfigManager config(dir);
+        config.set("scheduler.memory", "2GB");
+        config.set("scheduler.cpus", "6");
+        config.set("scheduler.limit.ai-vision", "1");
+        auto budget = core::ResourceBudget::from_config(config);
+        EXPECT_EQ(budget.memory, 2048 * kMB);
+        EXPECT_EQ(budget.cpus, 6u);
+        ASSERT_EQ(budget.plugin_limits.count("ai-vision"), 1u);
+        EXPECT_EQ(budget.plugin_limits.at("ai-vision"), 1u);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(ResourceSchedulerTest, ManifestResources)
+{
+    auto manifest = core::PluginManifest::from_json(nlohmann::json::parse(R"({
+        "name": "upscale",
+        "targets": ["png"],
+        "resources": {"memory_mb": 4096, "threads": 4, "exclusive": true}
+    })"));
+    EXPECT_EQ(manifest.resources.memory_mb, 4096u);
+    EXPECT_EQ(manifest.resources.threads, 4);
+    EXPECT_TRUE(manifest.resources.exclusive);
+
+    auto info = manifest.to_plugin_info();
+    EXPECT_TRUE(info.resources.exclusive);
+    EXPECT_EQ(info.to_json()["resources"]["memory_mb"], 4096);
+    EXPECT_FALSE(core::PluginInfo{}.to_json().contains("resources"));
+}
+
+// ============================================================================
+// Scheduling pipeline work
+// ============================================================================
+
+class ScheduledPipelineTest : public test::ScratchTest
+{
+protected:
+    // Most "hungry" items running at once while six parts are scattered
+    int peak_items(core::ResourceHints hints, core::ResourceBudget budget)
+    {
+        add("parts", {.extensions = {"txt"}, .parts = 6});
+        auto *plugin = add("hungry", {.extensions = {"txt"}, .resources = hints});
+        plugin->delay = std::chrono::milliseconds(30);
+
+        core::CoreOptions options;
+        options.output = temp_dir / "out";
+        options.scatter_jobs = 6;
+        cli::PipelineParser parser;
+        auto parsed = parser.parse("parts | hungry | collect", write("in.txt", "x"), options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+
+        core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+        executor.set_scheduler(std::make_shared<core::ResourceScheduler>(budget, 6));
+        auto result = executor.execute(parsed.pipeline);
+        EXPECT_TRUE(result.success) << result.error.value_or("");
+        return plugin->peak.load();
+    }
+};
+
+TEST_F(ScheduledPipelineTest, DeclaredMemoryThrottlesScatterItems)
+{
+    core::ResourceHints hints;
+    hints.memory_mb = 400;
+    core::ResourceBudget budget;
+    budget.memory = 1000 * kMB;
+    EXPECT_EQ(peak_items(hints, budget), 2);
+}
+
+TEST_F(ScheduledPipelineTest, PluginLimitCapsScatterItems)
+{
+    core::ResourceBudget budget;
+    budget.plugin_limits["hungry-plugin"] = 1;
+    EXPECT_EQ(peak_items(core::ResourceHints{}, budget), 1);
+}
+
+TEST_F(ScheduledPipelineTest, UndeclaredPluginsUseRequestedWidth)
+{
+    EXPECT_GT(peak_items(core::ResourceHints{}, core::ResourceBudget{}), 1);
+}
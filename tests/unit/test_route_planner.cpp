@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include "core/route_planner.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+namespace
+{
+
+    core::PluginInfo make_info(const std::string &scope, const std::string &target,
+                               std::vector<std::string> accepts)
+    {
+        return test::FakePlugin(target, {.scope = scope, .accepts = std::move(accepts)}).info();
+    }
+
+} // namespace
+
+// ============================================================================
+// RoutePlanner
+// ============================================================================
+
+TEST(RoutePlannerTest, FindsTwoHopRoute)
+{
+    core::RoutePlanner planner({make_info("heif", "png", {"heic"}),
+                                make_info("pdfgen", "pdf", {"png"})});
+
+    EXPECT_FALSE(planner.has_direct("heic", "pdf"));
+    auto route = planner.plan("heic", "pdf");
+    ASSERT_TRUE(route.has_value());
+    ASSERT_EQ(route->hops.size(), 2u);
+    EXPECT_EQ(route->hops[0].target, "png");
+    EXPECT_EQ(route->hops[0].plugin, "heif/heif");
+    EXPECT_EQ(route->hops[1].target, "pdf");
+    EXPECT_EQ(route->cost_ms, 2 * core::RoutePlanner::kUnknownHopCostMs);
+}
+
+TEST(RoutePlannerTest, NoRouteWithoutPath)
+{
+    core::RoutePlanner planner({make_info("heif", "png", {"heic"}),
+                                make_info("pdfgen", "pdf", {"jpg"})});
+    EXPECT_FALSE(planner.plan("heic", "pdf").has_value());
+}
+
+TEST(RoutePlannerTest, TargetInputFormatsOverrideAccepts)
+{
+    auto info = make_info("pdfgen", "pdf", {"png"});
+    info.target_input_formats["pdf"] = {"tiff"};
+    EXPECT_FALSE(core::RoutePlanner::accepts(info, "pdf", "png"));
+    EXPECT_TRUE(core::RoutePlanner::accepts(info, "pdf", "tiff"));
+}
+
+TEST(RoutePlannerTest, HistoryPicksCheapestPath)
+{
+    std::vector<core::PluginInfo> plugins = {
+        make_info("a-png", "png", {"heic"}),
+        make_info("b-jpg", "jpg", {"heic"}),
+        make_info("pdfgen", "pdf", {"png", "jpg"})};
+
+    // Unmeasured: equal cost and length, scope order decides
+    auto route = core::RoutePlanner(plugins).plan("heic", "pdf", 1000);
+    ASSERT_TRUE(route.has_value());
+    EXPECT_EQ(route->hops[0].target, "png");
+
+    core::PerfStats stats(std::filesystem::temp_directory_path() / "uniconv_test_route_stats.json");
+    int bucket = core::PerfStats::size_bucket(1000);
+    stats.record({"a-png", "1.0.0", "png", "heic", bucket}, {5000, 1000, 1000, 0});
+    stats.record({"b-jpg", "1.0.0", "jpg", "heic", bucket}, {200, 1000, 1000, 0});
+
+    route = core::RoutePlanner(plugins, &stats).plan("heic", "pdf", 1000);
+    ASSERT_TRUE(route.has_value());
+    EXPECT_EQ(route->hops[0].target, "jpg");
+    EXPECT_EQ(route->hops[0].estimated_ms, 200);
+    EXPECT_EQ(route->cost_ms, 200 + core::RoutePlanner::kUnknownHopCostMs);
+}
+
+TEST(RoutePlannerTest, PrefersFewerHopsAtEqualCost)
+{
+    core::RoutePlanner planner({make_info("a", "png", {"heic"}),
+                                make_info("b", "bmp", {"png"}),
+                                make_info("c", "pdf", {"bmp"}),
+                                make_info("d", "tiff", {"heic"}),
+                                make_info("e", "pdf", {"tiff"})});
+    auto route = planner.plan("heic", "pdf");
+    ASSERT_TRUE(route.has_value());
+    ASSERT_EQ(route->hops.size(), 2u);
+    EXPECT_EQ(route->hops[0].target, "tiff");
+}
+
+// ============================================================================
+// Splicing into the execution graph
+// ============================================================================
+
+class RouteSpliceTest : public test::ScratchTest
+{
+protected:
+    void SetUp() override
+    {
+        ScratchTest::SetUp();
+        add("png", {.scope = "heif", .accepts = {"heic"}});
+        add("pdf", {.scope = "pdfgen", .accepts = {"png"}});
+    }
+};
+
+TEST_F(RouteSpliceTest, ExecutesImpliedIntermediateStage)
+{
+    auto source = write("photo.heic", "img");
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out.pdf";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("pdf", source, options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+    auto result = executor.execute(parsed.pipeline);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_EQ(result.stage_results.size(), 2u);
+    EXPECT_EQ(result.stage_results[0].target, "png");
+    EXPECT_EQ(result.stage_results[1].target, "pdf");
+    EXPECT_EQ(read(temp_dir / "out.pdf"), "img>png>pdf");
+}
+
+TEST_F(RouteSpliceTest, ExplainShowsRoute)
+{
+    auto source = write("photo.heic", "img");
+
+    core::CoreOptions options;
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("pdf", source, options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+    auto estimate = executor.explain(parsed.pipeline);
+    ASSERT_EQ(estimate.stages.size(), 2u);
+    EXPECT_EQ(estimate.stages[0].plugin, "heif");
+    EXPECT_EQ(estimate.stages[0].matched_by, "route");
+    EXPECT_EQ(estimate.stages[1].input_format, "png");
+}
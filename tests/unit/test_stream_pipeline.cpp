@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+
+using namespace uniconv;
+
+// Two CLI plugins declaring stream I/O, chained as "upper | shout".
+// Each script leaves a marker when its pipe end really is a FIFO.
+class StreamPipelineTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+    std::filesystem::path plugins_dir;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_stream";
+        std::filesystem::remove_all(temp_dir);
+        plugins_dir = temp_dir / "plugins";
+        std::filesystem::create_directories(plugins_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    void create_plugin(const std::string &name,
+                       const std::string &target,
+                       const nlohmann::json &types,
+                       const std::string &body)
+    {
+        auto dir = plugins_dir / "test" / name;
+        std::filesystem::create_directories(dir);
+
+        nlohmann::json manifest = {
+            {"name", name},
+            {"scope", "test"},
+            {"version", "1.0.0"},
+            {"interface", "cli"},
+            {"executable", "run.sh"},
+            {"targets", {{target, {"txt"}}}},
+            {"accepts", {"txt"}}};
+        manifest.update(types);
+        std::ofstream(dir / "plugin.json") << manifest.dump(2);
+
+        auto script = dir / "run.sh";
+        std::ofstream(script)
+            << "#!/bin/sh\n"
+            << "while [ $# -gt 0 ]; do\n"
+            << "  case \"$1\" in --input) in=\"$2\"; shift;; --output) out=\"$2\"; shift;; esac\n"
+            << "  shift\n"
+            << "done\n"
+            << body << "\n"
+            << "printf '{\"success\":true,\"output_path\":\"%s\"}\\n' \"$out\"\n";
+        chmod(script.c_str(), 0755);
+    }
+
+    core::PipelineResult run(const std::string &pipeline_str)
+    {
+        auto source = temp_dir / "in.txt";
+        std::ofstream(source) << "hello\n";
+
+        core::CoreOptions options;
+        options.output = temp_dir / "out.txt";
+        cli::PipelineParser parser;
+        auto parsed = parser.parse(pipeline_str, source, options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+
+        auto manager = std::make_shared<core::PluginManager>();
+        manager->load_plugins_from_dir(plugins_dir);
+        core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+        return executor.execute(parsed.pipeline);
+    }
+
+    std::string read(const std::filesystem::path &path)
+    {
+        std::ifstream in(path);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+};
+
+TEST_F(StreamPipelineTest, StreamingStagesAreConnectedByPipe)
+{
+    create_plugin("upper", "upper", {{"output_types", {"stream"}}},
+                  "[ -p \"$out\" ] && touch \"$(dirname \"$0\")/wrote_pipe\"\n"
+                  "tr a-z A-Z < \"$in\" > \"$out\"");
+    create_plugin("shout", "shout", {{"input_types", {"stream"}}},
+                  "[ -p \"$in\" ] && touch \"$(dirname \"$0\")/read_pipe\"\n"
+                  "sed 's/$/!/' < \"$in\" > \"$out\"");
+
+    auto result = run("upper | shout");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(read(temp_dir / "out.txt"), "HELLO!\n");
+    EXPECT_TRUE(std::filesystem::exists(plugins_dir / "test" / "upper" / "wrote_pipe"));
+    EXPECT_TRUE(std::filesystem::exists(plugins_dir / "test" / "shout" / "read_pipe"));
+    EXPECT_EQ(result.stage_results.size(), 2u);
+}
+
+TEST_F(StreamPipelineTest, NonStreamingConsumerUsesTempFile)
+{
+    create_plugin("upper", "upper", {{"output_types", {"stream"}}},
+                  "[ -p \"$out\" ] && touch \"$(dirname \"$0\")/wrote_pipe\"\n"
+                  "tr a-z A-Z < \"$in\" > \"$out\"");
+    create_plugin("shout", "shout", nlohmann::json::object(),
+                  "sed 's/$/!/' < \"$in\" > \"$out\"");
+
+    auto result = run("upper | shout");
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(read(temp_dir / "out.txt"), "HELLO!\n");
+    EXPECT_FALSE(std::filesystem::exists(plugins_dir / "test" / "upper" / "wrote_pipe"));
+}
+
+TEST_F(StreamPipelineTest, ProducerFailingBeforeOpeningPipeDoesNotHang)
+{
+    create_plugin("upper", "upper", {{"output_types", {"stream"}}},
+                  "echo 'boom' >&2\n"
+                  "exit 1");
+    create_plugin("shout", "shout", {{"input_types", {"stream"}}},
+                  "sed 's/$/!/' < \"$in\" > \"$out\"");
+
+    auto result = run("upper | shout");
+
+    EXPECT_FALSE(result.success);
+    ASSERT_TRUE(result.error.has_value());
+    EXPECT_NE(result.error->find("boom"), std::string::npos) << *result.error;
+}
+
+#endif
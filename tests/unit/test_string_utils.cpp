@@ -17,6 +17,13 @@ TEST(StringUtilsTest, ToUpper) {
     EXPECT_EQ(to_upper(""), "");
 }
 
+TEST(StringUtilsTest, IEquals) {
+    EXPECT_TRUE(iequals("PNG", "png"));
+    EXPECT_TRUE(iequals("", ""));
+    EXPECT_FALSE(iequals("png", "pn"));
+    EXPECT_FALSE(iequals("png", "jpg"));
+}
+
 TEST(StringUtilsTest, Trim) {
     EXPECT_EQ(trim("  hello  "), "hello");
     EXPECT_EQ(trim("hello"), "hello");
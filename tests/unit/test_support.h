@@ -0,0 +1,235 @@
+#pragma once
+
+// Shared test doubles: a configurable in-process plugin and a fixture
+// giving each test suite its own scratch directory and plugin manager
+
+#include <gtest/gtest.h>
+#include "core/plugin_manager.h"
+#include "plugins/plugin_interface.h"
+#include "utils/string_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace uniconv::test
+{
+
+    inline std::string read_file(const std::filesystem::path &path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+    // In-process plugin for one target. By default it appends ">target" to
+    // its input; the options change what it accepts, produces and reports.
+    class FakePlugin : public plugins::IPlugin
+    {
+    public:
+        // Content of the output, or nullopt to fail the request
+        using Convert = std::function<std::optional<std::string>(const std::string &content)>;
+
+        struct Options
+        {
+            std::string scope;                   // Default "<target>-plugin"
+            std::vector<std::string> accepts;    // Input formats; empty accepts any
+            std::vector<std::string> extensions; // Output extensions of the target
+            core::ResourceHints resources;
+            bool buffers = false;             // Takes and produces in-memory data
+            size_t parts = 0;                 // Writes this many 1000-byte parts instead
+            Convert convert;
+            std::function<void(core::PluginInfo &)> describe; // Adjusts the advertised info
+        };
+
+        explicit FakePlugin(const std::string &target) : FakePlugin(target, Options{}) {}
+
+        FakePlugin(const std::string &target, Options options)
+            : target_(target), options_(std::move(options))
+        {
+            if (options_.scope.empty())
+            {
+                options_.scope = target + "-plugin";
+            }
+            info_.name = options_.scope;
+            info_.id = options_.scope;
+            info_.scope = options_.scope;
+            info_.version = "1.0.0";
+            info_.targets[target] = options_.extensions;
+            if (!options_.accepts.empty())
+            {
+                info_.accepts = options_.accepts;
+            }
+            info_.resources = options_.resources;
+            if (options_.describe)
+            {
+                options_.describe(info_);
+            }
+        }
+
+        core::PluginInfo info() const override { return info_; }
+
+        bool supports_target(const std::string &target) const override
+        {
+            ++checks;
+            return target == target_;
+        }
+
+        bool supports_input(const std::string &format) const override
+        {
+            ++checks;
+            return !info_.accepts ||
+                   std::any_of(info_.accepts->begin(), info_.accepts->end(),
+                               [&](const std::string &f)
+                               { return utils::iequals(f, format); });
+        }
+
+        bool supports_buffers() const override { return options_.buffers; }
+
+        core::Result execute(const core::Request &request) override
+        {
+            ++executions;
+            int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now))
+            {
+            }
+            if (on_execute)
+            {
+                on_execute(request);
+            }
+            std::this_thread::sleep_for(delay);
+
+            got_memory_input = request.input_data != nullptr;
+            source_existed = std::filesystem::exists(request.source);
+            std::string content = request.input_data
+                                      ? std::string(request.input_data->begin(), request.input_data->end())
+                                      : read_file(request.source);
+            auto result = options_.parts > 0 ? write_parts(request) : convert(request, content);
+
+            --running;
+            return result;
+        }
+
+        // Set before running: time each execution takes, and a hook called
+        // at its start
+        std::chrono::milliseconds delay{0};
+        std::function<void(const core::Request &)> on_execute;
+
+        // What the plugin observed
+        mutable std::atomic<int> checks{0}; // supports_* calls
+        std::atomic<int> executions{0};
+        std::atomic<int> running{0};
+        std::atomic<int> peak{0}; // Most executions at once
+        std::atomic<bool> got_memory_input{false};
+        std::atomic<bool> source_existed{false};
+        std::atomic<bool> made_memory_output{false};
+
+        // Files written, in order
+        std::vector<std::filesystem::path> outputs() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return outputs_;
+        }
+
+    private:
+        core::Result convert(const core::Request &request, const std::string &content)
+        {
+            auto converted = options_.convert ? options_.convert(content)
+                                              : std::optional<std::string>(content + ">" + target_);
+            if (!converted)
+            {
+                return core::Result::failure(request.target, request.source, "rejected input");
+            }
+
+            auto output = *request.core_options.output;
+            auto result = core::Result::success(request.target, info_.scope, request.source,
+                                                output, content.size(), converted->size());
+            if (request.output_in_memory)
+            {
+                made_memory_output = true;
+                result.output_data = std::make_shared<const core::Buffer>(converted->begin(), converted->end());
+                return result;
+            }
+            std::ofstream(output, std::ios::binary) << *converted;
+            record(output);
+            return result;
+        }
+
+        core::Result write_parts(const core::Request &request)
+        {
+            auto base = *request.core_options.output;
+            auto result = core::Result::success(request.target, info_.scope, request.source, base, 0, 0);
+            for (size_t i = 0; i < options_.parts; ++i)
+            {
+                auto part = base.parent_path() / (base.stem().string() + "_" + std::to_string(i) + ".txt");
+                std::ofstream(part, std::ios::binary) << std::string(1000, static_cast<char>('a' + i % 26));
+                result.outputs.push_back(part);
+                record(part);
+            }
+            return result;
+        }
+
+        void record(const std::filesystem::path &path)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outputs_.push_back(path);
+        }
+
+        std::string target_;
+        Options options_;
+        core::PluginInfo info_;
+        mutable std::mutex mutex_;
+        std::vector<std::filesystem::path> outputs_;
+    };
+
+    // A scratch directory per test suite, removed after each test, and a
+    // plugin manager to register fakes with
+    class ScratchTest : public ::testing::Test
+    {
+    protected:
+        std::filesystem::path temp_dir;
+        std::shared_ptr<core::PluginManager> manager = std::make_shared<core::PluginManager>();
+
+        void SetUp() override
+        {
+            const auto *test = ::testing::UnitTest::GetInstance()->current_test_info();
+            temp_dir = std::filesystem::temp_directory_path() /
+                       (std::string("uniconv_test_") + test->test_suite_name());
+            std::filesystem::remove_all(temp_dir);
+            std::filesystem::create_directories(temp_dir);
+        }
+
+        void TearDown() override
+        {
+            std::filesystem::remove_all(temp_dir);
+        }
+
+        // Register a fake plugin; it stays owned by the manager
+        FakePlugin *add(const std::string &target, FakePlugin::Options options = {})
+        {
+            auto plugin = std::make_unique<FakePlugin>(target, std::move(options));
+            auto *raw = plugin.get();
+            manager->register_plugin(std::move(plugin));
+            return raw;
+        }
+
+        // Write a file under temp_dir, creating its directories
+        std::filesystem::path write(const std::filesystem::path &relative, const std::string &content)
+        {
+            auto path = temp_dir / relative;
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream(path, std::ios::binary) << content;
+            return path;
+        }
+
+        static std::string read(const std::filesystem::path &path) { return read_file(path); }
+    };
+
+} // namespace uniconv::test
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/config_manager.h"
+#include "core/pipeline_executor.h"
+#include "test_support.h"
+
+using namespace uniconv;
+
+class TempCleanupTest : public test::ScratchTest
+{
+protected:
+    bool upstream_output_alive = true;
+
+    // Appends "-target" to its input
+    test::FakePlugin *add_step(const std::string &target)
+    {
+        auto append = [target](const std::string &content)
+        { return std::optional<std::string>(content + "-" + target); };
+        return add(target, {.extensions = {"txt"}, .convert = append});
+    }
+
+    // Record whether upstream's latest output still exists when plugin runs
+    void watch_upstream(test::FakePlugin *plugin, const test::FakePlugin *upstream)
+    {
+        plugin->on_execute = [this, upstream](const core::Request &)
+        {
+            auto outputs = upstream->outputs();
+            if (!outputs.empty())
+            {
+                upstream_output_alive = std::filesystem::exists(outputs.back());
+            }
+        };
+    }
+
+    // Writes parts of 1000 bytes each
+    test::FakePlugin *add_split(size_t parts)
+    {
+        return add("split", {.extensions = {"txt"}, .parts = parts});
+    }
+
+    // Slow per-item conversion
+    test::FakePlugin *add_slow()
+    {
+        auto *plugin = add("slow", {.extensions = {"txt"}});
+        plugin->delay = std::chrono::milliseconds(30);
+        return plugin;
+    }
+
+    core::PipelineResult run(const std::string &pipeline_str, core::CoreOptions options,
+                             const core::ScratchPolicy &scratch = core::ScratchPolicy::defaults(),
+                             const std::string &input = "x",
+                             std::shared_ptr<core::PerfStats> stats = nullptr)
+    {
+        auto source = write("in.txt", input);
+
+        cli::PipelineParser parser;
+        auto parsed = parser.parse(pipeline_str, source, options);
+        EXPECT_TRUE(parsed.success) << parsed.error;
+
+        auto engine = std::make_shared<core::Engine>(manager);
+        if (stats)
+            engine->set_stats(stats);
+        core::PipelineExecutor executor(engine, scratch);
+        return executor.execute(parsed.pipeline);
+    }
+
+    static bool is_under(const std::filesystem::path &path, const std::filesystem::path &dir)
+    {
+        auto rel = path.lexically_relative(dir);
+        return !rel.empty() && *rel.begin() != "..";
+    }
+};
+
+TEST_F(TempCleanupTest, IntermediateDeletedAfterLastReader)
+{
+    auto *first = add_step("stepa");
+    add_step("stepb");
+    auto *third = add_step("stepc");
+    watch_upstream(third, first);
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out.txt";
+    auto result = run("stepa | stepb | stepc", options);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(read(temp_dir / "out.txt"), "x-stepa-stepb-stepc");
+    // stepb was the only reader of stepa's output
+    EXPECT_FALSE(upstream_output_alive);
+}
+
+TEST_F(TempCleanupTest, TeeKeepsIntermediateUntilEveryBranchRan)
+{
+    auto *first = add_step("stepa");
+    add_step("stepb");
+    auto *third = add_step("stepc");
+    watch_upstream(third, first);
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    auto result = run("stepa | tee | stepb, stepc", options);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_TRUE(upstream_output_alive);
+}
+
+TEST_F(TempCleanupTest, ScatteredInputsConsumedAsItemsFinish)
+{
+    auto *split = add_split(4);
+    add_slow();
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    options.scatter_jobs = 1;
+    auto result = run("split | slow | collect", options);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_EQ(split->outputs().size(), 4u);
+    for (const auto &part : split->outputs())
+    {
+        EXPECT_FALSE(std::filesystem::exists(part)) << part;
+    }
+}
+
+TEST_F(TempCleanupTest, TempBudgetThrottlesScatterConcurrency)
+{
+    add_split(6);
+    auto *slow = add_slow();
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out";
+    options.scatter_jobs = 4;
+    options.temp_budget = 2500; // The split parts alone take 6000 bytes
+    auto result = run("split | slow | collect", options);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    EXPECT_EQ(slow->peak.load(), 1);
+    EXPECT_EQ(result.stage_results.size(), 1u + 6u + 1u);
+}
+
+// ============================================================================
+// Scratch placement
+// ============================================================================
+
+TEST_F(TempCleanupTest, SmallIntermediateUsesRamScratch)
+{
+    auto *first = add_step("stepa");
+    add_step("stepb");
+
+    core::ScratchPolicy scratch;
+    scratch.dir = temp_dir / "disk";
+    scratch.ram_dir = temp_dir / "ram";
+    scratch.ram_threshold = 100;
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out.txt";
+    auto result = run("stepa | stepb", options, scratch);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_EQ(first->outputs().size(), 1u);
+    EXPECT_TRUE(is_under(first->outputs()[0], scratch.ram_dir)) << first->outputs()[0];
+    // Both run directories are removed afterwards
+    EXPECT_TRUE(std::filesystem::is_empty(scratch.ram_dir));
+    EXPECT_TRUE(std::filesystem::is_empty(scratch.dir));
+}
+
+TEST_F(TempCleanupTest, LargeIntermediateUsesDiskScratch)
+{
+    auto *first = add_step("stepa");
+    add_step("stepb");
+
+    core::ScratchPolicy scratch;
+    scratch.dir = temp_dir / "disk";
+    scratch.ram_dir = temp_dir / "ram";
+    scratch.ram_threshold = 100;
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out.txt";
+    auto result = run("stepa | stepb", options, scratch, std::string(500, 'x'));
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_EQ(first->outputs().size(), 1u);
+    EXPECT_TRUE(is_under(first->outputs()[0], scratch.dir)) << first->outputs()[0];
+}
+
+TEST_F(TempCleanupTest, ExpandingStageInHistoryUsesDiskScratch)
+{
+    auto *first = add_step("stepa");
+    add_step("stepb");
+
+    core::ScratchPolicy scratch;
+    scratch.dir = temp_dir / "disk";
+    scratch.ram_dir = temp_dir / "ram";
+    scratch.ram_threshold = 100;
+
+    // stepa has turned 1-byte inputs into 1000 bytes before
+    auto stats = std::make_shared<core::PerfStats>(temp_dir / "stats.json");
+    auto info = first->info();
+    stats->record({info.scope, info.version, "stepa", "txt", core::PerfStats::size_bucket(1)},
+                  {1, 1, 1000, 0});
+
+    core::CoreOptions options;
+    options.output = temp_dir / "out.txt";
+    auto result = run("stepa | stepb", options, scratch, "x", stats);
+
+    ASSERT_TRUE(result.success) << result.error.value_or("");
+    ASSERT_GE(first->outputs().size(), 1u);
+    EXPECT_TRUE(is_under(first->outputs()[0], scratch.dir)) << first->outputs()[0];
+}
+
+TEST_F(TempCleanupTest, RamScratchIsOptIn)
+{
+    EXPECT_TRUE(core::ScratchPolicy::defaults().ram_dir.empty());
+
+    core::ConfigManager config(temp_dir / "config");
+    EXPECT_TRUE(core::ScratchPolicy::from_config(config).ram_dir.empty());
+
+#ifdef __linux__
+    config.set("scratch.ram_dir", "auto");
+    auto scratch = core::ScratchPolicy::from_config(config);
+    if (std::filesystem::is_directory("/dev/shm"))
+    {
+        EXPECT_EQ(scratch.ram_dir, std::filesystem::path("/dev/shm") / "uniconv");
+        EXPECT_EQ(scratch.ram_threshold, 16u * 1024u * 1024u);
+    }
+#endif
+}
+
+TEST_F(TempCleanupTest, ScratchPolicyFromConfig)
+{
+    core::ConfigManager config(temp_dir / "config");
+    config.set("scratch.dir", (temp_dir / "nvme").string());
+    config.set("scratch.ram_dir", "");
+    auto scratch = core::ScratchPolicy::from_config(config);
+    EXPECT_EQ(scratch.dir, temp_dir / "nvme");
+    EXPECT_TRUE(scratch.ram_dir.empty());
+
+    config.set("scratch.ram_dir", (temp_dir / "ram").string());
+    config.set("scratch.ram_threshold", "1MB");
+    scratch = core::ScratchPolicy::from_config(config);
+    EXPECT_EQ(scratch.ram_dir, temp_dir / "ram");
+    EXPECT_EQ(scratch.ram_threshold, 1024u * 1024u);
+}
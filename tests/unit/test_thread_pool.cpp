@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "core/thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+using namespace uniconv::core;
+
+TEST(ThreadPoolTest, RunsAllSubmittedTasks)
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 100; ++i)
+        {
+            pool.submit([&count]() { count++; });
+        }
+        pool.wait_idle();
+        EXPECT_EQ(count.load(), 100);
+    }
+}
+
+TEST(ThreadPoolTest, ZeroWorkersUsesHardwareConcurrency)
+{
+    ThreadPool pool(0);
+    EXPECT_GE(pool.size(), 1u);
+    EXPECT_EQ(ThreadPool::resolve_worker_count(3), 3u);
+}
+
+TEST(ThreadPoolTest, RunsTasksConcurrently)
+{
+    ThreadPool pool(2);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    for (int i = 0; i < 2; ++i)
+    {
+        pool.submit([&]() {
+            int now = ++running;
+            int expected = peak.load();
+            while (now > expected && !peak.compare_exchange_weak(expected, now))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            --running;
+        });
+    }
+    pool.wait_idle();
+
+    EXPECT_EQ(peak.load(), 2);
+}
+
+TEST(ThreadPoolTest, ThrowingTaskDoesNotKillWorker)
+{
+    ThreadPool pool(1);
+    std::atomic<bool> ran{false};
+
+    pool.submit([]() { throw std::runtime_error("boom"); });
+    pool.submit([&ran]() { ran = true; });
+    pool.wait_idle();
+
+    EXPECT_TRUE(ran.load());
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueue)
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 10; ++i)
+        {
+            pool.submit([&count]() { count++; });
+        }
+    }
+    EXPECT_EQ(count.load(), 10);
+}
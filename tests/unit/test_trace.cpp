@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "cli/pipeline_parser.h"
+#include "core/pipeline_executor.h"
+#include "core/trace.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace uniconv;
+
+class TraceTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_trace";
+        std::filesystem::remove_all(temp_dir);
+        std::filesystem::create_directories(temp_dir);
+    }
+
+    void TearDown() override
+    {
+        core::Trace::finish();
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    nlohmann::json read_trace(const std::filesystem::path &path)
+    {
+        std::ifstream in(path);
+        return nlohmann::json::parse(in);
+    }
+
+    static const nlohmann::json *find_event(const nlohmann::json &trace, const std::string &name)
+    {
+        for (const auto &event : trace["traceEvents"])
+        {
+            if (event.value("name", "") == name)
+                return &event;
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(TraceTest, DisabledByDefault)
+{
+    EXPECT_FALSE(core::Trace::enabled());
+    {
+        core::TraceSpan span("ignored", "test");
+        span.arg("key", 1);
+    }
+    EXPECT_TRUE(core::Trace::finish());
+}
+
+TEST_F(TraceTest, LazyNameIsNotBuiltWhenDisabled)
+{
+    bool built = false;
+    {
+        core::TraceSpan span([&]
+                             { built = true; return std::string("lazy"); },
+                             "test");
+        EXPECT_FALSE(span.active());
+    }
+    EXPECT_FALSE(built);
+
+    auto path = temp_dir / "trace.json";
+    core::Trace::start(path);
+    {
+        core::TraceSpan span([&]
+                             { built = true; return std::string("lazy"); },
+                             "test");
+        EXPECT_TRUE(span.active());
+    }
+    ASSERT_TRUE(core::Trace::finish());
+    EXPECT_TRUE(built);
+    EXPECT_NE(find_event(read_trace(path), "lazy"), nullptr);
+}
+
+TEST_F(TraceTest, WritesCompleteEvents)
+{
+    auto path = temp_dir / "trace.json";
+    core::Trace::start(path);
+    EXPECT_TRUE(core::Trace::enabled());
+    {
+        core::TraceSpan span("work", "test");
+        span.arg("items", 3);
+    }
+    ASSERT_TRUE(core::Trace::finish());
+    EXPECT_FALSE(core::Trace::enabled());
+
+    auto trace = read_trace(path);
+    const auto *event = find_event(trace, "work");
+    ASSERT_NE(event, nullptr);
+    EXPECT_EQ((*event)["ph"], "X");
+    EXPECT_EQ((*event)["cat"], "test");
+    EXPECT_EQ((*event)["args"]["items"], 3);
+    EXPECT_GE((*event)["dur"].get<int64_t>(), 0);
+    EXPECT_TRUE(event->contains("pid"));
+    EXPECT_TRUE(event->contains("tid"));
+}
+
+#ifndef _WIN32
+TEST_F(TraceTest, PipelineRecordsPhasesAndChildUsage)
+{
+    auto plugin_dir = temp_dir / "plugins" / "test" / "upper";
+    std::filesystem::create_directories(plugin_dir);
+    nlohmann::json manifest = {
+        {"name", "upper"},
+        {"scope", "test"},
+        {"version", "1.0.0"},
+        {"interface", "cli"},
+        {"executable", "run.sh"},
+        {"targets", {{"upper", {"txt"}}}},
+        {"accepts", {"txt"}}};
+    std::ofstream(plugin_dir / "plugin.json") << manifest.dump(2);
+    auto script = plugin_dir / "run.sh";
+    std::ofstream(script)
+        << "#!/bin/sh\n"
+        << "while [ $# -gt 0 ]; do\n"
+        << "  case \"$1\" in --input) in=\"$2\"; shift;; --output) out=\"$2\"; shift;; esac\n"
+        << "  shift\n"
+        << "done\n"
+        << "tr a-z A-Z < \"$in\" > \"$out\"\n"
+        << "printf '{\"success\":true,\"output_path\":\"%s\"}\\n' \"$out\"\n";
+    chmod(script.c_str(), 0755);
+
+    auto source = temp_dir / "in.txt";
+    std::ofstream(source) << "hello\n";
+    core::CoreOptions options;
+    options.output = temp_dir / "out.txt";
+    cli::PipelineParser parser;
+    auto parsed = parser.parse("upper", source, options);
+    ASSERT_TRUE(parsed.success) << parsed.error;
+
+    auto manager = std::make_shared<core::PluginManager>();
+    manager->load_plugins_from_dir(temp_dir / "plugins");
+
+    auto path = temp_dir / "trace.json";
+    core::Trace::start(path);
+    {
+        core::PipelineExecutor executor(std::make_shared<core::Engine>(manager));
+        auto result = executor.execute(parsed.pipeline);
+        ASSERT_TRUE(result.success) << result.error.value_or("");
+    }
+    ASSERT_TRUE(core::Trace::finish());
+
+    auto trace = read_trace(path);
+    for (const char *name : {"build_graph", "detect_format", "resolve_plugin", "spawn",
+                             "plugin_execute", "parse_result", "finalize", "rename", "temp_cleanup"})
+    {
+        EXPECT_NE(find_event(trace, name), nullptr) << name;
+    }
+    const auto *process = find_event(trace, "plugin_process");
+    ASSERT_NE(process, nullptr);
+    EXPECT_GT((*process)["args"]["max_rss_kb"].get<long>(), 0);
+    EXPECT_TRUE((*process)["args"].contains("user_cpu_ms"));
+    EXPECT_TRUE((*process)["args"].contains("sys_cpu_ms"));
+}
+#endif
@@ -104,3 +104,13 @@ TEST(TypesTest, PresetFromJson)
     EXPECT_EQ(preset.target, "jpg");
     EXPECT_EQ(preset.plugin_options.size(), 2);
 }
+
+TEST(TypesTest, PluginInfoStreamCapability)
+{
+    PluginInfo info;
+    info.input_types = {DataType::Video, DataType::Stream};
+    info.output_types = {DataType::Video};
+
+    EXPECT_TRUE(info.streams_input());
+    EXPECT_FALSE(info.streams_output());
+}
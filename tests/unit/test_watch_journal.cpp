@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "core/watch_journal.h"
+#include <fstream>
+
+using namespace uniconv;
+
+class WatchJournalTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+    std::filesystem::path journal_dir;
+    std::filesystem::path watch_dir;
+    std::string fingerprint = core::WatchJournal::fingerprint("jpg", std::nullopt);
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_journal";
+        std::filesystem::remove_all(temp_dir);
+        journal_dir = temp_dir / "journal";
+        watch_dir = temp_dir / "watched";
+        std::filesystem::create_directories(watch_dir);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    std::filesystem::path write(const std::string &name, const std::string &content)
+    {
+        auto path = watch_dir / name;
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    void record(core::WatchJournal &journal, const std::filesystem::path &file)
+    {
+        auto snapshot = core::WatchJournal::snapshot(file);
+        ASSERT_TRUE(snapshot);
+        journal.record(file, *snapshot);
+    }
+
+    void bump_mtime(const std::filesystem::path &file)
+    {
+        std::filesystem::last_write_time(file, std::filesystem::last_write_time(file) + std::chrono::seconds(5));
+    }
+};
+
+TEST_F(WatchJournalTest, ClassifiesFiles)
+{
+    auto file = write("a.png", "pixels");
+    core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+    ASSERT_TRUE(journal.open());
+
+    EXPECT_EQ(journal.check(file), core::JournalCheck::New);
+    record(journal, file);
+    EXPECT_EQ(journal.check(file), core::JournalCheck::Unchanged);
+
+    write("a.png", "other pixels");
+    EXPECT_EQ(journal.check(file), core::JournalCheck::Changed);
+
+    // Same size, different bytes, new mtime
+    write("a.png", "pixels");
+    record(journal, file);
+    write("a.png", "PIXELS");
+    bump_mtime(file);
+    EXPECT_EQ(journal.check(file), core::JournalCheck::Changed);
+}
+
+TEST_F(WatchJournalTest, TouchedFileIsUnchangedAcrossRestarts)
+{
+    auto file = write("a.png", "pixels");
+    {
+        core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+        ASSERT_TRUE(journal.open());
+        record(journal, file);
+    }
+
+    bump_mtime(file);
+    {
+        core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+        ASSERT_TRUE(journal.open());
+        EXPECT_EQ(journal.size(), 1u);
+        EXPECT_EQ(journal.check(file), core::JournalCheck::Unchanged);
+    }
+
+    // The refreshed mtime was persisted: no rehash needed next time
+    core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+    ASSERT_TRUE(journal.open());
+    std::filesystem::remove(file);
+    std::ofstream(file, std::ios::binary) << "pixels";
+    EXPECT_EQ(journal.check(file), core::JournalCheck::Unchanged);
+}
+
+TEST_F(WatchJournalTest, PipelineAndDirectorySelectJournal)
+{
+    auto file = write("a.png", "pixels");
+    {
+        core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+        ASSERT_TRUE(journal.open());
+        record(journal, file);
+    }
+
+    core::WatchJournal other_pipeline(journal_dir, watch_dir,
+                                      core::WatchJournal::fingerprint("png", std::nullopt));
+    ASSERT_TRUE(other_pipeline.open());
+    EXPECT_EQ(other_pipeline.check(file), core::JournalCheck::New);
+    EXPECT_NE(other_pipeline.path(), core::WatchJournal(journal_dir, watch_dir, fingerprint).path());
+
+    EXPECT_NE(core::WatchJournal::fingerprint("jpg", std::nullopt),
+              core::WatchJournal::fingerprint("jpg", std::filesystem::path("out")));
+}
+
+TEST_F(WatchJournalTest, RecoversFromTornLine)
+{
+    auto a = write("a.png", "a");
+    auto b = write("b.png", "b");
+    std::filesystem::path journal_path;
+    {
+        core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+        ASSERT_TRUE(journal.open());
+        record(journal, a);
+        journal_path = journal.path();
+    }
+    // Simulate a crash in the middle of an append
+    std::ofstream(journal_path, std::ios::app) << "{\"path\":\"b.p";
+
+    {
+        core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+        ASSERT_TRUE(journal.open());
+        EXPECT_EQ(journal.check(a), core::JournalCheck::Unchanged);
+        EXPECT_EQ(journal.check(b), core::JournalCheck::New);
+        record(journal, b);
+    }
+
+    core::WatchJournal journal(journal_dir, watch_dir, fingerprint);
+    ASSERT_TRUE(journal.open());
+    EXPECT_EQ(journal.size(), 2u);
+    EXPECT_EQ(journal.check(b), core::JournalCheck::Unchanged);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include "core/watch_queue.h"
+#include <atomic>
+
+using namespace uniconv;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+    // Handler that blocks until released, recording what it processed
+    struct GatedHandler
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool open = false;
+        std::atomic<int> running{0};
+        std::atomic<int> max_running{0};
+        std::vector<std::pair<std::filesystem::path, core::FileEvent>> handled;
+
+        void operator()(const std::filesystem::path &path, core::FileEvent event)
+        {
+            int now = ++running;
+            int seen = max_running.load();
+            while (now > seen && !max_running.compare_exchange_weak(seen, now))
+            {
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]
+                    { return open; });
+            handled.emplace_back(path, event);
+            --running;
+        }
+
+        void release()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                open = true;
+            }
+            cv.notify_all();
+        }
+
+        void wait_running(int count)
+        {
+            while (running < count)
+                std::this_thread::sleep_for(1ms);
+        }
+    };
+
+} // namespace
+
+TEST(WatchQueueTest, RunsJobsConcurrently)
+{
+    GatedHandler handler;
+    core::WatchQueue queue(3, 16, std::ref(handler));
+
+    for (int i = 0; i < 3; ++i)
+        ASSERT_TRUE(queue.push("f" + std::to_string(i), core::FileEvent::Created, 1s));
+    handler.wait_running(3);
+    handler.release();
+
+    ASSERT_TRUE(queue.wait_idle(5s));
+    EXPECT_EQ(handler.max_running, 3);
+    EXPECT_EQ(handler.handled.size(), 3u);
+}
+
+TEST(WatchQueueTest, CoalescesQueuedPath)
+{
+    GatedHandler handler;
+    core::WatchQueue queue(1, 16, std::ref(handler));
+
+    ASSERT_TRUE(queue.push("busy", core::FileEvent::Created, 1s));
+    handler.wait_running(1);
+
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Created, 1s));
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Modified, 1s));
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Modified, 1s));
+    EXPECT_EQ(queue.pending(), 1u);
+
+    handler.release();
+    ASSERT_TRUE(queue.wait_idle(5s));
+    ASSERT_EQ(handler.handled.size(), 2u);
+    EXPECT_EQ(handler.handled[1].first, "a");
+    EXPECT_EQ(handler.handled[1].second, core::FileEvent::Created);
+}
+
+TEST(WatchQueueTest, RerunsPathChangedWhileRunning)
+{
+    GatedHandler handler;
+    core::WatchQueue queue(2, 16, std::ref(handler));
+
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Created, 1s));
+    handler.wait_running(1);
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Modified, 1s));
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Modified, 1s));
+
+    // Never picked up by the idle second worker while the first runs it
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(handler.running, 1);
+
+    handler.release();
+    ASSERT_TRUE(queue.wait_idle(5s));
+    ASSERT_EQ(handler.handled.size(), 2u);
+    EXPECT_EQ(handler.handled[1].second, core::FileEvent::Modified);
+    EXPECT_EQ(handler.max_running, 1);
+}
+
+TEST(WatchQueueTest, FullQueueAppliesBackpressure)
+{
+    GatedHandler handler;
+    core::WatchQueue queue(1, 2, std::ref(handler));
+
+    ASSERT_TRUE(queue.push("busy", core::FileEvent::Created, 1s));
+    handler.wait_running(1);
+    ASSERT_TRUE(queue.push("a", core::FileEvent::Created, 1s));
+    ASSERT_TRUE(queue.push("b", core::FileEvent::Created, 1s));
+
+    EXPECT_FALSE(queue.push("c", core::FileEvent::Created, 20ms));
+    // Coalescing needs no free slot
+    EXPECT_TRUE(queue.push("a", core::FileEvent::Modified, 0ms));
+
+    // Waits for a slot instead of failing
+    std::thread releaser([&]
+                         {
+        std::this_thread::sleep_for(50ms);
+        handler.release(); });
+    EXPECT_TRUE(queue.push("c", core::FileEvent::Created, 5s));
+    releaser.join();
+
+    ASSERT_TRUE(queue.wait_idle(5s));
+    EXPECT_EQ(handler.handled.size(), 4u);
+}
+
+TEST(WatchQueueTest, CloseDrainsAndDiscardDrops)
+{
+    GatedHandler handler;
+    {
+        core::WatchQueue queue(1, 16, std::ref(handler));
+        ASSERT_TRUE(queue.push("busy", core::FileEvent::Created, 1s));
+        handler.wait_running(1);
+        ASSERT_TRUE(queue.push("a", core::FileEvent::Created, 1s));
+        ASSERT_TRUE(queue.push("b", core::FileEvent::Created, 1s));
+
+        queue.close();
+        EXPECT_FALSE(queue.push("c", core::FileEvent::Created, 1s));
+        EXPECT_EQ(queue.discard_pending(), 2u);
+        handler.release();
+    }
+    // The running job finished before the destructor returned
+    ASSERT_EQ(handler.handled.size(), 1u);
+    EXPECT_EQ(handler.handled[0].first, "busy");
+
+    GatedHandler drained;
+    drained.release();
+    {
+        core::WatchQueue queue(1, 16, std::ref(drained));
+        for (int i = 0; i < 5; ++i)
+            ASSERT_TRUE(queue.push("f" + std::to_string(i), core::FileEvent::Created, 1s));
+        queue.close();
+    }
+    EXPECT_EQ(drained.handled.size(), 5u);
+}
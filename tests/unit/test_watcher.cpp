@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "core/watcher.h"
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace uniconv;
+using namespace std::chrono_literals;
+
+class WatcherTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path temp_dir;
+    core::Watcher watcher{50ms};
+    std::thread thread;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::pair<std::filesystem::path, core::FileEvent>> events;
+
+    void SetUp() override
+    {
+        temp_dir = std::filesystem::temp_directory_path() / "uniconv_test_watcher";
+        std::filesystem::remove_all(temp_dir);
+        std::filesystem::create_directories(temp_dir);
+
+        watcher.set_callback([this](const std::filesystem::path &path, core::FileEvent event)
+                             {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.emplace_back(path, event);
+            cv.notify_all(); });
+    }
+
+    void TearDown() override
+    {
+        watcher.stop();
+        if (thread.joinable())
+            thread.join();
+        std::filesystem::remove_all(temp_dir);
+    }
+
+    void start(bool recursive = false)
+    {
+        thread = std::thread([this, recursive]
+                             { watcher.watch(temp_dir, recursive); });
+        while (!watcher.is_running())
+            std::this_thread::sleep_for(1ms);
+        // Let the backend take its baseline
+        std::this_thread::sleep_for(200ms);
+    }
+
+    bool wait_for_events(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, 5s, [&]
+                           { return events.size() >= count; });
+    }
+};
+
+TEST_F(WatcherTest, ReportsNewFile)
+{
+    start();
+    std::ofstream(temp_dir / "a.txt") << "data";
+
+    ASSERT_TRUE(wait_for_events(1));
+    EXPECT_EQ(events[0].first, temp_dir / "a.txt");
+    EXPECT_EQ(events[0].second, core::FileEvent::Created);
+#ifdef __linux__
+    EXPECT_EQ(watcher.backend(), core::WatchBackend::Inotify);
+#endif
+}
+
+TEST_F(WatcherTest, ReportsRenamedAndModifiedFiles)
+{
+    std::ofstream(temp_dir / "existing.txt") << "old";
+    std::ofstream(temp_dir / "staged.tmp") << "data";
+    start();
+
+    std::filesystem::rename(temp_dir / "staged.tmp", temp_dir / "moved.txt");
+    ASSERT_TRUE(wait_for_events(1));
+    EXPECT_EQ(events[0].first, temp_dir / "moved.txt");
+    EXPECT_EQ(events[0].second, core::FileEvent::Created);
+
+    // Distinct mtime for the polling backend
+    std::this_thread::sleep_for(20ms);
+    std::ofstream(temp_dir / "existing.txt") << "new";
+    ASSERT_TRUE(wait_for_events(2));
+    EXPECT_EQ(events[1].first, temp_dir / "existing.txt");
+    EXPECT_EQ(events[1].second, core::FileEvent::Modified);
+}
+
+TEST_F(WatcherTest, FollowsNewSubdirectoriesWhenRecursive)
+{
+    watcher.set_extensions({"png"});
+    start(true);
+
+    std::filesystem::create_directories(temp_dir / "sub" / "deeper");
+    std::ofstream(temp_dir / "sub" / "deeper" / "skip.txt") << "x";
+    std::ofstream(temp_dir / "sub" / "deeper" / "image.png") << "x";
+
+    ASSERT_TRUE(wait_for_events(1));
+    std::this_thread::sleep_for(200ms);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].first, temp_dir / "sub" / "deeper" / "image.png");
+}
+
+TEST_F(WatcherTest, PollingBackendReportsNewFile)
+{
+    watcher.set_backend(core::WatchBackend::Polling);
+    start();
+    std::ofstream(temp_dir / "a.txt") << "data";
+
+    ASSERT_TRUE(wait_for_events(1));
+    EXPECT_EQ(events[0].first, temp_dir / "a.txt");
+    EXPECT_EQ(watcher.backend(), core::WatchBackend::Polling);
+}
+
+#ifdef __linux__
+TEST_F(WatcherTest, QueueOverflowFallsBackWithoutLosingFiles)
+{
+    size_t max_queued = 0;
+    std::ifstream("/proc/sys/fs/inotify/max_queued_events") >> max_queued;
+    if (max_queued == 0 || max_queued > 65536)
+        GTEST_SKIP() << "inotify queue too large to overflow quickly";
+    size_t count = max_queued / 2 + 1000; // Two events per file
+
+    // Hold the inotify loop in its first callback while the queue overflows
+    std::atomic<bool> release{false};
+    std::set<std::filesystem::path> reported;
+    watcher.set_callback([&](const std::filesystem::path &path, core::FileEvent)
+                         {
+        while (!release)
+            std::this_thread::sleep_for(1ms);
+        std::lock_guard<std::mutex> lock(mutex);
+        reported.insert(path);
+        cv.notify_all(); });
+    start();
+
+    for (size_t i = 0; i < count; ++i)
+        std::ofstream(temp_dir / ("f" + std::to_string(i) + ".txt")) << "x";
+    release = true;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    EXPECT_TRUE(cv.wait_for(lock, 30s, [&]
+                            { return reported.size() >= count; }));
+    EXPECT_EQ(reported.size(), count);
+    EXPECT_EQ(watcher.backend(), core::WatchBackend::Polling);
+}
+#endif
+
+TEST_F(WatcherTest, StopReturnsPromptly)
+{
+    core::Watcher slow(10s);
+    std::thread t([&]
+                  { slow.watch(temp_dir); });
+    while (!slow.is_running())
+        std::this_thread::sleep_for(1ms);
+    std::this_thread::sleep_for(50ms);
+
+    auto begin = std::chrono::steady_clock::now();
+    slow.stop();
+    t.join();
+#ifdef __linux__
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 2s);
+#endif
+}
+
+TEST_F(WatcherTest, ReadyCallbackRunsOnceObserving)
+{
+    std::atomic<int> ready{0};
+    watcher.set_ready_callback([&]
+                               { ++ready; });
+    start();
+
+    EXPECT_EQ(ready, 1);
+    std::ofstream(temp_dir / "a.txt") << "data";
+    ASSERT_TRUE(wait_for_events(1));
+    EXPECT_EQ(ready, 1);
+}